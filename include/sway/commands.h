@@ -101,6 +101,7 @@ sway_cmd cmd_allow_tearing;
 sway_cmd cmd_animations;
 sway_cmd cmd_animations_enable;
 sway_cmd cmd_assign;
+sway_cmd cmd_background_blur;
 sway_cmd cmd_bar;
 sway_cmd cmd_bindcode;
 sway_cmd cmd_bindgesture;
@@ -155,13 +156,16 @@ sway_cmd cmd_for_window;
 sway_cmd cmd_force_display_urgency_hint;
 sway_cmd cmd_force_focus_wrapping;
 sway_cmd cmd_fullscreen;
+sway_cmd cmd_fullscreen_fast_path;
 sway_cmd cmd_fullscreen_movefocus;
 sway_cmd cmd_fullscreen_on_request;
 sway_cmd cmd_gaps;
 sway_cmd cmd_gesture_scroll_enable;
 sway_cmd cmd_gesture_scroll_fingers;
+sway_cmd cmd_gesture_scroll_kinetic;
 sway_cmd cmd_gesture_scroll_sensitivity;
 sway_cmd cmd_gesture_scroll_sensitivity_mouse;
+sway_cmd cmd_hidden_frame_rate;
 sway_cmd cmd_hide_edge_borders;
 sway_cmd cmd_include;
 sway_cmd cmd_inhibit_idle;
@@ -179,6 +179,9 @@ struct input_config {
 	char *xkb_rules;
 	char *xkb_variant;
 	char *xkb_file;
+	// Modification time of the xkb file when the config was parsed, so a
+	// reload can tell that the file changed
+	struct timespec xkb_file_mtime;
 
 	bool xkb_file_is_set;
 
@@ -277,6 +280,9 @@ enum color_profile {
 	COLOR_PROFILE_TRANSFORM_WITH_DEVICE_PRIMARIES, // create transform from wlr_output
 };
 
+#define MAX_RENDER_TIME_AUTO -2
+#define MAX_RENDER_TIME_DEFAULT_PERCENTILE 95
+
 /**
  * Size and position configuration for a particular output.
  *
@@ -296,7 +302,8 @@ struct output_config {
 	enum scale_filter_mode scale_filter;
 	int32_t transform;
 	enum wl_output_subpixel subpixel;
-	int max_render_time; // In milliseconds
+	int max_render_time; // In milliseconds, or MAX_RENDER_TIME_AUTO
+	int max_render_time_percentile;
 	int adaptive_sync;
 	enum render_bit_depth render_bit_depth;
 	enum color_profile color_profile;
@@ -495,6 +502,24 @@ enum mouse_warping_mode {
 	WARP_CONTAINER,
 };
 
+/**
+ * What the last `reload` did and how long each phase took, in milliseconds.
+ */
+struct sway_reload_stats {
+	int count; // number of reloads since startup
+	double validate;
+	double parse;
+	double inputs;
+	double seats;
+	double outputs;
+	double bars;
+	double total;
+	int inputs_reset; // devices reset and reconfigured
+	int seats_applied; // seat configs reapplied
+	bool swaybg_kept; // the running swaybg client was reused
+	bool modeset; // output configs changed and a modeset was requested
+};
+
 enum alignment {
 	ALIGN_LEFT,
 	ALIGN_CENTER,
@@ -555,6 +580,8 @@ struct sway_config {
 	struct wl_client *swaybg_client;
 	struct wl_listener swaybg_client_destroy;
 
+	struct sway_reload_stats reload_stats;
+
 	// Flags
 	enum focus_follows_mouse_mode focus_follows_mouse;
 	enum mouse_warping_mode mouse_warping;
@@ -568,6 +595,9 @@ struct sway_config {
 	bool show_marks;
 	enum alignment title_align;
 	bool primary_selection;
+	bool fullscreen_fast_path;
+	int hidden_frame_rate; // 0 when paused
+	int background_blur; // blur passes, 0 when disabled
 
 	bool tiling_drag;
 	int tiling_drag_threshold;
@@ -648,6 +678,7 @@ struct sway_config {
 	int focus_ring_length;
 	bool gesture_scroll_enable;
 	uint32_t gesture_scroll_fingers;
+	bool gesture_scroll_kinetic;
 	float gesture_scroll_sentitivity;
 	float gesture_scroll_sentitivity_mouse;
 	struct {
@@ -696,6 +727,12 @@ struct sway_config {
  */
 bool load_main_config(const char *path, bool is_active, bool validating);
 
+/**
+ * Returns the milliseconds elapsed since start and resets it to now. Used to
+ * time the phases of a reload.
+ */
+double config_reload_lap(struct timespec *start);
+
 /**
  * Loads an included config. Can only be used after load_main_config.
  */
@@ -748,6 +785,9 @@ void input_config_fill_rule_names(struct input_config *ic,
 
 void free_input_config(struct input_config *ic);
 
+bool input_config_equal(const struct input_config *a,
+		const struct input_config *b);
+
 int seat_name_cmp(const void *item, const void *data);
 
 struct seat_config *new_seat_config(const char* name);
@@ -765,6 +805,8 @@ struct seat_attachment_config *seat_config_get_attachment(
 
 struct seat_config *store_seat_config(struct seat_config *seat);
 
+bool seat_configs_equal(list_t *a, list_t *b);
+
 int output_name_cmp(const void *item, const void *data);
 
 void output_get_identifier(char *identifier, size_t len,
@@ -792,12 +834,21 @@ struct output_config *find_output_config(struct sway_output *output);
 
 void free_output_config(struct output_config *oc);
 
+bool output_configs_equal(list_t *a, list_t *b);
+
 void request_modeset(void);
 void force_modeset(void);
 bool modeset_is_pending(void);
 
 bool spawn_swaybg(void);
 
+/**
+ * Hands the swaybg client of old_config over to the current config if swaybg
+ * would be spawned with the same arguments. Returns false if it needs to be
+ * spawned again.
+ */
+bool keep_swaybg(struct sway_config *old_config);
+
 int workspace_output_cmp_workspace(const void *a, const void *b);
 
 void free_sway_binding(struct sway_binding *sb);
@@ -124,6 +124,15 @@ void animation_end();
 // Animates one frame for output
 void animation_animate(struct wlr_output *output);
 
+// Animation frames sampled at the predicted presentation time of the frame,
+// and frames sampled without presentation feedback
+struct sway_animation_clock_stats {
+	uint64_t predicted;
+	uint64_t fallback;
+};
+
+extern struct sway_animation_clock_stats animation_clock_stats;
+
 // Returns the output currently being animated, or NULL if not in a
 // per-output animation call. Used by callbacks to scope work to a
 // single output instead of processing all outputs.
@@ -0,0 +1,31 @@
+#ifndef _SWAY_FRAME_CLOCK_H
+#define _SWAY_FRAME_CLOCK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Predict when a frame rendered at now (CLOCK_MONOTONIC, in nsec) will be
+ * presented: on the first refresh after now, counting refreshes from the last
+ * presentation of the output.
+ *
+ * Without presentation feedback (no last presentation or an unknown refresh
+ * rate), the frame is assumed to be presented max_render_time msec after
+ * now, which is when the output renders before a refresh. false is returned
+ * in that case.
+ */
+bool frame_clock_predict(int64_t now, int64_t last_presentation,
+		uint32_t refresh_nsec, int max_render_time, int64_t *predicted);
+
+/**
+ * Compute a max_render_time in msec covering the given percentile of the
+ * render times of the last frames (in nsec), plus margin msec. The samples
+ * are sorted in place.
+ *
+ * Returns 0, rendering right after the refresh, when the refresh rate is
+ * unknown or the render times don't leave any time to wait.
+ */
+int frame_clock_max_render_time(int64_t *samples, int len, int percentile,
+		int margin, uint32_t refresh_nsec);
+
+#endif
@@ -22,8 +22,24 @@ struct launcher_ctx {
 	struct wl_list link; // sway_server::pending_launcher_ctxs
 };
 
+/**
+ * Set up the launcher context index and the process ancestry cache.
+ */
+void launcher_init(void);
+
+void launcher_fini(void);
+
+/**
+ * Find the context a process was launched with: the one of its furthest
+ * ancestor that has one, or else the one sharing its systemd scope.
+ */
 struct launcher_ctx *launcher_ctx_find_pid(pid_t pid);
 
+/**
+ * Set the pid of the process launched with a context.
+ */
+void launcher_ctx_set_pid(struct launcher_ctx *ctx, pid_t pid);
+
 struct sway_workspace *launcher_ctx_get_workspace(struct launcher_ctx *ctx);
 
 void launcher_ctx_consume(struct launcher_ctx *ctx);
@@ -0,0 +1,51 @@
+#ifndef _SWAY_PID_CACHE_H
+#define _SWAY_PID_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+/**
+ * Process ancestry read from a procfs tree, used to find the launcher
+ * context of a new window.
+ *
+ * The parent of every process looked up is remembered while the process is
+ * alive. Each cached process is watched through a pidfd, and forgotten once
+ * it exits, so a reused pid never gets the parent of the previous process.
+ * Processes that can't be watched are read again every time.
+ */
+struct pid_cache;
+
+struct pid_cache_stats {
+	uint64_t hits; // parents found in the cache
+	uint64_t reads; // stat files read
+	size_t entries; // processes currently cached
+};
+
+/**
+ * Create a cache reading the processes from proc_root, usually "/proc".
+ */
+struct pid_cache *pid_cache_create(const char *proc_root);
+
+void pid_cache_destroy(struct pid_cache *cache);
+
+/**
+ * Get the pid of the parent of a process.
+ *
+ * Returns -1 if the parent can't be determined.
+ */
+pid_t pid_cache_get_parent(struct pid_cache *cache, pid_t pid);
+
+/**
+ * Get the cgroup v2 path of a process, like "/user.slice/app-foo.scope".
+ * The cgroup of a process can change at any time, so it's never cached.
+ *
+ * Returns false if the process has no cgroup v2 path or it doesn't fit.
+ */
+bool pid_cache_get_cgroup(struct pid_cache *cache, pid_t pid,
+		char *cgroup, size_t size);
+
+void pid_cache_get_stats(struct pid_cache *cache, struct pid_cache_stats *stats);
+
+#endif
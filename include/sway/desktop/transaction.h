@@ -23,6 +23,7 @@
 
 struct sway_transaction;
 struct sway_transaction_instruction;
+struct sway_output;
 struct sway_view;
 
 /**
@@ -43,6 +44,19 @@ void transaction_commit_dirty_client(void);
  */
 void transaction_commit_dirty_delayed(void);
 
+/**
+ * Commit the pending transaction right away rather than at the end of the
+ * current event loop dispatch.
+ *
+ * transaction_commit_dirty() and its variants don't commit the transaction
+ * themselves: every change made while handling an event is merged into a
+ * single transaction, which is committed from an idle callback once the event
+ * loop is done dispatching. This is for the places which need the transaction
+ * to be committed before doing anything else, like rendering a frame, or
+ * setting the animation of the next changes.
+ */
+void transaction_flush(void);
+
 /**
  * Notify the transaction system a delayed transaction may be processed.
  */
@@ -50,10 +64,31 @@ void transaction_commit_delayed(void);
 
 /**
  * The same as transaction_commit_dirty(), but disabling all animations for
- * the transaction
+ * the transaction. The transaction is committed right away.
  */
 void transaction_commit_dirty_disable_animations(void);
 
+/**
+ * Start pacing transactions to the refresh rate of the output.
+ *
+ * Interactive operations (resize, scroll gestures) generate a layout change for
+ * every input event, usually much faster than clients can render. While pacing
+ * is active, dirty nodes are merged into the pending transaction, which is only
+ * committed from the frame handler of the output, so every client receives at
+ * most one configure per refresh.
+ */
+void transaction_pacing_begin(struct sway_output *output);
+
+/**
+ * Stop pacing transactions and commit the pending transaction, if any.
+ */
+void transaction_pacing_end(void);
+
+/**
+ * Called from the output frame handler to commit the paced transaction.
+ */
+void transaction_pacing_frame(struct sway_output *output);
+
 /**
  * Notify the transaction system that a view is ready for the new layout.
  *
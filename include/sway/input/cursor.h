@@ -147,4 +147,22 @@ const char *get_mouse_button_name(uint32_t button);
 
 void handle_request_set_cursor_shape(struct wl_listener *listener, void *data);
 
+/**
+ * Cursor themes are shared by all seats and Xwayland. The managers are
+ * reference counted and load cursor images on first use.
+ */
+struct wlr_xcursor_manager *xcursor_manager_acquire(const char *theme,
+		uint32_t size);
+
+void xcursor_manager_release(struct wlr_xcursor_manager *manager);
+
+struct sway_xcursor_cache_stats {
+	size_t managers;
+	size_t themes; // one per loaded scale
+	size_t cursors;
+	size_t bytes; // pixel data of the loaded images
+};
+
+void xcursor_cache_get_stats(struct sway_xcursor_cache_stats *stats);
+
 #endif
@@ -58,6 +58,12 @@ void input_manager_reset_all_inputs(void);
 
 void input_manager_apply_seat_config(struct seat_config *seat_config);
 
+/**
+ * Applies the input and seat configs of a freshly reloaded config, resetting
+ * only the devices whose configuration differs from old_config.
+ */
+void input_manager_apply_reloaded_configs(struct sway_config *old_config);
+
 struct sway_seat *input_manager_get_default_seat(void);
 
 struct sway_seat *input_manager_get_seat(const char *seat_name, bool create);
@@ -93,9 +93,24 @@ struct sway_keyboard_group {
 	struct wl_list link; // sway_seat::keyboard_groups
 };
 
+/**
+ * Compile the keymap for an input config, or the default keymap if ic is
+ * NULL. Keymaps are cached and shared, the caller gets a new reference.
+ */
 struct xkb_keymap *sway_keyboard_compile_keymap(struct input_config *ic,
 		char **error);
 
+struct xkb_keymap *sway_keyboard_compile_keymap_from_names(
+		const struct xkb_rule_names *rules, char **error);
+
+/**
+ * Drop the cached keymaps that depend on the XKB include path, so a reload
+ * picks up changes to the XKB files.
+ */
+void sway_keyboard_keymap_cache_invalidate(void);
+
+void sway_keyboard_keymap_cache_finish(void);
+
 struct sway_keyboard *sway_keyboard_create(struct sway_seat *seat,
 		struct sway_seat_device *device);
 
@@ -31,6 +31,8 @@ struct sway_layer_surface {
 	struct wlr_layer_surface_v1 *layer_surface;
 
 	list_t *layer_popups;
+	// Layer surface state the layers were last arranged with
+	struct wlr_layer_surface_v1_state arranged;
 	struct sway_layer_surface_state current;
 	struct sway_layer_surface_state pending;
 
@@ -66,6 +68,14 @@ struct sway_layer_popup {
 
 struct sway_output;
 
+struct sway_layer_commit_stats {
+	uint64_t commits; // layer surface commits
+	uint64_t arranged; // commits that arranged all the layers of the output
+	uint64_t configured; // commits that only configured their own surface
+};
+
+extern struct sway_layer_commit_stats sway_layer_commit_stats;
+
 struct wlr_layer_surface_v1 *toplevel_layer_surface_from_surface(
 		struct wlr_surface *surface);
 
@@ -28,6 +28,9 @@ struct sway_output_state {
 	struct sway_workspace *active_workspace;
 };
 
+#define RENDER_TIME_SAMPLES 64
+#define FRAME_TIME_SAMPLES 1024
+
 struct sway_output {
 	struct sway_node node;
 
@@ -82,6 +85,28 @@ struct sway_output {
 	int max_render_time; // In milliseconds
 	struct wl_event_source *repaint_timer;
 
+	// Automatic max_render_time: the render and commit time of the last
+	// frames is measured, and max_render_time is set to the configured
+	// percentile of those samples plus a safety margin
+	struct {
+		bool enabled;
+		int percentile;
+		struct wlr_scene_timer timer;
+		int64_t commit_duration; // nsec, of the last rendered frame
+		int64_t samples[RENDER_TIME_SAMPLES]; // nsec
+		int samples_len, samples_idx;
+		int margin; // msec, increased on missed frames
+		int frames_since_miss;
+		struct timespec target; // predicted presentation of the last frame
+		uint64_t frames, missed;
+	} render_time;
+
+	// Time spent building and committing the last frames, for benchmarks
+	struct {
+		int64_t samples[FRAME_TIME_SAMPLES]; // nsec, a ring buffer
+		int samples_len, samples_idx;
+	} frame_time;
+
 	struct sway_scroller_output_options scroller_options;
 	uint32_t animation_id;  // id for the animation owning the scheduled frame
 	bool workspace_switching;
@@ -113,6 +138,12 @@ void output_configure_scene(struct sway_output *output,
 void output_add_workspace(struct sway_output *output,
 		struct sway_workspace *workspace);
 
+/**
+ * (Re)arm the timer sending frame done to the hidden views, after a view got
+ * hidden or hidden_frame_rate changed.
+ */
+void output_schedule_hidden_frame_done(void);
+
 typedef void (*sway_surface_iterator_func_t)(struct sway_output *output,
 	struct sway_view *view, struct wlr_surface *surface, struct wlr_box *box,
 	void *user_data);
@@ -146,6 +146,20 @@ struct sway_server {
 	// updated with new instructions as needed.
 	struct sway_transaction *pending_transaction;
 
+	// Number of transactions committed since startup
+	uint64_t transactions_committed;
+
+	// Commits the pending transaction once the current event loop dispatch
+	// is done, so all the changes made while handling one event end up in a
+	// single transaction. See transaction_flush().
+	struct wl_event_source *transaction_idle;
+
+	struct {
+		uint64_t coalesced; // commits merged into an already scheduled one
+		uint64_t configures; // configures sent by committed transactions
+		uint64_t frames; // output frame events
+	} transaction_stats;
+
 	// Stores the nodes that have been marked as "dirty" and will be put into
 	// the pending transaction.
 	list_t *dirty_nodes;
@@ -155,7 +169,16 @@ struct sway_server {
 	// the transaction commits will be merged into the pending transaction.
 	bool delay_transaction;
 
+	// When set, the pending transaction is only committed on the frame event
+	// of this output. See transaction_pacing_begin().
+	struct sway_output *paced_output;
+
 	struct wl_event_source *delayed_modeset;
+
+	// Views that are not visible on any output. They only get frame
+	// callbacks at config->hidden_frame_rate.
+	struct wl_list hidden_views; // sway_view::hidden_link
+	struct wl_event_source *hidden_frame_timer;
 };
 
 extern struct sway_server server;
@@ -164,6 +187,7 @@ struct sway_debug {
 	bool noatomic;         // Ignore atomic layout updates
 	bool txn_timings;      // Log verbose messages about transactions
 	bool txn_wait;         // Always wait for the timeout before applying
+	bool txn_nocoalesce;   // Commit every transaction right away
 };
 
 extern struct sway_debug debug;
@@ -12,8 +12,21 @@ struct sway_text_node {
 	float background[4];
 
 	struct wlr_scene_node *node;
+
+	// Optional. When set, text changes on a node that is not visible are
+	// only measured once it becomes visible, and this is called if that
+	// changes its width.
+	void (*resized)(struct sway_text_node *node, void *data);
+	void *resized_data;
+};
+
+struct sway_text_node_stats {
+	uint64_t rendered; // backing buffers rasterized
+	uint64_t deferred; // updates postponed because the node was not visible
 };
 
+extern struct sway_text_node_stats sway_text_node_stats;
+
 struct sway_text_node *sway_text_node_create(struct wlr_scene_tree *parent,
 		char *text, float color[4], bool pango_markup);
 
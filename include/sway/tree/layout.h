@@ -239,8 +239,17 @@ void layout_filter(enum sway_layout_filter filter, enum sway_layout_filter_apply
 bool layout_scroll_begin(struct sway_seat *seat);
 // Update scrolling swipe gesture
 void layout_scroll_update(struct sway_seat *seat, double dx, double dy, float sensitivity);
-// Finish scrolling swipe and return true if scrolling, else false
-bool layout_scroll_end(struct sway_seat *seat);
+// Finish scrolling swipe and return true if scrolling, else false. With
+// kinetic, the layout keeps moving and decelerates before it is snapped.
+bool layout_scroll_end(struct sway_seat *seat, bool kinetic);
+// Apply the scrolled distance to the scene, called once per output frame
+void layout_scroll_frame(struct sway_output *output);
+// Offset of the tiling layer of workspace (con is NULL) or of the children of
+// con, that the scene shows but the layout doesn't contain yet
+void layout_scroll_get_scene_offset(struct sway_workspace *workspace,
+	struct sway_container *con, int *x, int *y);
+// Return true if a workspace is decelerating after a swipe
+bool layout_scroll_kinetic(void);
 
 // Pin
 
@@ -0,0 +1,52 @@
+#ifndef _SWAY_OVERLAP_H
+#define _SWAY_OVERLAP_H
+
+#include <stdbool.h>
+
+/**
+ * Overlap counts for a set of boxes that move one at a time. Used to
+ * de-overlap floating windows in jump and overview modes without recounting
+ * every pair after each move.
+ */
+struct overlap_box {
+	double x, y, width, height;
+	bool active; // inactive boxes don't overlap anything
+	int extra; // overlaps with obstacles that don't move, like tiled windows
+	int count; // overlaps with the other active boxes of the set
+};
+
+struct overlap_set {
+	struct overlap_box *boxes;
+	int length;
+	int capacity;
+	bool mutual; // if false, boxes only count their extra overlaps
+};
+
+struct overlap_set *overlap_set_create(int capacity, bool mutual);
+
+void overlap_set_destroy(struct overlap_set *set);
+
+/**
+ * Append a box. The order of insertion breaks ties in overlap_set_maximum.
+ */
+void overlap_set_add(struct overlap_set *set, double x, double y,
+		double width, double height, bool active, int extra);
+
+/**
+ * Compute the overlap counts of all the boxes using a sweep line along x.
+ */
+void overlap_set_compute(struct overlap_set *set);
+
+/**
+ * Return the index of the first active box with the largest number of
+ * overlaps, or -1 if no box overlaps anything.
+ */
+int overlap_set_maximum(struct overlap_set *set);
+
+/**
+ * Move a box, updating the counts of the boxes it stops or starts overlapping.
+ */
+void overlap_set_move(struct overlap_set *set, int index, double x, double y,
+		bool active, int extra);
+
+#endif
@@ -60,6 +60,10 @@ struct sway_view_impl {
 	void (*set_tiled)(struct sway_view *view, bool tiled);
 	void (*set_fullscreen)(struct sway_view *view, bool fullscreen);
 	void (*set_resizing)(struct sway_view *view, bool resizing);
+	void (*set_suspended)(struct sway_view *view, bool suspended);
+	// Adds the surfaces to view->image_capture_scene, or forgets about them
+	// before the scene is destroyed
+	void (*set_image_capture)(struct sway_view *view, bool enabled);
 	bool (*wants_floating)(struct sway_view *view);
 	bool (*is_transient_for)(struct sway_view *child,
 			struct sway_view *ancestor);
@@ -79,8 +83,17 @@ struct sway_view {
 
 	struct wl_listener outputs_update;
 
+	// Set while the view is not visible on any output, because it is
+	// occluded or out of the viewport. See hidden_frame_rate.
+	bool hidden;
+	struct wl_list hidden_link; // sway_server::hidden_views
+
+	// Only exist while a client references the capture source, see
+	// view_get_image_capture_source()
 	struct wlr_scene *image_capture_scene;
 	struct wlr_ext_image_capture_source_v1 *image_capture_source;
+	struct wl_listener image_capture_unused;
+	struct wl_event_source *image_capture_idle;
 
 	struct sway_container *container; // NULL if unmapped and transactions finished
 	struct wlr_surface *surface; // NULL for unmapped views
@@ -115,6 +128,8 @@ struct sway_view {
 	bool destroying;
 
 	list_t *executed_criteria; // struct criteria *
+	list_t *trails; // struct sway_trail *, the trails marking this view
+	list_t *space_views; // struct sway_space_view *, saved spaces holding it
 
 	union {
 		struct wlr_xdg_toplevel *wlr_xdg_toplevel;
@@ -147,6 +162,7 @@ struct sway_xdg_shell_view {
 	struct sway_view view;
 
 	struct wlr_scene_tree *image_capture_tree;
+	struct wl_list popups; // sway_xdg_popup::link
 	char *tag;
 
 	struct wl_listener commit;
@@ -221,6 +237,8 @@ struct sway_popup_desc {
 struct sway_xdg_popup {
 	struct sway_view *view;
 	struct wlr_xdg_popup *wlr_xdg_popup;
+	struct sway_xdg_popup *parent; // NULL for popups of the toplevel
+	struct wl_list link; // sway_xdg_shell_view::popups, parents first
 
 	struct wlr_scene_tree *scene_tree;
 	struct wlr_scene_tree *xdg_surface_tree;
@@ -321,6 +339,14 @@ void view_destroy(struct sway_view *view);
 
 void view_begin_destroy(struct sway_view *view);
 
+/**
+ * Get the image capture source of the view, creating it and the scene it
+ * captures from if needed. Both are destroyed again once the source is no
+ * longer used by any client.
+ */
+struct wlr_ext_image_capture_source_v1 *view_get_image_capture_source(
+	struct sway_view *view);
+
 /**
  * Map a view, ie. make it visible in the tree.
  *
@@ -74,9 +74,20 @@ struct sway_workspace {
 
 	struct {
 		bool scrolling;
+		bool kinetic; // decelerating after the swipe ended
 		double dx, dy;
 		struct sway_container *pin;
 		enum sway_layout_pin pin_position;
+		// Scrolled distance not folded into the layout yet, for the tiling
+		// layer and for the children of column
+		double x, y;
+		struct sway_container *column;
+		double column_x, column_y;
+		// The part of it the scene shows
+		int scene_x, scene_y;
+		int scene_column_x, scene_column_y;
+		double vx, vy; // px/ms
+		struct timespec time; // of the last update
 	} gesture;
 
 	struct sway_workspace_split_data {
@@ -90,6 +101,9 @@ struct sway_workspace {
 
 	struct {
 		double s0, st, s1;
+		// Vertical offset of the scene during a workspace switch, added
+		// whenever the workspace is arranged
+		int switch_y;
 	} animation;
 
 	struct sway_workspace_state current;
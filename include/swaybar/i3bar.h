@@ -24,6 +24,14 @@ struct i3bar_block {
 	int border_bottom;
 	int border_left;
 	int border_right;
+	// Set when the block changed in a status update or the font changed,
+	// until its text is measured again
+	bool dirty;
+	// Text sizes measured while rendering, for the output scale
+	int measured_scale;
+	int full_width, full_height;
+	int short_width, short_height;
+	int min_text_width; // of min_width_str
 };
 
 void i3bar_block_unref(struct i3bar_block *block);
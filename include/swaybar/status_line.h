@@ -36,6 +36,9 @@ struct status_line {
 	bool started;
 	bool expecting_comma;
 	json_tokener *tokener;
+	// Raw bytes of the last rendered and the pending i3bar json array
+	char *last_json, *pending_json;
+	size_t last_json_len, last_json_size, pending_json_size;
 };
 
 struct status_line *status_line_init(char *cmd);
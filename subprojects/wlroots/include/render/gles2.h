@@ -127,6 +127,15 @@ struct wlr_gles2_renderer {
 		struct wlr_gles2_tex_shader tex_ext;
 	} shaders;
 
+	// Streaming vertex buffer shared by all render passes. Quads are
+	// appended at offset until the buffer is full, then it is orphaned.
+	struct {
+		GLuint vbo;
+		GLsizeiptr size, offset;
+		GLfloat *verts;
+		size_t verts_cap; // in floats
+	} stream;
+
 	struct wl_list buffers; // wlr_gles2_buffer.link
 	struct wl_list textures; // wlr_gles2_texture.link
 	struct wl_list objects; // wlr_gles2_object.link
@@ -188,6 +197,10 @@ struct wlr_gles2_render_pass {
 	struct wlr_gles2_render_timer *timer;
 	struct wlr_drm_syncobj_timeline *signal_timeline;
 	uint64_t signal_point;
+
+	// Last GL state set by this pass, to skip redundant state changes
+	GLuint program;
+	int blend; // enum wlr_render_blend_mode, or -1 if unknown
 };
 
 bool is_gles2_pixel_format_supported(const struct wlr_gles2_renderer *renderer,
@@ -20,10 +20,20 @@ struct wlr_pixman_renderer {
 	struct wl_list buffers; // wlr_pixman_buffer.link
 	struct wl_list textures; // wlr_pixman_texture.link
 	struct wl_list objects; // wlr_pixman_object.link
+	struct wl_list corner_masks; // wlr_pixman_corner_mask.link, most recent first
 
 	struct wlr_drm_format_set drm_formats;
 };
 
+// Coverage of rounded corners with a given radius in buffer pixels. The
+// mask is 2 * size pixels square and holds one quadrant per corner.
+struct wlr_pixman_corner_mask {
+	float radius;
+	int size;
+	pixman_image_t *image;
+	struct wl_list link; // wlr_pixman_renderer.corner_masks
+};
+
 struct wlr_pixman_buffer {
 	struct wlr_buffer *buffer;
 	struct wlr_pixman_renderer *renderer;
@@ -68,4 +78,6 @@ bool begin_pixman_data_ptr_access(struct wlr_buffer *buffer, pixman_image_t **im
 struct wlr_pixman_render_pass *begin_pixman_render_pass(
 	struct wlr_pixman_buffer *buffer);
 
+void pixman_corner_masks_finish(struct wlr_pixman_renderer *renderer);
+
 #endif
@@ -9,4 +9,30 @@ void scene_node_get_size(struct wlr_scene_node *node, double *width, double *hei
 
 void scene_surface_set_clip(struct wlr_scene_surface *surface, struct wlr_box *clip);
 
+#define SCENE_BLUR_MAX_PASSES 5
+
+struct scene_blur;
+
+struct scene_blur *scene_blur_create(struct wlr_output *output,
+	int width, int height, int passes);
+void scene_blur_destroy(struct scene_blur *blur);
+bool scene_blur_matches(struct scene_blur *blur, int width, int height, int passes);
+/**
+ * Returns how far, in full size pixels, the blur of a pixel reaches.
+ */
+int scene_blur_radius(int passes);
+/**
+ * Returns the buffer the sharp contents to blur are rendered to.
+ */
+struct wlr_buffer *scene_blur_get_source(struct scene_blur *blur);
+/**
+ * Returns the blurred contents, valid after scene_blur_render().
+ */
+struct wlr_texture *scene_blur_get_texture(struct scene_blur *blur);
+/**
+ * Blurs the source again within the region. The source must be up to date
+ * within the region expanded by the blur radius.
+ */
+bool scene_blur_render(struct scene_blur *blur, const pixman_region32_t *region);
+
 #endif
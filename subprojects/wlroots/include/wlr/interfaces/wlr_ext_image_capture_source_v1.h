@@ -32,6 +32,11 @@ struct wlr_ext_image_capture_source_v1_interface {
 void wlr_ext_image_capture_source_v1_init(struct wlr_ext_image_capture_source_v1 *source,
 		const struct wlr_ext_image_capture_source_v1_interface *impl);
 void wlr_ext_image_capture_source_v1_finish(struct wlr_ext_image_capture_source_v1 *source);
+/**
+ * Emit the unused event if neither a resource nor a capture session
+ * references the source anymore.
+ */
+void wlr_ext_image_capture_source_v1_check_unused(struct wlr_ext_image_capture_source_v1 *source);
 bool wlr_ext_image_capture_source_v1_create_resource(struct wlr_ext_image_capture_source_v1 *source,
 	struct wl_client *client, uint32_t new_id);
 bool wlr_ext_image_capture_source_v1_set_constraints_from_swapchain(
@@ -25,10 +25,15 @@ struct wlr_renderer;
  *
  * The device and formats advertised are suitable for copying into a
  * struct wlr_buffer.
+ *
+ * The unused event is emitted when the last resource and the last capture
+ * session referencing the source go away. Compositors creating sources on
+ * demand can use it to tear them down again.
  */
 struct wlr_ext_image_capture_source_v1 {
 	const struct wlr_ext_image_capture_source_v1_interface *impl;
 	struct wl_list resources; // wl_resource_get_link()
+	size_t num_sessions;
 
 	uint32_t width, height;
 
@@ -42,6 +47,7 @@ struct wlr_ext_image_capture_source_v1 {
 		struct wl_signal constraints_update;
 		struct wl_signal frame; // struct wlr_ext_image_capture_source_v1_frame_event
 		struct wl_signal destroy;
+		struct wl_signal unused;
 	} events;
 
 	void *data;
@@ -63,6 +63,8 @@ struct wlr_scene_workspace_data {
 	double x, y;
 	double width, height;
 	double scale;
+	// Layout position of the output the workspace is displayed on
+	double output_x, output_y;
 };
 
 struct wlr_scene_view_data {
@@ -103,6 +105,7 @@ struct wlr_scene_node_info {
 	void *workspace;
 	struct wlr_box *output_box;
 	bool background;	// bakground layer shell, usually the wallpaper
+	bool blur_source;	// drawn blurred behind blur regions, see wlr_scene_buffer_set_blur_region()
 };
 
 /** A node is an object in the scene. */
@@ -167,6 +170,7 @@ struct wlr_scene {
 		bool direct_scanout;
 		bool calculate_visibility;
 		bool highlight_transparent_region;
+		int blur_passes;
 	} WLR_PRIVATE;
 };
 
@@ -225,6 +229,10 @@ struct wlr_scene_shadow {
 	float color[4];
 };
 
+/**
+ * An empty event (size of 0) means that the buffer stopped being visible on
+ * any output.
+ */
 struct wlr_scene_outputs_update_event {
 	struct wlr_scene_output **active;
 	size_t size;
@@ -271,6 +279,7 @@ struct wlr_scene_buffer {
 	double dst_width, dst_height;
 	enum wl_output_transform transform;
 	pixman_region32_t opaque_region;
+	pixman_region32_t blur_region;
 	enum wlr_color_transfer_function transfer_function;
 	enum wlr_color_named_primaries primaries;
 	enum wlr_color_encoding color_encoding;
@@ -303,6 +312,46 @@ struct wlr_scene_buffer {
 	float radius_bottom;
 };
 
+/**
+ * Result of the last direct scan-out attempt on a scene output, or the reason
+ * why it wasn't attempted.
+ */
+enum wlr_scene_scanout_status {
+	WLR_SCENE_SCANOUT_SUCCESS,
+	// Direct scan-out is disabled for the scene
+	WLR_SCENE_SCANOUT_DISABLED,
+	// The output doesn't allow it, e.g. it has a software cursor
+	WLR_SCENE_SCANOUT_NOT_ALLOWED,
+	// A view is fullscreen across all outputs
+	WLR_SCENE_SCANOUT_FULLSCREEN_GLOBAL,
+	// The render list is empty
+	WLR_SCENE_SCANOUT_EMPTY,
+	// There is more than one node in the render list
+	WLR_SCENE_SCANOUT_MULTIPLE_ENTRIES,
+	// A decoration or shadow node is visible
+	WLR_SCENE_SCANOUT_DECORATION,
+	// The only node is not a buffer
+	WLR_SCENE_SCANOUT_NOT_BUFFER,
+	// A color transform or gamma LUT needs to be applied
+	WLR_SCENE_SCANOUT_COLOR_TRANSFORM,
+	// Damage highlight debugging is enabled
+	WLR_SCENE_SCANOUT_DAMAGE_HIGHLIGHT,
+	// The output state contains a modeset
+	WLR_SCENE_SCANOUT_MODESET,
+	// The buffer node has no buffer
+	WLR_SCENE_SCANOUT_NO_BUFFER,
+	// The buffer is drawn with an opacity below 1
+	WLR_SCENE_SCANOUT_TRANSLUCENT,
+	// The buffer transform doesn't match the output transform
+	WLR_SCENE_SCANOUT_TRANSFORM,
+	// The buffer colorimetry doesn't match the output
+	WLR_SCENE_SCANOUT_COLORIMETRY,
+	// The backend rejected a scaled or cropped buffer
+	WLR_SCENE_SCANOUT_SCALE,
+	// The backend rejected the buffer, e.g. because of its format
+	WLR_SCENE_SCANOUT_TEST_FAILED,
+};
+
 /** A viewport for an output in the scene-graph */
 struct wlr_scene_output {
 	struct wlr_output *output;
@@ -314,6 +363,24 @@ struct wlr_scene_output {
 
 	int x, y;
 
+	// Direct scan-out diagnostics, updated every time a frame is built
+	struct {
+		enum wlr_scene_scanout_status status; // of the last frame
+		uint64_t frames, scanout_frames;
+	} scanout;
+
+	// Diagnostics of the last built frame
+	struct {
+		int entries; // in the render list
+		uint64_t damage_area; // in buffer pixels
+	} last_frame;
+
+	// Background blur diagnostics
+	struct {
+		uint64_t refreshes; // frames which re-blurred part of the cache
+		uint64_t area; // re-blurred area in buffer pixels, in total
+	} blur;
+
 	struct {
 		struct wl_signal destroy;
 	} events;
@@ -348,6 +415,13 @@ struct wlr_scene_output {
 
 		struct wl_array render_list;
 
+		// Blurred blur sources, see wlr_scene_buffer_set_blur_region()
+		struct scene_blur *blur_cache;
+		float blur_scale;
+		enum wl_output_transform blur_transform;
+		pixman_region32_t blur_stale; // in buffer coordinates
+		struct wl_array blur_sources; // struct wlr_box, of the last frame
+
 		struct wlr_drm_syncobj_timeline *in_timeline;
 		uint64_t in_point;
 		struct wlr_drm_syncobj_timeline *out_timeline;
@@ -456,6 +530,13 @@ struct wlr_scene *wlr_scene_create(void);
  */
 void wlr_scene_set_callbacks(const struct wlr_scene_callbacks *callbacks);
 
+/**
+ * Recompute the visibility of every node in the scene. Needed when the
+ * callbacks change where nodes are displayed, like the workspace data when
+ * entering or leaving workspaces overview.
+ */
+void wlr_scene_update_visibility(struct wlr_scene *scene);
+
 /**
  * Handles linux_dmabuf_v1 feedback for all surfaces in the scene.
  *
@@ -480,6 +561,12 @@ void wlr_scene_set_gamma_control_manager_v1(struct wlr_scene *scene,
  */
 void wlr_scene_set_color_manager_v1(struct wlr_scene *scene, struct wlr_color_manager_v1 *manager);
 
+/**
+ * Set the number of passes of the background blur drawn behind the blur
+ * region of buffers. Each pass doubles the blur radius, 0 disables the blur.
+ */
+void wlr_scene_set_blur_passes(struct wlr_scene *scene, int passes);
+
 /**
  * Add a node displaying nothing but its children.
  */
@@ -694,6 +781,15 @@ void wlr_scene_buffer_set_buffer_with_options(struct wlr_scene_buffer *scene_buf
 void wlr_scene_buffer_set_opaque_region(struct wlr_scene_buffer *scene_buffer,
 	const pixman_region32_t *region);
 
+/**
+ * Sets the buffer's blur region, in node coordinates. The nodes of trees
+ * marked as blur sources (see struct wlr_scene_node_info) are drawn blurred
+ * behind it. The blurred sources are cached per output and only blurred
+ * again where they change.
+ */
+void wlr_scene_buffer_set_blur_region(struct wlr_scene_buffer *scene_buffer,
+	const pixman_region32_t *region);
+
 /**
  * Set the source rectangle describing the region of the buffer which will be
  * sampled to render this node. This allows cropping the buffer.
@@ -801,6 +897,11 @@ bool wlr_scene_output_needs_frame(struct wlr_scene_output *scene_output);
 bool wlr_scene_output_commit(struct wlr_scene_output *scene_output,
 	const struct wlr_scene_output_state_options *options);
 
+/**
+ * Get a short description of a direct scan-out status.
+ */
+const char *wlr_scene_scanout_status_name(enum wlr_scene_scanout_status status);
+
 /**
  * Render and populate given output state.
  */
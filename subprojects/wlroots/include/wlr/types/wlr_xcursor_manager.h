@@ -44,6 +44,9 @@ void wlr_xcursor_manager_destroy(struct wlr_xcursor_manager *manager);
 
 /**
  * Ensures an xcursor theme at the given scale factor is loaded in the manager.
+ *
+ * The theme is opened with wlr_xcursor_theme_load_lazy(), cursors are read
+ * when they are first retrieved.
  */
 bool wlr_xcursor_manager_load(struct wlr_xcursor_manager *manager,
 	float scale);
@@ -41,6 +41,8 @@
 #ifndef WLR_XCURSOR_H
 #define WLR_XCURSOR_H
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <wlr/util/edges.h>
 
@@ -82,6 +84,12 @@ struct wlr_xcursor_theme {
 	struct wlr_xcursor **cursors;
 	char *name;
 	int size;
+
+	struct {
+		bool lazy;
+		char **missing; // names of cursors the theme doesn't have
+		size_t missing_len;
+	} WLR_PRIVATE;
 };
 
 /**
@@ -101,6 +109,19 @@ struct wlr_xcursor_theme {
  */
 struct wlr_xcursor_theme *wlr_xcursor_theme_load(const char *name, int size);
 
+/**
+ * Opens the named Xcursor theme without reading its cursors.
+ *
+ * Cursors are read from disk on first use by wlr_xcursor_theme_get_cursor(),
+ * so cursors and cursor_count only contain the cursors used so far.
+ *
+ * If the theme doesn't provide a default cursor, the fallback theme is
+ * loaded like with wlr_xcursor_theme_load().
+ *
+ * On error, NULL is returned.
+ */
+struct wlr_xcursor_theme *wlr_xcursor_theme_load_lazy(const char *name, int size);
+
 /**
  * Destroy a cursor theme.
  *
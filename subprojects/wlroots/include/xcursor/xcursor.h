@@ -55,4 +55,7 @@ void
 xcursor_load_theme(const char *theme, int size,
 		   void (*load_callback)(struct xcursor_images *, void *),
 		   void *user_data);
+
+struct xcursor_images *
+xcursor_load_theme_cursor(const char *theme, const char *name, int size);
 #endif
@@ -9,7 +9,7 @@
 #include "render/gles2.h"
 #include "util/matrix.h"
 
-#define MAX_QUADS 86 // 4kb
+#define STREAM_MIN_SIZE (64 * 1024)
 
 static const struct wlr_render_pass_impl render_pass_impl;
 
@@ -75,7 +75,48 @@ out:
 	return ok;
 }
 
-static void render(const struct wlr_box *box, const pixman_region32_t *clip, GLint attrib) {
+static GLfloat *stream_reserve(struct wlr_gles2_renderer *renderer, size_t len) {
+	if (len > renderer->stream.verts_cap) {
+		size_t cap = renderer->stream.verts_cap ? renderer->stream.verts_cap : 1024;
+		while (cap < len) {
+			cap *= 2;
+		}
+		GLfloat *verts = realloc(renderer->stream.verts, cap * sizeof(*verts));
+		if (verts == NULL) {
+			wlr_log_errno(WLR_ERROR, "Allocation failed");
+			return NULL;
+		}
+		renderer->stream.verts = verts;
+		renderer->stream.verts_cap = cap;
+	}
+	return renderer->stream.verts;
+}
+
+// Uploads the vertices to the streaming VBO and returns their offset in it.
+// The buffer is orphaned instead of overwritten when it runs out of space,
+// so the driver never has to wait for draws still reading the old contents.
+static GLintptr stream_upload(struct wlr_gles2_renderer *renderer,
+		const GLfloat *verts, GLsizeiptr size) {
+	glBindBuffer(GL_ARRAY_BUFFER, renderer->stream.vbo);
+	if (renderer->stream.offset + size > renderer->stream.size) {
+		GLsizeiptr buf_size = STREAM_MIN_SIZE;
+		while (buf_size < size) {
+			buf_size *= 2;
+		}
+		glBufferData(GL_ARRAY_BUFFER, buf_size, NULL, GL_STREAM_DRAW);
+		renderer->stream.size = buf_size;
+		renderer->stream.offset = 0;
+	}
+	GLintptr offset = renderer->stream.offset;
+	glBufferSubData(GL_ARRAY_BUFFER, offset, size, verts);
+	renderer->stream.offset += size;
+	return offset;
+}
+
+static void render(struct wlr_gles2_render_pass *pass, const struct wlr_box *box,
+		const pixman_region32_t *clip, GLint attrib) {
+	struct wlr_gles2_renderer *renderer = pass->buffer->renderer;
+
 	pixman_region32_t region;
 	pixman_region32_init_rect(&region, box->x, box->y, box->width, box->height);
 
@@ -85,42 +126,44 @@ static void render(const struct wlr_box *box, const pixman_region32_t *clip, GLi
 
 	int rects_len;
 	const pixman_box32_t *rects = pixman_region32_rectangles(&region, &rects_len);
-	if (rects_len == 0) {
+	GLfloat *verts = rects_len > 0 ?
+		stream_reserve(renderer, (size_t)rects_len * 6 * 2) : NULL;
+	if (verts == NULL) {
 		pixman_region32_fini(&region);
 		return;
 	}
 
-	glEnableVertexAttribArray(attrib);
-
-	for (int i = 0; i < rects_len;) {
-		int batch = rects_len - i < MAX_QUADS ? rects_len - i : MAX_QUADS;
-		int batch_end = batch + i;
-
-		size_t vert_index = 0;
-		GLfloat verts[MAX_QUADS * 6 * 2];
-		for (; i < batch_end; i++) {
-			const pixman_box32_t *rect = &rects[i];
-
-			verts[vert_index++] = (GLfloat)(rect->x1 - box->x) / box->width;
-			verts[vert_index++] = (GLfloat)(rect->y1 - box->y) / box->height;
-			verts[vert_index++] = (GLfloat)(rect->x2 - box->x) / box->width;
-			verts[vert_index++] = (GLfloat)(rect->y1 - box->y) / box->height;
-			verts[vert_index++] = (GLfloat)(rect->x1 - box->x) / box->width;
-			verts[vert_index++] = (GLfloat)(rect->y2 - box->y) / box->height;
-			verts[vert_index++] = (GLfloat)(rect->x2 - box->x) / box->width;
-			verts[vert_index++] = (GLfloat)(rect->y1 - box->y) / box->height;
-			verts[vert_index++] = (GLfloat)(rect->x2 - box->x) / box->width;
-			verts[vert_index++] = (GLfloat)(rect->y2 - box->y) / box->height;
-			verts[vert_index++] = (GLfloat)(rect->x1 - box->x) / box->width;
-			verts[vert_index++] = (GLfloat)(rect->y2 - box->y) / box->height;
-		}
-
-		glVertexAttribPointer(attrib, 2, GL_FLOAT, GL_FALSE, 0, verts);
-		glDrawArrays(GL_TRIANGLES, 0, batch * 6);
+	size_t vert_index = 0;
+	for (int i = 0; i < rects_len; i++) {
+		const pixman_box32_t *rect = &rects[i];
+		GLfloat x1 = (GLfloat)(rect->x1 - box->x) / box->width;
+		GLfloat y1 = (GLfloat)(rect->y1 - box->y) / box->height;
+		GLfloat x2 = (GLfloat)(rect->x2 - box->x) / box->width;
+		GLfloat y2 = (GLfloat)(rect->y2 - box->y) / box->height;
+
+		verts[vert_index++] = x1;
+		verts[vert_index++] = y1;
+		verts[vert_index++] = x2;
+		verts[vert_index++] = y1;
+		verts[vert_index++] = x1;
+		verts[vert_index++] = y2;
+		verts[vert_index++] = x2;
+		verts[vert_index++] = y1;
+		verts[vert_index++] = x2;
+		verts[vert_index++] = y2;
+		verts[vert_index++] = x1;
+		verts[vert_index++] = y2;
 	}
 
+	GLintptr offset = stream_upload(renderer, verts, vert_index * sizeof(*verts));
+
+	glEnableVertexAttribArray(attrib);
+	glVertexAttribPointer(attrib, 2, GL_FLOAT, GL_FALSE, 0, (const void *)offset);
+	glDrawArrays(GL_TRIANGLES, 0, rects_len * 6);
 	glDisableVertexAttribArray(attrib);
 
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
 	pixman_region32_fini(&region);
 }
 
@@ -153,7 +196,12 @@ static void set_tex_matrix(GLint loc, enum wl_output_transform trans,
 	glUniformMatrix3fv(loc, 1, GL_FALSE, tex_matrix);
 }
 
-static void setup_blending(enum wlr_render_blend_mode mode) {
+static void setup_blending(struct wlr_gles2_render_pass *pass,
+		enum wlr_render_blend_mode mode) {
+	if (pass->blend == (int)mode) {
+		return;
+	}
+	pass->blend = mode;
 	switch (mode) {
 	case WLR_RENDER_BLEND_MODE_PREMULTIPLIED:
 		glEnable(GL_BLEND);
@@ -164,6 +212,14 @@ static void setup_blending(enum wlr_render_blend_mode mode) {
 	}
 }
 
+static void use_program(struct wlr_gles2_render_pass *pass, GLuint program) {
+	if (pass->program == program) {
+		return;
+	}
+	pass->program = program;
+	glUseProgram(program);
+}
+
 static void render_pass_add_texture(struct wlr_render_pass *wlr_pass,
 		const struct wlr_render_texture_options *options) {
 	struct wlr_gles2_render_pass *pass = get_render_pass(wlr_pass);
@@ -223,11 +279,11 @@ static void render_pass_add_texture(struct wlr_render_pass *wlr_pass,
 
 	push_gles2_debug(renderer);
 
-	setup_blending(!texture->has_alpha && alpha == 1.0 &&
+	setup_blending(pass, !texture->has_alpha && alpha == 1.0 &&
 		options->radius_top == 0.0f && options->radius_bottom == 0.0f ?
 		WLR_RENDER_BLEND_MODE_NONE : options->blend_mode);
 
-	glUseProgram(shader->program);
+	use_program(pass, shader->program);
 
 	glActiveTexture(GL_TEXTURE0);
 	glBindTexture(texture->target, texture->tex);
@@ -254,7 +310,7 @@ static void render_pass_add_texture(struct wlr_render_pass *wlr_pass,
 	set_proj_matrix(shader->proj, pass->projection_matrix, &dst_box);
 	set_tex_matrix(shader->tex_proj, options->transform, &src_fbox);
 
-	render(&dst_box, options->clip, shader->pos_attrib);
+	render(pass, &dst_box, options->clip, shader->pos_attrib);
 
 	glBindTexture(texture->target, 0);
 	pop_gles2_debug(renderer);
@@ -281,13 +337,13 @@ static void render_pass_add_rect(struct wlr_render_pass *wlr_pass,
 		glClearColor(color->r, color->g, color->b, color->a);
 		glClear(GL_COLOR_BUFFER_BIT);
 	} else {
-		setup_blending(blend_mode);
-		glUseProgram(renderer->shaders.quad.program);
+		setup_blending(pass, blend_mode);
+		use_program(pass, renderer->shaders.quad.program);
 
 		set_proj_matrix(renderer->shaders.quad.proj, pass->projection_matrix, &box);
 		glUniform4f(renderer->shaders.quad.color, color->r, color->g, color->b, color->a);
 
-		render(&box, options->clip, renderer->shaders.quad.pos_attrib);
+		render(pass, &box, options->clip, renderer->shaders.quad.pos_attrib);
 	}
 
 	pop_gles2_debug(renderer);
@@ -299,9 +355,9 @@ static void render_pass_add_decoration(struct wlr_render_pass *wlr_pass, const s
 
 	struct wlr_box box = options->box;
 	push_gles2_debug(renderer);
-	setup_blending(options->blend_mode);
+	setup_blending(pass, options->blend_mode);
 
-	glUseProgram(renderer->shaders.decoration.program);
+	use_program(pass, renderer->shaders.decoration.program);
 
 	set_proj_matrix(renderer->shaders.decoration.proj, pass->projection_matrix, &box);
 	glUniform4f(renderer->shaders.decoration.box, box.x, box.y, box.width, box.height);
@@ -328,7 +384,7 @@ static void render_pass_add_decoration(struct wlr_render_pass *wlr_pass, const s
 	glUniform4f(renderer->shaders.decoration.dim_color, options->dim_color.r,
 		options->dim_color.g, options->dim_color.b, options->dim_color.a);
 
-	render(&box, options->clip, renderer->shaders.decoration.pos_attrib);
+	render(pass, &box, options->clip, renderer->shaders.decoration.pos_attrib);
 	pop_gles2_debug(renderer);
 }
 
@@ -338,9 +394,9 @@ static void render_pass_add_shadow(struct wlr_render_pass *wlr_pass, const struc
 
 	struct wlr_box box = options->box;
 	push_gles2_debug(renderer);
-	setup_blending(options->blend_mode);
+	setup_blending(pass, options->blend_mode);
 
-	glUseProgram(renderer->shaders.shadow.program);
+	use_program(pass, renderer->shaders.shadow.program);
 
 	set_proj_matrix(renderer->shaders.shadow.proj, pass->projection_matrix, &box);
 	glUniform1i(renderer->shaders.shadow.swap_xy, options->swap_xy ? 1 : 0);
@@ -354,7 +410,7 @@ static void render_pass_add_shadow(struct wlr_render_pass *wlr_pass, const struc
 	glUniform4f(renderer->shaders.shadow.color, options->color.r,
 		options->color.g, options->color.b, options->color.a);
 
-	render(&box, options->clip, renderer->shaders.shadow.pos_attrib);
+	render(pass, &box, options->clip, renderer->shaders.shadow.pos_attrib);
 	pop_gles2_debug(renderer);
 }
 
@@ -423,7 +479,9 @@ struct wlr_gles2_render_pass *begin_gles2_buffer_pass(struct wlr_gles2_buffer *b
 	glViewport(0, 0, wlr_buffer->width, wlr_buffer->height);
 	glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 	glDisable(GL_SCISSOR_TEST);
+	glUseProgram(0);
 	pop_gles2_debug(renderer);
+	pass->blend = -1;
 
 	return pass;
 }
@@ -226,7 +226,9 @@ static void gles2_destroy(struct wlr_renderer *wlr_renderer) {
 	glDeleteProgram(renderer->shaders.tex_rgba.program);
 	glDeleteProgram(renderer->shaders.tex_rgbx.program);
 	glDeleteProgram(renderer->shaders.tex_ext.program);
+	glDeleteBuffers(1, &renderer->stream.vbo);
 	pop_gles2_debug(renderer);
+	free(renderer->stream.verts);
 
 	if (renderer->exts.KHR_debug) {
 		glDisable(GL_DEBUG_OUTPUT_KHR);
@@ -746,6 +748,8 @@ struct wlr_renderer *wlr_gles2_renderer_create(struct wlr_egl *egl) {
 		renderer->shaders.tex_ext.pos_attrib = glGetAttribLocation(prog, "pos");
 	}
 
+	glGenBuffers(1, &renderer->stream.vbo);
+
 	pop_gles2_debug(renderer);
 
 	wlr_egl_unset_current(renderer->egl);
@@ -767,6 +771,7 @@ error:
 	glDeleteProgram(renderer->shaders.tex_rgba.program);
 	glDeleteProgram(renderer->shaders.tex_rgbx.program);
 	glDeleteProgram(renderer->shaders.tex_ext.program);
+	glDeleteBuffers(1, &renderer->stream.vbo);
 
 	pop_gles2_debug(renderer);
 
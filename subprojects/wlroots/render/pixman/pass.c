@@ -1,7 +1,10 @@
 #include <assert.h>
+#include <math.h>
 #include <stdlib.h>
 #include "render/pixman.h"
 
+#define CORNER_MASK_CACHE_SIZE 8
+
 static const struct wlr_render_pass_impl render_pass_impl;
 
 static struct wlr_pixman_render_pass *get_render_pass(struct wlr_render_pass *wlr_pass) {
@@ -36,6 +39,216 @@ static pixman_op_t get_pixman_blending(enum wlr_render_blend_mode mode) {
 	abort();
 }
 
+// Same as antialias() in the GLES2 shaders
+static float antialias(float x, float x0, float x1, float fw) {
+	float xmax = fmaxf(x1, x + fw);
+	float xmin = fminf(x0, x - fw);
+	float overlap = (xmax - xmin) - fabsf(x + fw - x1) - fabsf(x - fw - x0);
+	overlap = fminf(fmaxf(overlap, 0.0f), 1.0f);
+	return overlap * overlap * (3.0f - 2.0f * overlap);
+}
+
+// Corner coverage as computed by render/gles2/shaders/tex_rgba.frag, with
+// (px, py) relative to the corner center
+static float corner_opacity(float px, float py, float radius) {
+	float d = sqrtf(px * px + py * py);
+	if (d <= radius - 1.0f || d == 0.0f) {
+		return 1.0f;
+	}
+	float fw = 0.5f * d / fmaxf(fabsf(px), fabsf(py));
+	return antialias(d, radius - 1.0f, radius, fw);
+}
+
+static void corner_mask_destroy(struct wlr_pixman_corner_mask *mask) {
+	wl_list_remove(&mask->link);
+	pixman_image_unref(mask->image);
+	free(mask);
+}
+
+void pixman_corner_masks_finish(struct wlr_pixman_renderer *renderer) {
+	struct wlr_pixman_corner_mask *mask, *tmp;
+	wl_list_for_each_safe(mask, tmp, &renderer->corner_masks, link) {
+		corner_mask_destroy(mask);
+	}
+}
+
+static struct wlr_pixman_corner_mask *get_corner_mask(
+		struct wlr_pixman_renderer *renderer, float radius) {
+	struct wlr_pixman_corner_mask *mask;
+	int count = 0;
+	wl_list_for_each(mask, &renderer->corner_masks, link) {
+		if (mask->radius == radius) {
+			wl_list_remove(&mask->link);
+			wl_list_insert(&renderer->corner_masks, &mask->link);
+			return mask;
+		}
+		count++;
+	}
+
+	if (count >= CORNER_MASK_CACHE_SIZE) {
+		struct wlr_pixman_corner_mask *oldest =
+			wl_container_of(renderer->corner_masks.prev, oldest, link);
+		corner_mask_destroy(oldest);
+	}
+
+	mask = calloc(1, sizeof(*mask));
+	if (mask == NULL) {
+		return NULL;
+	}
+	mask->radius = radius;
+	mask->size = ceilf(radius);
+	int dim = 2 * mask->size;
+	mask->image = pixman_image_create_bits(PIXMAN_a8, dim, dim, NULL, 0);
+	if (mask->image == NULL) {
+		free(mask);
+		return NULL;
+	}
+
+	uint8_t *data = (uint8_t *)pixman_image_get_data(mask->image);
+	int stride = pixman_image_get_stride(mask->image);
+	for (int y = 0; y < dim; y++) {
+		uint8_t *row = data + y * stride;
+		float py = y + 0.5f - (y < mask->size ? radius : dim - radius);
+		for (int x = 0; x < dim; x++) {
+			float px = x + 0.5f - (x < mask->size ? radius : dim - radius);
+			row[x] = (uint8_t)lroundf(corner_opacity(px, py, radius) * 0xFF);
+		}
+	}
+
+	wl_list_insert(&renderer->corner_masks, &mask->link);
+	return mask;
+}
+
+// Composites src onto dst_box. Rounded corners only pay for the mask in
+// their corner tiles; the rest of the box is a plain composite.
+static void composite_texture(struct wlr_pixman_render_pass *pass,
+		const struct wlr_render_texture_options *options, pixman_op_t op,
+		pixman_image_t *src, pixman_image_t *alpha_mask, int src_x, int src_y,
+		const struct wlr_box *dst_box) {
+	struct wlr_pixman_buffer *buffer = pass->buffer;
+
+	// Radius of the top-left, top-right, bottom-left and bottom-right
+	// corners of dst_box. radius_top applies to the top of the content
+	// after flipping and swapping, like in the shaders.
+	float radii[4];
+	bool rounded = false;
+	for (int i = 0; i < 4; i++) {
+		bool right = i & 1, bottom = i & 2;
+		if (options->flip_x) {
+			right = !right;
+		}
+		if (options->flip_y) {
+			bottom = !bottom;
+		}
+		bool content_bottom = options->swap_xy ? right : bottom;
+		radii[i] = content_bottom ? options->radius_bottom : options->radius_top;
+		rounded = rounded || radii[i] > 0.0f;
+	}
+
+	struct wlr_pixman_corner_mask *masks[4] = {0};
+	int sizes[4] = {0};
+	for (int i = 0; rounded && i < 4; i++) {
+		if (radii[i] <= 0.0f) {
+			continue;
+		}
+		masks[i] = get_corner_mask(buffer->renderer, radii[i]);
+		if (masks[i] == NULL) {
+			rounded = false;
+			break;
+		}
+		sizes[i] = masks[i]->size;
+	}
+	// Corners that would overlap mean the box is too small to round
+	if (rounded && (sizes[0] + sizes[1] > dst_box->width ||
+			sizes[2] + sizes[3] > dst_box->width ||
+			sizes[0] + sizes[2] > dst_box->height ||
+			sizes[1] + sizes[3] > dst_box->height)) {
+		rounded = false;
+	}
+
+	if (!rounded) {
+		pixman_image_set_clip_region32(buffer->image, options->clip);
+		pixman_image_composite32(op, src, alpha_mask, buffer->image,
+			src_x, src_y, 0, 0, dst_box->x, dst_box->y,
+			dst_box->width, dst_box->height);
+		pixman_image_set_clip_region32(buffer->image, NULL);
+		return;
+	}
+
+	pixman_region32_t region;
+	pixman_region32_init_rect(&region, dst_box->x, dst_box->y,
+		dst_box->width, dst_box->height);
+	if (options->clip) {
+		pixman_region32_intersect(&region, &region, options->clip);
+	}
+
+	pixman_box32_t tiles[4];
+	pixman_region32_t body;
+	pixman_region32_init(&body);
+	pixman_region32_copy(&body, &region);
+	for (int i = 0; i < 4; i++) {
+		int x = i & 1 ? dst_box->x + dst_box->width - sizes[i] : dst_box->x;
+		int y = i & 2 ? dst_box->y + dst_box->height - sizes[i] : dst_box->y;
+		tiles[i] = (pixman_box32_t){ x, y, x + sizes[i], y + sizes[i] };
+		if (sizes[i] > 0) {
+			pixman_region32_t tile;
+			pixman_region32_init_rect(&tile, x, y, sizes[i], sizes[i]);
+			pixman_region32_subtract(&body, &body, &tile);
+			pixman_region32_fini(&tile);
+		}
+	}
+
+	pixman_image_set_clip_region32(buffer->image, &body);
+	pixman_image_composite32(op, src, alpha_mask, buffer->image,
+		src_x, src_y, 0, 0, dst_box->x, dst_box->y,
+		dst_box->width, dst_box->height);
+	pixman_region32_fini(&body);
+
+	for (int i = 0; i < 4; i++) {
+		if (masks[i] == NULL) {
+			continue;
+		}
+		const pixman_box32_t *tile = &tiles[i];
+		pixman_region32_t clip;
+		pixman_region32_init_rect(&clip, tile->x1, tile->y1,
+			sizes[i], sizes[i]);
+		pixman_region32_intersect(&clip, &clip, &region);
+		if (pixman_region32_empty(&clip)) {
+			pixman_region32_fini(&clip);
+			continue;
+		}
+
+		pixman_image_t *mask = masks[i]->image;
+		int mask_x = i & 1 ? sizes[i] : 0;
+		int mask_y = i & 2 ? sizes[i] : 0;
+		pixman_image_t *faded = NULL;
+		if (alpha_mask != NULL) {
+			// pixman takes a single mask, so fold the alpha into a copy
+			faded = pixman_image_create_bits(PIXMAN_a8,
+				sizes[i], sizes[i], NULL, 0);
+			if (faded != NULL) {
+				pixman_image_composite32(PIXMAN_OP_SRC, alpha_mask, mask, faded,
+					0, 0, mask_x, mask_y, 0, 0, sizes[i], sizes[i]);
+				mask = faded;
+				mask_x = mask_y = 0;
+			}
+		}
+
+		pixman_image_set_clip_region32(buffer->image, &clip);
+		pixman_image_composite32(op, src, mask, buffer->image,
+			src_x + tile->x1 - dst_box->x, src_y + tile->y1 - dst_box->y,
+			mask_x, mask_y, tile->x1, tile->y1, sizes[i], sizes[i]);
+		pixman_region32_fini(&clip);
+
+		if (faded != NULL) {
+			pixman_image_unref(faded);
+		}
+	}
+
+	pixman_image_set_clip_region32(buffer->image, NULL);
+	pixman_region32_fini(&region);
+}
+
 static void render_pass_add_texture(struct wlr_render_pass *wlr_pass,
 		const struct wlr_render_texture_options *options) {
 	struct wlr_pixman_render_pass *pass = get_render_pass(wlr_pass);
@@ -48,7 +261,6 @@ static void render_pass_add_texture(struct wlr_render_pass *wlr_pass,
 	}
 
 	pixman_op_t op = get_pixman_blending(options->blend_mode);
-	pixman_image_set_clip_region32(buffer->image, options->clip);
 
 	struct wlr_fbox src_fbox;
 	wlr_render_texture_options_get_src_box(options, &src_fbox);
@@ -172,24 +384,17 @@ static void render_pass_add_texture(struct wlr_render_pass *wlr_pass,
 		// width,height part of source crop is done here by the width and height we pass:
 		// because of the scaling, cropping at the end by dst_box.{width,height} is
 		// equivalent to if we cropped at the start by src_box.{width,height}.
-		pixman_image_composite32(op, texture->image, mask, buffer->image,
-			0, 0, // source x,y
-			0, 0, // mask x,y
-			dst_box.x, dst_box.y, // dest x,y
-			dst_box.width, dst_box.height // composite width,height
-		);
+		composite_texture(pass, options, op, texture->image, mask,
+			0, 0, &dst_box);
 
 		pixman_image_set_transform(texture->image, NULL);
 	} else {
 		// No transforms or crop needed, just a straight blit from the source
 		pixman_image_set_transform(texture->image, NULL);
-		pixman_image_composite32(op, texture->image, mask, buffer->image,
-			src_box.x, src_box.y, 0, 0, dst_box.x, dst_box.y,
-			src_box.width, src_box.height);
+		composite_texture(pass, options, op, texture->image, mask,
+			src_box.x, src_box.y, &dst_box);
 	}
 
-	pixman_image_set_clip_region32(buffer->image, NULL);
-
 	if (texture->buffer != NULL) {
 		wlr_buffer_end_data_ptr_access(texture->buffer);
 	}
@@ -230,8 +435,230 @@ static void render_pass_add_decoration(struct wlr_render_pass *wlr_pass,
 		const struct wlr_render_decoration_options *options) {
 }
 
+// The shadow is a CPU port of render/gles2/shaders/shadow.frag
+
+#define SHADOW_PI 3.14159265358979323846f
+#define SHADOW_SQRT1_2 0.70710678118654752440f
+
+static float shadow_erf(float x) {
+	float s = x < 0.0f ? -1.0f : (x > 0.0f ? 1.0f : 0.0f);
+	float a = fabsf(x);
+	float t = 1.0f + (0.278393f + (0.230389f + 0.078108f * (a * a)) * a) * a;
+	t *= t;
+	return s - s / (t * t);
+}
+
+static float shadow_erf_range(float from, float to, float sigma) {
+	float scale = 1.0f / (sigma * SHADOW_SQRT1_2);
+	return (0.5f - 0.5f * shadow_erf(to * scale)) -
+		(0.5f - 0.5f * shadow_erf(from * scale));
+}
+
+static float shadow_gauss(float x, float sigma) {
+	float sigma_2 = sigma * sigma;
+	return 1.0f / sqrtf(2.0f * SHADOW_PI * sigma_2) *
+		expf(-(x * x) / (2.0f * sigma_2));
+}
+
+static float shadow_blur_corner(float px, float py, float r, float sigma) {
+	if (r <= 0.0f) {
+		return 0.0f;
+	}
+
+	px /= sigma;
+	py /= sigma;
+	r /= sigma;
+
+	if (fminf(px, py) <= -2.95f || fmaxf(px - r, py - r) >= 2.95f) {
+		return 0.0f;
+	}
+
+	float result = 0.0f;
+	float start = fmaxf(py - 3.0f, 0.0f);
+	float end = fminf(py + 3.0f, r);
+	float step = (end - start) / 7.0f;
+	float y = start;
+	for (int i = 0; i < 8; i++) {
+		float y_scaled = (r - y) / r;
+		float x = r - r * sqrtf(fmaxf(1.0f - y_scaled * y_scaled, 0.0f));
+		result -= shadow_gauss(py - y, 1.0f) * shadow_erf_range(-px, x - px, 1.0f);
+		y += step;
+	}
+	return step * result;
+}
+
+struct shadow_shape {
+	const struct wlr_render_shadow_options *options;
+	float x, y, width, height; // box, before swap_xy
+};
+
+// rel is relative to the shape and already flipped and swapped
+static void shadow_relative(const struct shadow_shape *shape, float px, float py,
+		float *rel_x, float *rel_y, float *width, float *height) {
+	*rel_x = px - shape->x;
+	*rel_y = py - shape->y;
+	if (shape->options->flip_x) {
+		*rel_x = shape->width - *rel_x;
+	}
+	if (shape->options->flip_y) {
+		*rel_y = shape->height - *rel_y;
+	}
+	*width = shape->width;
+	*height = shape->height;
+	if (shape->options->swap_xy) {
+		float tmp = *rel_x;
+		*rel_x = *rel_y;
+		*rel_y = tmp;
+		*width = shape->height;
+		*height = shape->width;
+	}
+}
+
+static float shadow_blur_rounded_rect(const struct shadow_shape *shape,
+		float px, float py, float sigma) {
+	float rx, ry, w, h;
+	shadow_relative(shape, px, py, &rx, &ry, &w, &h);
+	float top = shape->options->radius_top;
+	float bottom = shape->options->radius_bottom;
+
+	float result = shadow_erf_range(-rx, w - rx, sigma) *
+		shadow_erf_range(-ry, h - ry, sigma);
+	result -= shadow_blur_corner(rx, ry, top, sigma);
+	result -= shadow_blur_corner(w - rx, ry, top, sigma);
+	result -= shadow_blur_corner(w - rx, h - ry, bottom, sigma);
+	result -= shadow_blur_corner(rx, h - ry, bottom, sigma);
+	return result;
+}
+
+static float shadow_opacity(const struct shadow_shape *shape,
+		const struct shadow_shape *blurred, float px, float py) {
+	const struct wlr_render_shadow_options *options = shape->options;
+	float rx, ry, w, h;
+	shadow_relative(shape, px, py, &rx, &ry, &w, &h);
+
+	// Corner centers, with the radius that applies to them
+	float cx = -1.0f, cy = -1.0f, r = 0.0f;
+	float top = options->radius_top, bottom = options->radius_bottom;
+	if (top > 0.0f && ry < top + 0.5f) {
+		if (rx < top + 0.5f) {
+			cx = top;
+			cy = top;
+			r = top;
+		} else if (rx > w - (top + 0.5f)) {
+			cx = w - top;
+			cy = top;
+			r = top;
+		}
+	}
+	if (r == 0.0f && bottom > 0.0f && ry > h - (bottom + 0.5f)) {
+		if (rx < bottom + 0.5f) {
+			cx = bottom;
+			cy = h - bottom;
+			r = bottom;
+		} else if (rx > w - (bottom + 0.5f)) {
+			cx = w - bottom;
+			cy = h - bottom;
+			r = bottom;
+		}
+	}
+	if (r > 0.0f) {
+		float dx = rx - cx, dy = ry - cy;
+		float d = sqrtf(dx * dx + dy * dy);
+		if (d > r - 1.0f && options->blur <= 0.0f) {
+			float fw = 0.5f * d / fmaxf(fabsf(dx), fabsf(dy));
+			return antialias(d, r - 1.0f, r, fw);
+		}
+	}
+
+	if (options->blur > 0.0f) {
+		return shadow_blur_rounded_rect(blurred, px, py, options->blur);
+	}
+	return 1.0f;
+}
+
 static void render_pass_add_shadow(struct wlr_render_pass *wlr_pass,
 		const struct wlr_render_shadow_options *options) {
+	struct wlr_pixman_render_pass *pass = get_render_pass(wlr_pass);
+	struct wlr_pixman_buffer *buffer = pass->buffer;
+	const struct wlr_box *box = &options->box;
+
+	if (!options->enabled || options->color.a == 0 || wlr_box_empty(box)) {
+		return;
+	}
+
+	// Only the pixels in the clip are evaluated, so a clip that leaves out
+	// what the window covers saves most of the work.
+	pixman_region32_t region;
+	pixman_region32_init_rect(&region, box->x, box->y, box->width, box->height);
+	if (options->clip) {
+		pixman_region32_intersect(&region, &region, options->clip);
+	}
+	pixman_region32_intersect_rect(&region, &region, 0, 0,
+		buffer->buffer->width, buffer->buffer->height);
+	if (pixman_region32_empty(&region)) {
+		pixman_region32_fini(&region);
+		return;
+	}
+
+	pixman_box32_t *extents = pixman_region32_extents(&region);
+	int width = extents->x2 - extents->x1;
+	int height = extents->y2 - extents->y1;
+	pixman_image_t *mask = pixman_image_create_bits(PIXMAN_a8,
+		width, height, NULL, 0);
+	if (mask == NULL) {
+		pixman_region32_fini(&region);
+		return;
+	}
+	uint8_t *data = (uint8_t *)pixman_image_get_data(mask);
+	int stride = pixman_image_get_stride(mask);
+
+	struct shadow_shape shape = {
+		.options = options,
+		.x = box->x,
+		.y = box->y,
+		.width = box->width,
+		.height = box->height,
+	};
+	float blur = options->blur;
+	struct shadow_shape blurred = {
+		.options = options,
+		.x = box->x + blur,
+		.y = box->y + blur,
+		.width = box->width - 2.0f * blur,
+		.height = box->height - 2.0f * blur,
+	};
+
+	int rects_len;
+	const pixman_box32_t *rects = pixman_region32_rectangles(&region, &rects_len);
+	for (int i = 0; i < rects_len; i++) {
+		for (int y = rects[i].y1; y < rects[i].y2; y++) {
+			uint8_t *row = data + (y - extents->y1) * stride;
+			for (int x = rects[i].x1; x < rects[i].x2; x++) {
+				float opacity = shadow_opacity(&shape, &blurred,
+					x + 0.5f, y + 0.5f);
+				opacity = fminf(fmaxf(opacity, 0.0f), 1.0f);
+				row[x - extents->x1] = (uint8_t)lroundf(opacity * 0xFF);
+			}
+		}
+	}
+
+	struct pixman_color color = {
+		.red = options->color.r * 0xFFFF,
+		.green = options->color.g * 0xFFFF,
+		.blue = options->color.b * 0xFFFF,
+		.alpha = options->color.a * 0xFFFF,
+	};
+	pixman_image_t *fill = pixman_image_create_solid_fill(&color);
+
+	pixman_image_set_clip_region32(buffer->image, &region);
+	pixman_image_composite32(get_pixman_blending(options->blend_mode),
+		fill, mask, buffer->image, 0, 0, 0, 0,
+		extents->x1, extents->y1, width, height);
+	pixman_image_set_clip_region32(buffer->image, NULL);
+
+	pixman_image_unref(fill);
+	pixman_image_unref(mask);
+	pixman_region32_fini(&region);
 }
 
 static const struct wlr_render_pass_impl render_pass_impl = {
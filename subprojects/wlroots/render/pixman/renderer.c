@@ -337,6 +337,7 @@ static void pixman_destroy(struct wlr_renderer *wlr_renderer) {
 		wlr_texture_destroy(&tex->wlr_texture);
 	}
 
+	pixman_corner_masks_finish(renderer);
 	wlr_drm_format_set_finish(&renderer->drm_formats);
 
 	free(renderer);
@@ -383,6 +384,7 @@ struct wlr_renderer *wlr_pixman_renderer_create(void) {
 	wl_list_init(&renderer->buffers);
 	wl_list_init(&renderer->textures);
 	wl_list_init(&renderer->objects);
+	wl_list_init(&renderer->corner_masks);
 
 	size_t len = 0;
 	const uint32_t *formats = get_pixman_drm_formats(&len);
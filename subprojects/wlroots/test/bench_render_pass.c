@@ -28,6 +28,9 @@
 #define TEXTURE_SIZE   500
 #define STACKED_SIZE   500
 #define CLIP_MANY_ROWS 200
+// Clip to the ring a shadow of this size leaves around an opaque window
+#define CLIP_RING      0
+#define SHADOW_SIZE    40
 #define MAX_ITER       10000
 #define MIN_ITER       10
 #define WARMUP_ITER    2
@@ -35,6 +38,7 @@
 enum primitive_type {
 	RECT,
 	TEXTURE,
+	SHADOW,
 };
 
 enum layout_type {
@@ -150,6 +154,27 @@ static void bench_ctx_finish(struct bench_ctx *ctx) {
 	wl_event_loop_destroy(ctx->ev);
 }
 
+static struct wlr_box bench_box(const struct bench_case *bc, int i) {
+	if (bc->layout == STACKED) {
+		return (struct wlr_box){
+			.x = 0, .y = 0,
+			.width = STACKED_SIZE,
+			.height = STACKED_SIZE,
+		};
+	}
+
+	int cols = ceil(sqrt(bc->count));
+	int rows = (bc->count + cols - 1) / cols;
+	int tile_w = OUTPUT_WIDTH / cols;
+	int tile_h = OUTPUT_HEIGHT / rows;
+	return (struct wlr_box){
+		.x = (i % cols) * tile_w,
+		.y = (i / cols) * tile_h,
+		.width = tile_w,
+		.height = tile_h,
+	};
+}
+
 static void run_one(struct bench_ctx *ctx, const struct bench_case *bc,
 		const pixman_region32_t *clip, int64_t *out_cpu_ns,
 		int64_t *out_gpu_ns) {
@@ -171,38 +196,34 @@ static void run_one(struct bench_ctx *ctx, const struct bench_case *bc,
 	assert(pass);
 
 	for (int i = 0; i < bc->count; i++) {
-		struct wlr_box box;
-		if (bc->layout == STACKED) {
-			box = (struct wlr_box){
-				.x = 0, .y = 0,
-				.width = STACKED_SIZE,
-				.height = STACKED_SIZE,
-			};
-		} else {
-			int cols = ceil(sqrt(bc->count));
-			int rows = (bc->count + cols - 1) / cols;
-			int tile_w = OUTPUT_WIDTH / cols;
-			int tile_h = OUTPUT_HEIGHT / rows;
-			box = (struct wlr_box){
-				.x = (i % cols) * tile_w,
-				.y = (i / cols) * tile_h,
-				.width = tile_w,
-				.height = tile_h,
-			};
-		}
+		struct wlr_box box = bench_box(bc, i);
 
-		if (bc->primitive == RECT) {
+		switch (bc->primitive) {
+		case RECT:
 			wlr_render_pass_add_rect(pass, &(struct wlr_render_rect_options){
 				.box = box,
 				.color = { .r = 0.5, .g = 0.25, .b = 0.05, .a = 0.5 },
 				.clip = clip,
 			});
-		} else {
+			break;
+		case TEXTURE:
 			wlr_render_pass_add_texture(pass, &(struct wlr_render_texture_options){
 				.texture = ctx->texture,
 				.dst_box = box,
 				.clip = clip,
 			});
+			break;
+		case SHADOW:
+			wlr_render_pass_add_shadow(pass, &(struct wlr_render_shadow_options){
+				.box = box,
+				.clip = clip,
+				.enabled = true,
+				.radius_top = 10,
+				.radius_bottom = 10,
+				.blur = SHADOW_SIZE / 2,
+				.color = { .r = 0, .g = 0, .b = 0, .a = 0.4 },
+			});
+			break;
 		}
 	}
 
@@ -253,6 +274,25 @@ static struct bench_result run_benchmark(struct bench_ctx *ctx,
 
 	if (bc->clips == 1) {
 		pixman_region32_init_rect(&clip, 0, 0, OUTPUT_WIDTH, OUTPUT_HEIGHT);
+	} else if (bc->clips == CLIP_RING) {
+		// What remains of each box once the window it surrounds is culled
+		pixman_region32_init(&clip);
+		for (int i = 0; i < bc->count; i++) {
+			struct wlr_box box = bench_box(bc, i);
+			pixman_region32_t ring;
+			pixman_region32_init_rect(&ring,
+				box.x, box.y, box.width, box.height);
+			if (box.width > 2 * SHADOW_SIZE && box.height > 2 * SHADOW_SIZE) {
+				pixman_region32_t window;
+				pixman_region32_init_rect(&window,
+					box.x + SHADOW_SIZE, box.y + SHADOW_SIZE,
+					box.width - 2 * SHADOW_SIZE, box.height - 2 * SHADOW_SIZE);
+				pixman_region32_subtract(&ring, &ring, &window);
+				pixman_region32_fini(&window);
+			}
+			pixman_region32_union(&clip, &clip, &ring);
+			pixman_region32_fini(&ring);
+		}
 	} else {
 		// Varying width ensures that pixman does not merge adjacent rows.
 		pixman_region32_init(&clip);
@@ -299,12 +339,23 @@ static void print_result(const struct bench_case *bc,
 		const struct bench_result *r) {
 	int64_t cpu_per_op = r->cpu_ns / r->iters;
 	int64_t gpu_per_op = r->gpu_ns / r->iters;
-	const char *primitive_name = bc->primitive == RECT ? "Rect" : "Texture";
+	static const char *primitive_names[] = {
+		[RECT] = "Rect",
+		[TEXTURE] = "Texture",
+		[SHADOW] = "Shadow",
+	};
 	const char *layout_name = bc->layout == STACKED ? "stacked" : "grid";
 
+	char clip_name[16];
+	if (bc->clips == CLIP_RING) {
+		snprintf(clip_name, sizeof(clip_name), "ring");
+	} else {
+		snprintf(clip_name, sizeof(clip_name), "%d", bc->clips);
+	}
+
 	char name[64];
-	snprintf(name, sizeof(name), "Benchmark%s/%s/clip%d/%d",
-		primitive_name, layout_name, bc->clips, bc->count);
+	snprintf(name, sizeof(name), "Benchmark%s/%s/clip%s/%d",
+		primitive_names[bc->primitive], layout_name, clip_name, bc->count);
 
 	printf("%-40s %8d %12lld cpu-ns/op",
 		name, r->iters, (long long)cpu_per_op);
@@ -342,9 +393,9 @@ int main(int argc, char *argv[]) {
 	struct bench_ctx ctx = {0};
 	bench_ctx_init(&ctx);
 
-	static const int primitives[] = { RECT, TEXTURE, -1 };
+	static const int primitives[] = { RECT, TEXTURE, SHADOW, -1 };
 	static const int layouts[] = { STACKED, GRID, -1 };
-	static const int clips[] = { 1, 200, -1 };
+	static const int clips[] = { 1, CLIP_MANY_ROWS, CLIP_RING, -1 };
 	static const int counts[] = { 1, 4, 64, 1024, -1 };
 
 	// *art*.
@@ -0,0 +1,38 @@
+#include <assert.h>
+#include <stdlib.h>
+#include "mem_buffer.h"
+
+static void mem_buffer_destroy(struct wlr_buffer *wlr_buffer) {
+	struct mem_buffer *buffer = wl_container_of(wlr_buffer, buffer, base);
+	free(buffer->data);
+	free(buffer);
+}
+
+static bool mem_buffer_begin_data_ptr_access(struct wlr_buffer *wlr_buffer,
+		uint32_t flags, void **data, uint32_t *format, size_t *stride) {
+	struct mem_buffer *buffer = wl_container_of(wlr_buffer, buffer, base);
+	*data = buffer->data;
+	*format = buffer->format;
+	*stride = wlr_buffer->width * sizeof(uint32_t);
+	return true;
+}
+
+static void mem_buffer_end_data_ptr_access(struct wlr_buffer *wlr_buffer) {
+	// This space is intentionally left blank
+}
+
+static const struct wlr_buffer_impl mem_buffer_impl = {
+	.destroy = mem_buffer_destroy,
+	.begin_data_ptr_access = mem_buffer_begin_data_ptr_access,
+	.end_data_ptr_access = mem_buffer_end_data_ptr_access,
+};
+
+struct mem_buffer *mem_buffer_create(int width, int height, uint32_t format) {
+	struct mem_buffer *buffer = calloc(1, sizeof(*buffer));
+	assert(buffer);
+	buffer->data = calloc((size_t)width * height, sizeof(uint32_t));
+	assert(buffer->data);
+	buffer->format = format;
+	wlr_buffer_init(&buffer->base, &mem_buffer_impl, width, height);
+	return buffer;
+}
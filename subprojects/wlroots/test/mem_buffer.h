@@ -0,0 +1,17 @@
+#ifndef TEST_MEM_BUFFER_H
+#define TEST_MEM_BUFFER_H
+
+#include <stdint.h>
+#include <wlr/interfaces/wlr_buffer.h>
+
+// A wlr_buffer backed by plain memory, readable through data-pointer access
+struct mem_buffer {
+	struct wlr_buffer base;
+	uint32_t format;
+	uint32_t *data;
+};
+
+// The pixels are zero-initialized
+struct mem_buffer *mem_buffer_create(int width, int height, uint32_t format);
+
+#endif
@@ -0,0 +1,177 @@
+#include <assert.h>
+#include <drm_fourcc.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <wlr/render/pixman.h>
+#include <wlr/render/wlr_renderer.h>
+#include "mem_buffer.h"
+
+#define OUTPUT_SIZE 40
+#define TEXTURE_SIZE 20
+#define TEXTURE_POS 10
+
+struct test_ctx {
+	struct wlr_renderer *renderer;
+	struct mem_buffer *buffer;
+	struct wlr_texture *texture;
+};
+
+static void test_ctx_init(struct test_ctx *ctx) {
+	ctx->renderer = wlr_pixman_renderer_create();
+	assert(ctx->renderer);
+
+	ctx->buffer = mem_buffer_create(OUTPUT_SIZE, OUTPUT_SIZE, DRM_FORMAT_XRGB8888);
+
+	uint32_t pixels[TEXTURE_SIZE * TEXTURE_SIZE];
+	for (size_t i = 0; i < TEXTURE_SIZE * TEXTURE_SIZE; i++) {
+		pixels[i] = 0xFFFFFFFF;
+	}
+	ctx->texture = wlr_texture_from_pixels(ctx->renderer, DRM_FORMAT_ARGB8888,
+		TEXTURE_SIZE * sizeof(uint32_t), TEXTURE_SIZE, TEXTURE_SIZE, pixels);
+	assert(ctx->texture);
+}
+
+static void test_ctx_finish(struct test_ctx *ctx) {
+	wlr_texture_destroy(ctx->texture);
+	wlr_buffer_drop(&ctx->buffer->base);
+	wlr_renderer_destroy(ctx->renderer);
+}
+
+// Renders the white texture over a black buffer
+static void render(struct test_ctx *ctx, struct wlr_render_texture_options options) {
+	for (size_t i = 0; i < OUTPUT_SIZE * OUTPUT_SIZE; i++) {
+		ctx->buffer->data[i] = 0xFF000000;
+	}
+
+	struct wlr_render_pass *pass = wlr_renderer_begin_buffer_pass(ctx->renderer,
+		&ctx->buffer->base, NULL);
+	assert(pass);
+	options.texture = ctx->texture;
+	options.dst_box = (struct wlr_box){
+		.x = TEXTURE_POS,
+		.y = TEXTURE_POS,
+		.width = TEXTURE_SIZE,
+		.height = TEXTURE_SIZE,
+	};
+	options.blend_mode = WLR_RENDER_BLEND_MODE_PREMULTIPLIED;
+	wlr_render_pass_add_texture(pass, &options);
+	assert(wlr_render_pass_submit(pass));
+}
+
+// Blue channel of a pixel, relative to the top-left corner of the texture
+static uint8_t pixel(struct test_ctx *ctx, int x, int y) {
+	return ctx->buffer->data[(TEXTURE_POS + y) * OUTPUT_SIZE + TEXTURE_POS + x] & 0xFF;
+}
+
+// Allows for rounding differences between pixman's fast paths
+static bool near(uint8_t value, uint8_t expected) {
+	return abs((int)value - (int)expected) <= 1;
+}
+
+// Coverage of the top-left corner for a radius of 5, as computed by the
+// GLES2 texture shaders
+static const uint8_t corner_5[5][5] = {
+	{ 0, 0, 99, 224, 255 },
+	{ 0, 217, 250, 255, 255 },
+	{ 99, 250, 255, 255, 255 },
+	{ 224, 255, 255, 255, 255 },
+	{ 255, 255, 255, 255, 255 },
+};
+
+static void test_square(struct test_ctx *ctx) {
+	render(ctx, (struct wlr_render_texture_options){0});
+	assert(pixel(ctx, 0, 0) == 0xFF);
+	assert(pixel(ctx, TEXTURE_SIZE - 1, TEXTURE_SIZE - 1) == 0xFF);
+	assert(pixel(ctx, -1, -1) == 0);
+}
+
+static void test_rounded(struct test_ctx *ctx) {
+	render(ctx, (struct wlr_render_texture_options){
+		.radius_top = 5,
+		.radius_bottom = 5,
+	});
+	const int last = TEXTURE_SIZE - 1;
+	for (int y = 0; y < 5; y++) {
+		for (int x = 0; x < 5; x++) {
+			uint8_t expected = corner_5[y][x];
+			assert(near(pixel(ctx, x, y), expected));
+			assert(near(pixel(ctx, last - x, y), expected));
+			assert(near(pixel(ctx, x, last - y), expected));
+			assert(near(pixel(ctx, last - x, last - y), expected));
+		}
+	}
+	assert(pixel(ctx, TEXTURE_SIZE / 2, TEXTURE_SIZE / 2) == 0xFF);
+	assert(pixel(ctx, TEXTURE_SIZE / 2, 0) == 0xFF);
+	assert(pixel(ctx, -1, -1) == 0);
+}
+
+static void test_top_only(struct test_ctx *ctx) {
+	const int last = TEXTURE_SIZE - 1;
+
+	render(ctx, (struct wlr_render_texture_options){
+		.radius_top = 5,
+	});
+	assert(pixel(ctx, 0, 0) == 0);
+	assert(pixel(ctx, last, 0) == 0);
+	assert(pixel(ctx, 0, last) == 0xFF);
+	assert(pixel(ctx, last, last) == 0xFF);
+
+	// The radii follow the content, so flipping moves them to the bottom
+	render(ctx, (struct wlr_render_texture_options){
+		.radius_top = 5,
+		.flip_y = true,
+	});
+	assert(pixel(ctx, 0, 0) == 0xFF);
+	assert(pixel(ctx, 0, last) == 0);
+	assert(pixel(ctx, last, last) == 0);
+
+	// and swapping to the left
+	render(ctx, (struct wlr_render_texture_options){
+		.radius_top = 5,
+		.swap_xy = true,
+	});
+	assert(pixel(ctx, 0, 0) == 0);
+	assert(pixel(ctx, 0, last) == 0);
+	assert(pixel(ctx, last, 0) == 0xFF);
+}
+
+static void test_alpha(struct test_ctx *ctx) {
+	const float alpha = 0.5;
+	render(ctx, (struct wlr_render_texture_options){
+		.radius_top = 5,
+		.radius_bottom = 5,
+		.alpha = &alpha,
+	});
+	assert(pixel(ctx, 0, 0) == 0);
+	uint8_t center = pixel(ctx, TEXTURE_SIZE / 2, TEXTURE_SIZE / 2);
+	assert(center >= 0x7F && center <= 0x80);
+	// Partially covered corner pixels are faded by alpha as well
+	uint8_t edge = pixel(ctx, 2, 0);
+	assert(edge > 0 && edge < corner_5[0][2]);
+	assert(near(pixel(ctx, 4, 4), center));
+}
+
+static void test_too_small(struct test_ctx *ctx) {
+	// Corners that would overlap are left square
+	render(ctx, (struct wlr_render_texture_options){
+		.radius_top = TEXTURE_SIZE,
+	});
+	assert(pixel(ctx, 0, 0) == 0xFF);
+}
+
+int main(void) {
+	struct test_ctx ctx;
+	test_ctx_init(&ctx);
+
+	test_square(&ctx);
+	test_rounded(&ctx);
+	test_top_only(&ctx);
+	test_alpha(&ctx);
+	test_too_small(&ctx);
+	// Rendering again hits the cached masks
+	test_rounded(&ctx);
+
+	test_ctx_finish(&ctx);
+	return 0;
+}
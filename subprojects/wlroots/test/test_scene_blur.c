@@ -0,0 +1,202 @@
+#include <assert.h>
+#include <drm_fourcc.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <wayland-server-core.h>
+#include <wlr/backend/headless.h>
+#include <wlr/render/allocator.h>
+#include <wlr/render/pixman.h>
+#include <wlr/types/wlr_output.h>
+#include <wlr/types/wlr_scene.h>
+#include "mem_buffer.h"
+
+#define OUTPUT_WIDTH 128
+#define OUTPUT_HEIGHT 64
+#define WINDOW_SIZE 32
+
+struct test_ctx {
+	struct wl_display *display;
+	struct wlr_backend *backend;
+	struct wlr_renderer *renderer;
+	struct wlr_allocator *allocator;
+	struct wlr_output *output;
+
+	struct wlr_scene *scene;
+	struct wlr_scene_output *scene_output;
+	// Blurred: white on the left, a small grey square on the far right
+	struct wlr_scene_rect *wallpaper, *corner;
+	// Not blurred
+	struct wlr_scene_rect *other;
+	// A fully transparent window asking for blur behind all of it
+	struct wlr_scene_buffer *window;
+
+	uint32_t pixels[OUTPUT_WIDTH * OUTPUT_HEIGHT];
+};
+
+static void test_ctx_init(struct test_ctx *ctx) {
+	ctx->display = wl_display_create();
+	assert(ctx->display);
+	ctx->backend = wlr_headless_backend_create(wl_display_get_event_loop(ctx->display));
+	assert(ctx->backend);
+	ctx->renderer = wlr_pixman_renderer_create();
+	assert(ctx->renderer);
+	ctx->allocator = wlr_allocator_autocreate(ctx->backend, ctx->renderer);
+	assert(ctx->allocator);
+
+	ctx->output = wlr_headless_add_output(ctx->backend, OUTPUT_WIDTH, OUTPUT_HEIGHT);
+	assert(ctx->output);
+	assert(wlr_output_init_render(ctx->output, ctx->allocator, ctx->renderer));
+	struct wlr_output_state state;
+	wlr_output_state_init(&state);
+	wlr_output_state_set_enabled(&state, true);
+	wlr_output_state_set_custom_mode(&state, OUTPUT_WIDTH, OUTPUT_HEIGHT, 0);
+	assert(wlr_output_commit_state(ctx->output, &state));
+	wlr_output_state_finish(&state);
+
+	ctx->scene = wlr_scene_create();
+	assert(ctx->scene);
+	wlr_scene_set_blur_passes(ctx->scene, 1);
+	ctx->scene_output = wlr_scene_output_create(ctx->scene, ctx->output);
+	assert(ctx->scene_output);
+
+	struct wlr_scene_tree *sources = wlr_scene_tree_create(&ctx->scene->tree);
+	assert(sources);
+	sources->node.info.blur_source = true;
+	ctx->wallpaper = wlr_scene_rect_create(sources, WINDOW_SIZE, OUTPUT_HEIGHT,
+		(float[4]){ 1, 1, 1, 1 });
+	ctx->corner = wlr_scene_rect_create(sources, 16, 16,
+		(float[4]){ 0.5, 0.5, 0.5, 1 });
+	wlr_scene_node_set_position(&ctx->corner->node, OUTPUT_WIDTH - 16, 0);
+
+	ctx->other = wlr_scene_rect_create(&ctx->scene->tree, 8, 8,
+		(float[4]){ 0, 0, 1, 1 });
+	wlr_scene_node_set_position(&ctx->other->node, 52, 0);
+
+	struct mem_buffer *buffer = mem_buffer_create(WINDOW_SIZE, WINDOW_SIZE, DRM_FORMAT_ARGB8888);
+	ctx->window = wlr_scene_buffer_create(&ctx->scene->tree, &buffer->base);
+	assert(ctx->window);
+	wlr_buffer_drop(&buffer->base);
+	wlr_scene_node_set_position(&ctx->window->node, WINDOW_SIZE / 2, WINDOW_SIZE / 2);
+
+	pixman_region32_t blur;
+	pixman_region32_init_rect(&blur, 0, 0, WINDOW_SIZE, WINDOW_SIZE);
+	wlr_scene_buffer_set_blur_region(ctx->window, &blur);
+	pixman_region32_fini(&blur);
+}
+
+static void test_ctx_finish(struct test_ctx *ctx) {
+	wlr_scene_node_destroy(&ctx->scene->tree.node);
+	wlr_output_destroy(ctx->output);
+	wlr_allocator_destroy(ctx->allocator);
+	wlr_renderer_destroy(ctx->renderer);
+	wlr_backend_destroy(ctx->backend);
+	wl_display_destroy(ctx->display);
+}
+
+// Builds and commits a frame, keeping a copy of its pixels
+static void render_frame(struct test_ctx *ctx) {
+	struct wlr_output_state state;
+	wlr_output_state_init(&state);
+	assert(wlr_scene_output_build_state(ctx->scene_output, &state, NULL));
+	assert(state.buffer);
+
+	void *data;
+	uint32_t format;
+	size_t stride;
+	assert(wlr_buffer_begin_data_ptr_access(state.buffer,
+		WLR_BUFFER_DATA_PTR_ACCESS_READ, &data, &format, &stride));
+	for (int y = 0; y < OUTPUT_HEIGHT; y++) {
+		memcpy(&ctx->pixels[y * OUTPUT_WIDTH], (uint8_t *)data + y * stride,
+			OUTPUT_WIDTH * sizeof(uint32_t));
+	}
+	wlr_buffer_end_data_ptr_access(state.buffer);
+
+	assert(wlr_output_commit_state(ctx->output, &state));
+	wlr_output_state_finish(&state);
+}
+
+static uint8_t red(struct test_ctx *ctx, int x, int y) {
+	return (ctx->pixels[y * OUTPUT_WIDTH + x] >> 16) & 0xFF;
+}
+
+static uint8_t blue(struct test_ctx *ctx, int x, int y) {
+	return ctx->pixels[y * OUTPUT_WIDTH + x] & 0xFF;
+}
+
+static void test_pixels(struct test_ctx *ctx) {
+	render_frame(ctx);
+	assert(ctx->scene_output->blur.refreshes == 1);
+
+	const int y = OUTPUT_HEIGHT / 2;
+	// Outside of the blur region the edge stays sharp
+	assert(red(ctx, WINDOW_SIZE - 1, 4) == 0xFF);
+	assert(red(ctx, WINDOW_SIZE, 4) == 0);
+	// Behind the window it is blurred
+	uint8_t left = red(ctx, WINDOW_SIZE - 1, y);
+	uint8_t right = red(ctx, WINDOW_SIZE, y);
+	assert(left > 0x80 && left < 0xF0);
+	assert(right > 0x10 && right < 0x80);
+	// but the blur only reaches so far
+	assert(red(ctx, WINDOW_SIZE / 2 + 1, y) >= 0xF0);
+	assert(red(ctx, WINDOW_SIZE * 3 / 2 - 1, y) <= 0x10);
+	// and only the blur sources are blurred
+	assert(blue(ctx, 55, 4) == 0xFF);
+}
+
+static void test_damage(struct test_ctx *ctx) {
+	// Nothing changed, the cache is used as is
+	render_frame(ctx);
+	assert(ctx->scene_output->blur.refreshes == 1);
+
+	// Non-sources don't touch the cache
+	wlr_scene_rect_set_color(ctx->other, (float[4]){ 0, 1, 0, 1 });
+	render_frame(ctx);
+	assert(ctx->scene_output->blur.refreshes == 1);
+
+	// Neither do sources too far away to affect the blur region
+	wlr_scene_rect_set_color(ctx->corner, (float[4]){ 1, 1, 1, 1 });
+	render_frame(ctx);
+	assert(ctx->scene_output->blur.refreshes == 1);
+	assert(red(ctx, OUTPUT_WIDTH - 1, 0) == 0xFF);
+
+	// Moving the window needs parts never blurred before
+	wlr_scene_node_set_position(&ctx->window->node, WINDOW_SIZE / 2 + 4, WINDOW_SIZE / 2);
+	render_frame(ctx);
+	assert(ctx->scene_output->blur.refreshes == 2);
+	uint64_t area = ctx->scene_output->blur.area;
+	assert(area < 2 * WINDOW_SIZE * WINDOW_SIZE);
+
+	// but not when it goes back
+	wlr_scene_node_set_position(&ctx->window->node, WINDOW_SIZE / 2, WINDOW_SIZE / 2);
+	render_frame(ctx);
+	assert(ctx->scene_output->blur.refreshes == 2);
+	assert(red(ctx, WINDOW_SIZE / 2 + 1, OUTPUT_HEIGHT / 2) >= 0xF0);
+
+	// Sources within reach are blurred again
+	wlr_scene_rect_set_color(ctx->wallpaper, (float[4]){ 0, 0, 1, 1 });
+	render_frame(ctx);
+	assert(ctx->scene_output->blur.refreshes == 3);
+	assert(ctx->scene_output->blur.area > area);
+	assert(red(ctx, WINDOW_SIZE / 2 + 1, OUTPUT_HEIGHT / 2) == 0);
+	assert(blue(ctx, WINDOW_SIZE / 2 + 1, OUTPUT_HEIGHT / 2) >= 0xF0);
+}
+
+static void test_disabled(struct test_ctx *ctx) {
+	wlr_scene_set_blur_passes(ctx->scene, 0);
+	render_frame(ctx);
+	assert(blue(ctx, WINDOW_SIZE - 1, OUTPUT_HEIGHT / 2) == 0xFF);
+	assert(blue(ctx, WINDOW_SIZE, OUTPUT_HEIGHT / 2) == 0);
+}
+
+int main(void) {
+	struct test_ctx ctx;
+	test_ctx_init(&ctx);
+
+	test_pixels(&ctx);
+	test_damage(&ctx);
+	test_disabled(&ctx);
+
+	test_ctx_finish(&ctx);
+	return 0;
+}
@@ -0,0 +1,148 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <wlr/xcursor.h>
+
+#define CURSOR_SIZE 4
+
+static char base_dir[] = "/tmp/wlr-test-xcursor-XXXXXX";
+
+static void write_uint(FILE *f, uint32_t value) {
+	uint8_t bytes[4] = { value, value >> 8, value >> 16, value >> 24 };
+	assert(fwrite(bytes, sizeof(bytes), 1, f) == 1);
+}
+
+// Writes an Xcursor file with a single CURSOR_SIZE image
+static void write_cursor(const char *theme, const char *name) {
+	char path[256];
+	snprintf(path, sizeof(path), "%s/%s/cursors/%s", base_dir, theme, name);
+	FILE *f = fopen(path, "w");
+	assert(f);
+
+	// File header and table of contents
+	write_uint(f, 0x72756358);
+	write_uint(f, 16);
+	write_uint(f, 0x10000);
+	write_uint(f, 1);
+	write_uint(f, 0xfffd0002);
+	write_uint(f, CURSOR_SIZE);
+	write_uint(f, 16 + 12);
+
+	// Image chunk
+	write_uint(f, 36);
+	write_uint(f, 0xfffd0002);
+	write_uint(f, CURSOR_SIZE);
+	write_uint(f, 1);
+	write_uint(f, CURSOR_SIZE);
+	write_uint(f, CURSOR_SIZE);
+	write_uint(f, 1);
+	write_uint(f, 2);
+	write_uint(f, 0);
+	for (int i = 0; i < CURSOR_SIZE * CURSOR_SIZE; i++) {
+		write_uint(f, 0xFFFFFFFF);
+	}
+	fclose(f);
+}
+
+static void create_theme(const char *theme, const char *inherits) {
+	char path[256];
+	snprintf(path, sizeof(path), "%s/%s", base_dir, theme);
+	assert(mkdir(path, 0700) == 0);
+	snprintf(path, sizeof(path), "%s/%s/cursors", base_dir, theme);
+	assert(mkdir(path, 0700) == 0);
+	if (inherits) {
+		snprintf(path, sizeof(path), "%s/%s/index.theme", base_dir, theme);
+		FILE *f = fopen(path, "w");
+		assert(f);
+		fprintf(f, "[Icon Theme]\nInherits=%s\n", inherits);
+		fclose(f);
+	}
+}
+
+static void test_lazy(void) {
+	struct wlr_xcursor_theme *theme = wlr_xcursor_theme_load_lazy("child", CURSOR_SIZE);
+	assert(theme);
+	// Only the default cursor is read up front
+	assert(theme->cursor_count == 1);
+	struct wlr_xcursor *cursor = wlr_xcursor_theme_get_cursor(theme, "default");
+	assert(cursor && cursor->image_count == 1);
+	assert(cursor->images[0]->hotspot_x == 1 && cursor->images[0]->hotspot_y == 2);
+
+	// Inherited cursors and legacy names are found as well
+	assert(wlr_xcursor_theme_get_cursor(theme, "text"));
+	assert(wlr_xcursor_theme_get_cursor(theme, "pointer"));
+	assert(theme->cursor_count == 3);
+	assert(wlr_xcursor_theme_get_cursor(theme, "text") ==
+		wlr_xcursor_theme_get_cursor(theme, "text"));
+	assert(theme->cursor_count == 3);
+
+	// Missing cursors are remembered rather than looked up again
+	assert(!wlr_xcursor_theme_get_cursor(theme, "wait"));
+	write_cursor("parent", "wait");
+	assert(!wlr_xcursor_theme_get_cursor(theme, "wait"));
+	assert(theme->cursor_count == 3);
+
+	assert(!wlr_xcursor_theme_get_cursor(theme, "../parent/cursors/text"));
+
+	wlr_xcursor_theme_destroy(theme);
+
+	// A new theme picks up the new file
+	theme = wlr_xcursor_theme_load_lazy("child", CURSOR_SIZE);
+	assert(wlr_xcursor_theme_get_cursor(theme, "wait"));
+	wlr_xcursor_theme_destroy(theme);
+}
+
+static void test_eager(void) {
+	struct wlr_xcursor_theme *theme = wlr_xcursor_theme_load("child", CURSOR_SIZE);
+	assert(theme);
+	assert(theme->cursor_count == 4);
+	wlr_xcursor_theme_destroy(theme);
+}
+
+static void test_fallback(void) {
+	struct wlr_xcursor_theme *theme = wlr_xcursor_theme_load_lazy("missing", CURSOR_SIZE);
+	assert(theme);
+	assert(strcmp(theme->name, "default") == 0);
+	assert(theme->cursor_count > 1);
+	assert(wlr_xcursor_theme_get_cursor(theme, "default"));
+	wlr_xcursor_theme_destroy(theme);
+}
+
+static void remove_theme(const char *theme) {
+	const char *names[] = { "default", "hand1", "text", "wait" };
+	char path[256];
+	for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+		snprintf(path, sizeof(path), "%s/%s/cursors/%s", base_dir, theme, names[i]);
+		unlink(path);
+	}
+	snprintf(path, sizeof(path), "%s/%s/index.theme", base_dir, theme);
+	unlink(path);
+	snprintf(path, sizeof(path), "%s/%s/cursors", base_dir, theme);
+	rmdir(path);
+	snprintf(path, sizeof(path), "%s/%s", base_dir, theme);
+	rmdir(path);
+}
+
+int main(void) {
+	assert(mkdtemp(base_dir));
+	setenv("XCURSOR_PATH", base_dir, 1);
+
+	create_theme("child", "parent");
+	write_cursor("child", "default");
+	write_cursor("child", "hand1");
+	create_theme("parent", NULL);
+	write_cursor("parent", "text");
+
+	test_lazy();
+	test_eager();
+	test_fallback();
+
+	remove_theme("child");
+	remove_theme("parent");
+	rmdir(base_dir);
+	return 0;
+}
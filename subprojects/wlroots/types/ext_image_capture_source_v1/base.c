@@ -29,6 +29,17 @@ struct wlr_ext_image_capture_source_v1 *wlr_ext_image_capture_source_v1_from_res
 
 static void source_handle_resource_destroy(struct wl_resource *resource) {
 	wl_list_remove(wl_resource_get_link(resource));
+	struct wlr_ext_image_capture_source_v1 *source =
+		wlr_ext_image_capture_source_v1_from_resource(resource);
+	if (source != NULL) {
+		wlr_ext_image_capture_source_v1_check_unused(source);
+	}
+}
+
+void wlr_ext_image_capture_source_v1_check_unused(struct wlr_ext_image_capture_source_v1 *source) {
+	if (wl_list_empty(&source->resources) && source->num_sessions == 0) {
+		wl_signal_emit_mutable(&source->events.unused, NULL);
+	}
 }
 
 void wlr_ext_image_capture_source_v1_init(struct wlr_ext_image_capture_source_v1 *source,
@@ -40,6 +51,7 @@ void wlr_ext_image_capture_source_v1_init(struct wlr_ext_image_capture_source_v1
 	wl_signal_init(&source->events.destroy);
 	wl_signal_init(&source->events.constraints_update);
 	wl_signal_init(&source->events.frame);
+	wl_signal_init(&source->events.unused);
 }
 
 void wlr_ext_image_capture_source_v1_finish(struct wlr_ext_image_capture_source_v1 *source) {
@@ -48,6 +60,7 @@ void wlr_ext_image_capture_source_v1_finish(struct wlr_ext_image_capture_source_
 	assert(wl_list_empty(&source->events.destroy.listener_list));
 	assert(wl_list_empty(&source->events.constraints_update.listener_list));
 	assert(wl_list_empty(&source->events.frame.listener_list));
+	assert(wl_list_empty(&source->events.unused.listener_list));
 
 	struct wl_resource *resource, *resource_tmp;
 	wl_resource_for_each_safe(resource, resource_tmp, &source->resources) {
@@ -0,0 +1,187 @@
+#include <assert.h>
+#include <drm_fourcc.h>
+#include <stdlib.h>
+#include <wlr/render/allocator.h>
+#include <wlr/render/wlr_renderer.h>
+#include <wlr/types/wlr_buffer.h>
+#include <wlr/types/wlr_output.h>
+#include <wlr/util/log.h>
+#include <wlr/util/region.h>
+#include "types/wlr_output.h"
+#include "types/wlr_scene.h"
+
+/**
+ * Dual Kawase blur made of plain textured draws, so every renderer gets it:
+ * each level is drawn from the previous one at half (or double) the size,
+ * once in place and once shifted by one pixel in each diagonal direction.
+ * Bilinear filtering does the rest of the averaging.
+ *
+ * level[0] is the sharp content, level[1..passes] are downsampled and
+ * up[passes - 1..0] are upsampled back, up[0] being the blurred result.
+ */
+struct scene_blur {
+	struct wlr_renderer *renderer;
+	int width, height;
+	int passes;
+
+	struct wlr_buffer *level[SCENE_BLUR_MAX_PASSES + 1];
+	struct wlr_texture *level_texture[SCENE_BLUR_MAX_PASSES + 1];
+	struct wlr_buffer *up[SCENE_BLUR_MAX_PASSES];
+	struct wlr_texture *up_texture[SCENE_BLUR_MAX_PASSES];
+};
+
+int scene_blur_radius(int passes) {
+	// Each down pass reaches 1.5 and each up pass 3 pixels of its own level,
+	// which adds up to just under 6 full size pixels per level
+	return 6 << passes;
+}
+
+static bool blur_create_level(struct scene_blur *blur, struct wlr_allocator *allocator,
+		const struct wlr_drm_format *format, int scale, struct wlr_buffer **buffer,
+		struct wlr_texture **texture) {
+	int width = (blur->width + scale - 1) / scale;
+	int height = (blur->height + scale - 1) / scale;
+	*buffer = wlr_allocator_create_buffer(allocator, width, height, format);
+	if (*buffer == NULL) {
+		return false;
+	}
+	*texture = wlr_texture_from_buffer(blur->renderer, *buffer);
+	return *texture != NULL;
+}
+
+struct scene_blur *scene_blur_create(struct wlr_output *output,
+		int width, int height, int passes) {
+	assert(passes > 0 && passes <= SCENE_BLUR_MAX_PASSES);
+
+	struct wlr_drm_format format = {0};
+	if (!output_pick_format(output, NULL, &format, DRM_FORMAT_ARGB8888)) {
+		wlr_log(WLR_ERROR, "Failed to pick a format for the blur cache");
+		return NULL;
+	}
+
+	struct scene_blur *blur = calloc(1, sizeof(*blur));
+	if (blur == NULL) {
+		wlr_drm_format_finish(&format);
+		return NULL;
+	}
+	blur->renderer = output->renderer;
+	blur->width = width;
+	blur->height = height;
+	blur->passes = passes;
+
+	bool ok = true;
+	for (int i = 0; ok && i <= passes; i++) {
+		ok = blur_create_level(blur, output->allocator, &format, 1 << i,
+			&blur->level[i], &blur->level_texture[i]);
+	}
+	for (int i = 0; ok && i < passes; i++) {
+		ok = blur_create_level(blur, output->allocator, &format, 1 << i,
+			&blur->up[i], &blur->up_texture[i]);
+	}
+	wlr_drm_format_finish(&format);
+
+	if (!ok) {
+		wlr_log(WLR_ERROR, "Failed to allocate the blur cache");
+		scene_blur_destroy(blur);
+		return NULL;
+	}
+	return blur;
+}
+
+void scene_blur_destroy(struct scene_blur *blur) {
+	if (blur == NULL) {
+		return;
+	}
+	for (int i = 0; i <= SCENE_BLUR_MAX_PASSES; i++) {
+		wlr_texture_destroy(blur->level_texture[i]);
+		wlr_buffer_drop(blur->level[i]);
+	}
+	for (int i = 0; i < SCENE_BLUR_MAX_PASSES; i++) {
+		wlr_texture_destroy(blur->up_texture[i]);
+		wlr_buffer_drop(blur->up[i]);
+	}
+	free(blur);
+}
+
+bool scene_blur_matches(struct scene_blur *blur, int width, int height, int passes) {
+	return blur->width == width && blur->height == height && blur->passes == passes;
+}
+
+struct wlr_buffer *scene_blur_get_source(struct scene_blur *blur) {
+	return blur->level[0];
+}
+
+struct wlr_texture *scene_blur_get_texture(struct scene_blur *blur) {
+	return blur->up_texture[0];
+}
+
+static bool blur_pass(struct scene_blur *blur, struct wlr_texture *src,
+		struct wlr_buffer *dst, const pixman_region32_t *clip) {
+	struct wlr_render_pass *pass =
+		wlr_renderer_begin_buffer_pass(blur->renderer, dst, NULL);
+	if (pass == NULL) {
+		return false;
+	}
+
+	struct wlr_box box = { .width = dst->width, .height = dst->height };
+	wlr_render_pass_add_texture(pass, &(struct wlr_render_texture_options){
+		.texture = src,
+		.dst_box = box,
+		.clip = clip,
+		.filter_mode = WLR_SCALE_FILTER_BILINEAR,
+		.blend_mode = WLR_RENDER_BLEND_MODE_NONE,
+	});
+
+	// The centre weighs 4 and each diagonal 1: blending the n-th diagonal
+	// with 1 / (4 + n) keeps a running average of the copies drawn so far
+	static const int offsets[4][2] = { { -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 } };
+	for (int i = 0; i < 4; i++) {
+		float alpha = 1.0f / (5 + i);
+		struct wlr_box shifted = box;
+		shifted.x += offsets[i][0];
+		shifted.y += offsets[i][1];
+		wlr_render_pass_add_texture(pass, &(struct wlr_render_texture_options){
+			.texture = src,
+			.dst_box = shifted,
+			.clip = clip,
+			.alpha = &alpha,
+			.filter_mode = WLR_SCALE_FILTER_BILINEAR,
+		});
+	}
+
+	return wlr_render_pass_submit(pass);
+}
+
+// Scales a full size region down to the given level, rounding outwards
+static void blur_level_region(pixman_region32_t *dst, const pixman_region32_t *src,
+		int level, const struct wlr_buffer *buffer) {
+	wlr_region_scale(dst, src, 1.0f / (1 << level));
+	wlr_region_expand(dst, dst, 1);
+	pixman_region32_intersect_rect(dst, dst, 0, 0, buffer->width, buffer->height);
+}
+
+bool scene_blur_render(struct scene_blur *blur, const pixman_region32_t *region) {
+	// Everything within the radius contributes to the region
+	pixman_region32_t damage;
+	pixman_region32_init(&damage);
+	wlr_region_expand(&damage, region, scene_blur_radius(blur->passes));
+
+	pixman_region32_t clip;
+	pixman_region32_init(&clip);
+
+	bool ok = true;
+	for (int i = 1; ok && i <= blur->passes; i++) {
+		blur_level_region(&clip, &damage, i, blur->level[i]);
+		ok = blur_pass(blur, blur->level_texture[i - 1], blur->level[i], &clip);
+	}
+	for (int i = blur->passes - 1; ok && i >= 0; i--) {
+		struct wlr_texture *src = i == blur->passes - 1 ?
+			blur->level_texture[blur->passes] : blur->up_texture[i + 1];
+		blur_level_region(&clip, &damage, i, blur->up[i]);
+		ok = blur_pass(blur, src, blur->up[i], &clip);
+	}
+
+	pixman_region32_fini(&clip);
+	pixman_region32_fini(&damage);
+	return ok;
+}
@@ -4,12 +4,14 @@
 #include <wlr/types/wlr_color_management_v1.h>
 #include <wlr/types/wlr_color_representation_v1.h>
 #include <wlr/types/wlr_compositor.h>
+#include <wlr/types/wlr_ext_background_effect_v1.h>
 #include <wlr/types/wlr_scene.h>
 #include <wlr/types/wlr_fractional_scale_v1.h>
 #include <wlr/types/wlr_linux_drm_syncobj_v1.h>
 #include <wlr/types/wlr_output.h>
 #include <wlr/types/wlr_presentation_time.h>
 #include <wlr/types/wlr_single_pixel_buffer_v1.h>
+#include <wlr/util/region.h>
 #include <wlr/util/transform.h>
 #include "types/wlr_scene.h"
 
@@ -283,6 +285,29 @@ static void scene_surface_get_sizes(struct wlr_scene_surface *scene_surface, str
 	}
 }
 
+// Sets the blur region requested through ext-background-effect, scaled from
+// surface coordinates to the size of the buffer node
+static void scene_surface_set_blur_region(struct wlr_scene_surface *scene_surface,
+		int width, int height, double dst_width, double dst_height) {
+	const struct wlr_ext_background_effect_surface_v1_state *effect_state =
+		wlr_ext_background_effect_v1_get_surface_state(scene_surface->surface);
+
+	pixman_region32_t blur;
+	pixman_region32_init(&blur);
+	if (effect_state != NULL && width > 0 && height > 0) {
+		pixman_region32_copy(&blur, &effect_state->blur_region);
+		if (!wlr_box_empty(&scene_surface->clip)) {
+			pixman_region32_translate(&blur,
+				-scene_surface->clip.x, -scene_surface->clip.y);
+		}
+		pixman_region32_intersect_rect(&blur, &blur, 0, 0, width, height);
+		wlr_region_scale_xy(&blur, &blur, MAX(1, dst_width) / width,
+			MAX(1, dst_height) / height);
+	}
+	wlr_scene_buffer_set_blur_region(scene_surface->buffer, &blur);
+	pixman_region32_fini(&blur);
+}
+
 void wlr_scene_surface_resize(struct wlr_scene_surface *scene_surface,
 		double total_scale, double anim_wscale, double anim_hscale,
 		float radius_top, float radius_bottom) {
@@ -307,6 +332,7 @@ void wlr_scene_surface_resize(struct wlr_scene_surface *scene_surface,
 	wlr_scene_buffer_set_dest_size(scene_buffer, MAX(1, dst_width),
 		MAX(1, dst_height));
 	wlr_scene_buffer_set_radius(scene_buffer, radius_top, radius_bottom);
+	scene_surface_set_blur_region(scene_surface, width, height, dst_width, dst_height);
 	pixman_region32_fini(&opaque);
 }
 
@@ -367,6 +393,7 @@ static void surface_reconfigure(struct wlr_scene_surface *scene_surface) {
 	wlr_scene_buffer_set_dest_size(scene_buffer, MAX(1, dst_width),
 		MAX(1, dst_height));
 	wlr_scene_buffer_set_radius(scene_buffer, view_data.radius_top, view_data.radius_bottom);
+	scene_surface_set_blur_region(scene_surface, width, height, dst_width, dst_height);
 	wlr_scene_buffer_set_transform(scene_buffer, state->transform);
 	wlr_scene_buffer_set_opacity(scene_buffer, opacity);
 	wlr_scene_buffer_set_transfer_function(scene_buffer, tf);
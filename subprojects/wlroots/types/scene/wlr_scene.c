@@ -210,6 +210,7 @@ void wlr_scene_node_destroy(struct wlr_scene_node *node) {
 		scene_buffer_set_buffer(scene_buffer, NULL);
 		scene_buffer_set_texture(scene_buffer, NULL);
 		pixman_region32_fini(&scene_buffer->opaque_region);
+		pixman_region32_fini(&scene_buffer->blur_region);
 		wlr_drm_syncobj_timeline_unref(scene_buffer->wait_timeline);
 
 		assert(wl_list_empty(&scene_buffer->events.outputs_update.listener_list));
@@ -355,6 +356,81 @@ static bool scene_nodes_in_box(struct wlr_scene_node *node, struct wlr_box *box,
 	return _scene_nodes_in_box(node, box, iterator, user_data, x, y);
 }
 
+static void region_subtract_corners(pixman_region32_t *region, int width,
+		int height, double radius_top, double radius_bottom) {
+	int top = ceil(radius_top);
+	int bottom = ceil(radius_bottom);
+	if (top > 0) {
+		pixman_region32_t corners;
+		pixman_region32_init_rect(&corners, 0, 0, top, top);
+		pixman_region32_union_rect(&corners, &corners, width - top, 0, top, top);
+		pixman_region32_subtract(region, region, &corners);
+		pixman_region32_fini(&corners);
+	}
+	if (bottom > 0) {
+		pixman_region32_t corners;
+		pixman_region32_init_rect(&corners, 0, height - bottom, bottom, bottom);
+		pixman_region32_union_rect(&corners, &corners,
+			width - bottom, height - bottom, bottom, bottom);
+		pixman_region32_subtract(region, region, &corners);
+		pixman_region32_fini(&corners);
+	}
+}
+
+/**
+ * The parts of a decoration drawn with opaque colors: the title bar and the
+ * straight sides of the border, leaving out rounded corners and antialiased
+ * edges. Knowing them lets the visibility pass cull the shadow below.
+ */
+static void scene_decoration_opaque_region(struct wlr_scene_decoration *decoration,
+		int width, int height, pixman_region32_t *opaque) {
+	int title_height = 0;
+	if (decoration->title_bar) {
+		title_height = ceil(decoration->title_bar_height);
+		if (decoration->title_bar_color[3] == 1.f) {
+			pixman_region32_union_rect(opaque, opaque, 0, 0,
+				width, floor(decoration->title_bar_height));
+			region_subtract_corners(opaque, width, height,
+				decoration->title_bar_border_radius, 0);
+		}
+	}
+
+	if (!decoration->border || decoration->border_width < 1.0 ||
+			decoration->border_top_color[3] != 1.f ||
+			decoration->border_bottom_color[3] != 1.f ||
+			decoration->border_left_color[3] != 1.f ||
+			decoration->border_right_color[3] != 1.f) {
+		return;
+	}
+
+	int bw = floor(decoration->border_width);
+	// The top border starts below the title bar, which may end mid-pixel
+	int top_bw = floor(title_height > 0 ?
+		decoration->title_bar_height + decoration->border_width :
+		decoration->border_width) - title_height;
+	double radius = decoration->border_radius;
+	int top = radius > 0.0 && !decoration->title_bar ?
+		ceil(radius + decoration->border_width + 0.5) : 0;
+	int bottom = radius > 0.0 ?
+		ceil(radius + decoration->border_width + 0.5) : 0;
+	int side = height - title_height - top - bottom;
+
+	if (width - top * 2 > 0 && top_bw > 0) {
+		pixman_region32_union_rect(opaque, opaque, top, title_height,
+			width - top * 2, top_bw);
+	}
+	if (width - bottom * 2 > 0) {
+		pixman_region32_union_rect(opaque, opaque, bottom, height - bw,
+			width - bottom * 2, bw);
+	}
+	if (side > 0) {
+		pixman_region32_union_rect(opaque, opaque, 0, title_height + top,
+			bw, side);
+		pixman_region32_union_rect(opaque, opaque, width - bw, title_height + top,
+			bw, side);
+	}
+}
+
 static void scene_node_opaque_region(struct wlr_scene_node *node, int x, int y,
 		pixman_region32_t *opaque) {
 	double width, height;
@@ -376,17 +452,24 @@ static void scene_node_opaque_region(struct wlr_scene_node *node, int x, int y,
 			return;
 		}
 
-		if (scene_buffer->radius_top > 0.0f || scene_buffer->radius_bottom > 0.0f) {
-			return;
-		}
-
 		if (!scene_buffer->buffer_is_opaque) {
 			pixman_region32_copy(opaque, &scene_buffer->opaque_region);
 			pixman_region32_intersect_rect(opaque, opaque, 0, 0, round(width), round(height));
-			pixman_region32_translate(opaque, x, y);
-			return;
+		} else {
+			pixman_region32_fini(opaque);
+			pixman_region32_init_rect(opaque, 0, 0, round(width), round(height));
 		}
-	} else if (node->type == WLR_SCENE_NODE_DECORATION || node->type == WLR_SCENE_NODE_SHADOW) {
+		// Only the rounded corners are see-through
+		region_subtract_corners(opaque, round(width), round(height),
+			scene_buffer->radius_top, scene_buffer->radius_bottom);
+		pixman_region32_translate(opaque, x, y);
+		return;
+	} else if (node->type == WLR_SCENE_NODE_DECORATION) {
+		scene_decoration_opaque_region(wlr_scene_decoration_from_node(node),
+			round(width), round(height), opaque);
+		pixman_region32_translate(opaque, x, y);
+		return;
+	} else if (node->type == WLR_SCENE_NODE_SHADOW) {
 		return;
 	}
 
@@ -401,12 +484,72 @@ struct scene_update_data {
 	struct wl_list *outputs;
 	bool calculate_visibility;
 	bool restack_xwayland_surfaces;
+	// In workspaces overview, visible is kept in the coordinates where
+	// nodes are displayed instead of scene coordinates
+	bool overview;
 
 #if WLR_HAS_XWAYLAND
 	struct wlr_xwayland_surface *restack_above;
 #endif
 };
 
+/**
+ * Maps every rectangle of the region with p' = to + (p - from) * scale. With
+ * inner, only the pixels fully covered by the mapped rectangles are kept,
+ * otherwise the result is rounded outwards.
+ */
+static void region_map(pixman_region32_t *region, double scale,
+		double from_x, double from_y, double to_x, double to_y, bool inner) {
+	int nrects;
+	const pixman_box32_t *rects = pixman_region32_rectangles(region, &nrects);
+	if (nrects == 0) {
+		return;
+	}
+
+	pixman_box32_t *mapped = malloc(nrects * sizeof(*mapped));
+	if (mapped == NULL) {
+		return;
+	}
+
+	int len = 0;
+	for (int i = 0; i < nrects; ++i) {
+		double x1 = to_x + (rects[i].x1 - from_x) * scale;
+		double y1 = to_y + (rects[i].y1 - from_y) * scale;
+		double x2 = to_x + (rects[i].x2 - from_x) * scale;
+		double y2 = to_y + (rects[i].y2 - from_y) * scale;
+		pixman_box32_t box = {
+			.x1 = inner ? ceil(x1) : floor(x1),
+			.y1 = inner ? ceil(y1) : floor(y1),
+			.x2 = inner ? floor(x2) : ceil(x2),
+			.y2 = inner ? floor(y2) : ceil(y2),
+		};
+		if (box.x1 < box.x2 && box.y1 < box.y2) {
+			mapped[len++] = box;
+		}
+	}
+
+	pixman_region32_fini(region);
+	pixman_region32_init_rects(region, mapped, len);
+	free(mapped);
+}
+
+// Scene coordinates to where the region is displayed in workspaces overview
+static void workspace_region_from_scene(pixman_region32_t *region,
+		const struct wlr_scene_workspace_data *workspace, bool inner) {
+	region_map(region, workspace->scale,
+		workspace->output_x, workspace->output_y,
+		workspace->output_x + workspace->x, workspace->output_y + workspace->y,
+		inner);
+}
+
+static void workspace_region_to_scene(pixman_region32_t *region,
+		const struct wlr_scene_workspace_data *workspace) {
+	region_map(region, 1.0 / workspace->scale,
+		workspace->output_x + workspace->x, workspace->output_y + workspace->y,
+		workspace->output_x, workspace->output_y,
+		false);
+}
+
 static uint32_t region_area(const pixman_region32_t *region) {
 	uint32_t area = 0;
 
@@ -437,6 +580,9 @@ struct render_data {
 
 	struct wlr_render_pass *render_pass;
 	pixman_region32_t damage;
+
+	// Rendering the blur sources to the blur cache
+	bool blur_source;
 };
 
 static void logical_to_buffer_coords(pixman_region32_t *region, const struct render_data *data,
@@ -514,6 +660,43 @@ static void scene_damage_outputs(struct wlr_scene *scene, const pixman_region32_
 	}
 }
 
+// Marks the blurred blur sources stale as far as a change in the damage
+// region reaches
+static void scene_output_blur_damage(struct wlr_scene_output *scene_output,
+		const pixman_region32_t *damage) {
+	if (scene_output->blur_cache == NULL) {
+		return;
+	}
+
+	struct wlr_output *output = scene_output->output;
+	pixman_region32_t stale;
+	pixman_region32_init(&stale);
+	wlr_region_expand(&stale, damage, scene_blur_radius(scene_output->scene->blur_passes));
+	pixman_region32_intersect_rect(&stale, &stale, 0, 0, output->width, output->height);
+	pixman_region32_union(&scene_output->blur_stale, &scene_output->blur_stale, &stale);
+	pixman_region32_fini(&stale);
+}
+
+static void scene_damage_blur_sources(struct wlr_scene *scene,
+		const pixman_region32_t *damage) {
+	struct wlr_scene_output *scene_output;
+	wl_list_for_each(scene_output, &scene->outputs, link) {
+		if (scene_output->blur_cache == NULL) {
+			continue;
+		}
+
+		pixman_region32_t output_damage;
+		pixman_region32_init(&output_damage);
+		pixman_region32_copy(&output_damage, damage);
+		pixman_region32_translate(&output_damage,
+			-scene_output->x, -scene_output->y);
+		scale_region(&output_damage, scene_output->output->scale, true);
+		output_to_buffer_coords(&output_damage, scene_output->output);
+		scene_output_blur_damage(scene_output, &output_damage);
+		pixman_region32_fini(&output_damage);
+	}
+}
+
 static void update_node_update_outputs(struct wlr_scene_node *node,
 		struct wl_list *outputs, struct wlr_scene_output *ignore,
 		struct wlr_scene_output *force) {
@@ -613,7 +796,14 @@ static void update_node_update_outputs(struct wlr_scene_node *node,
 
 	if (!scene_buffer->primary_output) {
 		// When no output contains a big enough fraction of the buffer, it means
-		// the primary output has been disconnected or we are exiting.
+		// the buffer got hidden, the primary output has been disconnected or
+		// we are exiting. The active outputs are kept so that showing the
+		// buffer again on the same outputs doesn't send leave and enter
+		// events, listeners are only told that it isn't visible anymore.
+		if (old_primary_output) {
+			struct wlr_scene_outputs_update_event event = {0};
+			wl_signal_emit_mutable(&scene_buffer->events.outputs_update, &event);
+		}
 		return;
 	}
 
@@ -723,6 +913,23 @@ static bool scene_node_get_background(struct wlr_scene_node *node) {
 	return false;
 }
 
+static bool scene_node_is_blur_source(struct wlr_scene_node *node) {
+	struct wlr_scene_tree *tree;
+	if (node->type == WLR_SCENE_NODE_TREE) {
+		tree = wlr_scene_tree_from_node(node);
+	} else {
+		tree = node->parent;
+	}
+
+	while (tree != NULL) {
+		if (tree->node.info.blur_source) {
+			return true;
+		}
+		tree = tree->node.parent;
+	}
+	return false;
+}
+
 struct wlr_box *wlr_scene_node_info_get_workspace_box(struct wlr_scene_node *node) {
 	struct wlr_scene_tree *tree;
 	if (node->type == WLR_SCENE_NODE_TREE) {
@@ -785,19 +992,39 @@ static bool scene_node_update_iterator(struct wlr_scene_node *node,
 		.height = round(ly + height) - round(ly)
 	};
 
+	struct wlr_scene_workspace_data workspace;
+	bool scaled = data->overview && scene_cbs.workspace_data(node, &workspace) &&
+		workspace.scale > 0.0;
+
 	pixman_region32_subtract(&node->visible, &node->visible, data->update_region);
-	pixman_region32_union(&node->visible, &node->visible, data->visible);
+	if (scaled) {
+		// Only what is left uncovered inside the "mini-workspace" can be
+		// visible, so clip against it before mapping back to the scene
+		pixman_region32_t visible;
+		pixman_region32_init(&visible);
+		pixman_region32_intersect_rect(&visible, data->visible,
+			workspace.output_x + workspace.x, workspace.output_y + workspace.y,
+			workspace.width, workspace.height);
+		workspace_region_to_scene(&visible, &workspace);
+		pixman_region32_union(&node->visible, &node->visible, &visible);
+		pixman_region32_fini(&visible);
+	} else {
+		pixman_region32_union(&node->visible, &node->visible, data->visible);
+	}
 	pixman_region32_intersect_rect(&node->visible, &node->visible,
 		box.x, box.y, box.width, box.height);
 
 	scene_node_apply_tiling_visibility(node, data->outputs);
 	scene_node_apply_workspace_visibility(node);
 
-	if (data->calculate_visibility && !scene_cbs.overview_workspaces_enabled()) {
+	if (data->calculate_visibility) {
 		pixman_region32_t opaque;
 		pixman_region32_init(&opaque);
 		scene_node_opaque_region(node, box.x, box.y, &opaque);
 		pixman_region32_intersect(&opaque, &opaque, &node->visible);
+		if (scaled) {
+			workspace_region_from_scene(&opaque, &workspace, true);
+		}
 		pixman_region32_subtract(data->visible, data->visible, &opaque);
 		pixman_region32_fini(&opaque);
 	}
@@ -827,6 +1054,21 @@ static void scene_node_visibility(struct wlr_scene_node *node,
 		return;
 	}
 
+	struct wlr_scene_workspace_data workspace;
+	if (scene_cbs.overview_workspaces_enabled() &&
+			scene_cbs.workspace_data(node, &workspace) && workspace.scale > 0.0) {
+		// Use where the node is displayed in workspaces overview. Rendering
+		// rounds the scaled boxes up, so add one pixel of slack.
+		pixman_region32_t displayed;
+		pixman_region32_init(&displayed);
+		pixman_region32_copy(&displayed, &node->visible);
+		workspace_region_from_scene(&displayed, &workspace, false);
+		wlr_region_expand(&displayed, &displayed, 1);
+		pixman_region32_union(visible, visible, &displayed);
+		pixman_region32_fini(&displayed);
+		return;
+	}
+
 	pixman_region32_union(visible, visible, &node->visible);
 }
 
@@ -852,7 +1094,27 @@ static void scene_node_bounds(struct wlr_scene_node *node,
 }
 
 static void scene_update_region(struct wlr_scene *scene,
-		const pixman_region32_t *update_region) {
+		const pixman_region32_t *_update_region) {
+	bool overview = scene->calculate_visibility &&
+		scene_cbs.overview_workspaces_enabled();
+
+	pixman_region32_t update;
+	pixman_region32_init(&update);
+	pixman_region32_copy(&update, _update_region);
+	if (overview) {
+		// In workspaces overview, nodes are displayed far from their scene
+		// position, so a change may uncover or occlude nodes anywhere on the
+		// outputs. Update all of them.
+		struct wlr_scene_output *scene_output;
+		wl_list_for_each(scene_output, &scene->outputs, link) {
+			int width, height;
+			wlr_output_effective_resolution(scene_output->output, &width, &height);
+			pixman_region32_union_rect(&update, &update,
+				scene_output->x, scene_output->y, width, height);
+		}
+	}
+	const pixman_region32_t *update_region = &update;
+
 	pixman_region32_t visible;
 	pixman_region32_init(&visible);
 	pixman_region32_copy(&visible, update_region);
@@ -870,12 +1132,14 @@ static void scene_update_region(struct wlr_scene *scene,
 		.outputs = &scene->outputs,
 		.calculate_visibility = scene->calculate_visibility,
 		.restack_xwayland_surfaces = scene->restack_xwayland_surfaces,
+		.overview = overview,
 	};
 
 	// update node visibility and output enter/leave events
 	scene_nodes_in_box(&scene->tree.node, &data.update_box, scene_node_update_iterator, &data);
 
 	pixman_region32_fini(&visible);
+	pixman_region32_fini(&update);
 }
 
 static void scene_node_cleanup_when_disabled(struct wlr_scene_node *node,
@@ -955,6 +1219,10 @@ static void scene_node_update(struct wlr_scene_node *node,
 	scene_node_bounds(node, x, y, &update_region);
 
 	scene_update_region(scene, &update_region);
+	if (scene->blur_passes > 0 && scene_node_is_blur_source(node)) {
+		// The damage is culled by what's visible, but blur reaches behind
+		scene_damage_blur_sources(scene, &update_region);
+	}
 	pixman_region32_fini(&update_region);
 
 	scene_node_visibility(node, damage);
@@ -962,6 +1230,10 @@ static void scene_node_update(struct wlr_scene_node *node,
 	pixman_region32_fini(damage);
 }
 
+void wlr_scene_update_visibility(struct wlr_scene *scene) {
+	scene_node_update(&scene->tree.node, NULL);
+}
+
 struct wlr_scene_rect *wlr_scene_rect_create(struct wlr_scene_tree *parent,
 		double width, double height, const float color[static 4]) {
 	assert(parent);
@@ -1276,6 +1548,7 @@ struct wlr_scene_buffer *wlr_scene_buffer_create(struct wlr_scene_tree *parent,
 	wl_signal_init(&scene_buffer->events.frame_done);
 
 	pixman_region32_init(&scene_buffer->opaque_region);
+	pixman_region32_init(&scene_buffer->blur_region);
 	wl_list_init(&scene_buffer->buffer_release.link);
 	wl_list_init(&scene_buffer->renderer_destroy.link);
 	scene_buffer->opacity = 1;
@@ -1354,6 +1627,22 @@ void wlr_scene_buffer_set_buffer_with_options(struct wlr_scene_buffer *scene_buf
 		return;
 	}
 
+	// In workspaces overview, damage where the buffer is displayed
+	double workspace_scale = 1.0;
+	pixman_region32_t visible;
+	pixman_region32_init(&visible);
+	pixman_region32_copy(&visible, &scene_buffer->node.visible);
+	struct wlr_scene_workspace_data workspace;
+	if (scene_cbs.overview_workspaces_enabled() &&
+			scene_cbs.workspace_data(&scene_buffer->node, &workspace) &&
+			workspace.scale > 0.0) {
+		workspace_scale = workspace.scale;
+		lx = workspace.output_x + workspace.x + (lx - workspace.output_x) * workspace.scale;
+		ly = workspace.output_y + workspace.y + (ly - workspace.output_y) * workspace.scale;
+		workspace_region_from_scene(&visible, &workspace, false);
+		wlr_region_expand(&visible, &visible, 1);
+	}
+
 	pixman_region32_t fallback_damage;
 	pixman_region32_init_rect(&fallback_damage, 0, 0, buffer->width, buffer->height);
 	const pixman_region32_t *damage = options->damage;
@@ -1390,11 +1679,13 @@ void wlr_scene_buffer_set_buffer_with_options(struct wlr_scene_buffer *scene_buf
 	pixman_region32_translate(&trans_damage, -box.x, -box.y);
 
 	struct wlr_scene *scene = scene_node_get_root(&scene_buffer->node);
+	bool blur_source = scene->blur_passes > 0 &&
+		scene_node_is_blur_source(&scene_buffer->node);
 	struct wlr_scene_output *scene_output;
 	wl_list_for_each(scene_output, &scene->outputs, link) {
 		double output_scale = scene_output->output->scale;
-		double output_scale_x = output_scale * scale_x;
-		double output_scale_y = output_scale * scale_y;
+		double output_scale_x = output_scale * scale_x * workspace_scale;
+		double output_scale_y = output_scale * scale_y * workspace_scale;
 		pixman_region32_t output_damage;
 		pixman_region32_init(&output_damage);
 		wlr_region_scale_xy(&output_damage, &trans_damage,
@@ -1419,9 +1710,21 @@ void wlr_scene_buffer_set_buffer_with_options(struct wlr_scene_buffer *scene_buf
 		wlr_region_expand(&output_damage, &output_damage,
 			dist_x >= dist_y ? dist_x : dist_y);
 
+		if (blur_source && scene_output->blur_cache != NULL) {
+			pixman_region32_t blur_damage;
+			pixman_region32_init(&blur_damage);
+			pixman_region32_copy(&blur_damage, &output_damage);
+			pixman_region32_translate(&blur_damage,
+				round((lx - scene_output->x) * output_scale),
+				round((ly - scene_output->y) * output_scale));
+			output_to_buffer_coords(&blur_damage, scene_output->output);
+			scene_output_blur_damage(scene_output, &blur_damage);
+			pixman_region32_fini(&blur_damage);
+		}
+
 		pixman_region32_t cull_region;
 		pixman_region32_init(&cull_region);
-		pixman_region32_copy(&cull_region, &scene_buffer->node.visible);
+		pixman_region32_copy(&cull_region, &visible);
 		scale_region(&cull_region, output_scale, true);
 		pixman_region32_translate(&cull_region, -lx * output_scale, -ly * output_scale);
 		pixman_region32_intersect(&output_damage, &output_damage, &cull_region);
@@ -1437,6 +1740,7 @@ void wlr_scene_buffer_set_buffer_with_options(struct wlr_scene_buffer *scene_buf
 
 	pixman_region32_fini(&trans_damage);
 	pixman_region32_fini(&fallback_damage);
+	pixman_region32_fini(&visible);
 }
 
 void wlr_scene_buffer_set_buffer_with_damage(struct wlr_scene_buffer *scene_buffer,
@@ -1472,6 +1776,16 @@ void wlr_scene_buffer_set_opaque_region(struct wlr_scene_buffer *scene_buffer,
 	pixman_region32_fini(&update_region);
 }
 
+void wlr_scene_buffer_set_blur_region(struct wlr_scene_buffer *scene_buffer,
+		const pixman_region32_t *region) {
+	if (pixman_region32_equal(&scene_buffer->blur_region, region)) {
+		return;
+	}
+
+	pixman_region32_copy(&scene_buffer->blur_region, region);
+	scene_node_update(&scene_buffer->node, NULL);
+}
+
 void wlr_scene_buffer_set_source_box(struct wlr_scene_buffer *scene_buffer,
 		const struct wlr_fbox *box) {
 	if (wlr_fbox_equal(&scene_buffer->src_box, box)) {
@@ -1909,6 +2223,54 @@ static float get_luminance_multiplier(const struct wlr_color_luminances *src_lum
 	return (dst_lum->reference / src_lum->reference) * (src_lum->max / dst_lum->max);
 }
 
+// Computes the visible part of the blur region of a buffer entry, in buffer
+// coordinates
+static void scene_entry_blur_region(struct render_list_entry *entry,
+		const struct render_data *data, pixman_region32_t *region) {
+	struct wlr_scene_node *node = entry->node;
+	struct wlr_scene_buffer *scene_buffer = wlr_scene_buffer_from_node(node);
+
+	pixman_region32_copy(region, &scene_buffer->blur_region);
+	pixman_region32_translate(region, floor(entry->x), floor(entry->y));
+	pixman_region32_intersect(region, region, &node->visible);
+	pixman_region32_translate(region, -data->logical.x, -data->logical.y);
+
+	struct wlr_scene_workspace_data workspace_data;
+	if (scene_cbs.workspace_data(node, &workspace_data)) {
+		scale_region(region, workspace_data.scale, false);
+		pixman_region32_translate(region, workspace_data.x, workspace_data.y);
+		pixman_region32_intersect_rect(region, region, workspace_data.x, workspace_data.y,
+			workspace_data.width, workspace_data.height);
+	}
+	logical_to_buffer_coords(region, data, false);
+}
+
+// Draws the blurred blur sources behind the blur region of a buffer
+static void scene_entry_render_blur(struct render_list_entry *entry,
+		const pixman_region32_t *render_region, const struct render_data *data) {
+	struct wlr_scene_buffer *scene_buffer = wlr_scene_buffer_from_node(entry->node);
+	struct scene_blur *blur = data->output->blur_cache;
+	if (data->blur_source || blur == NULL ||
+			pixman_region32_empty(&scene_buffer->blur_region)) {
+		return;
+	}
+
+	pixman_region32_t region;
+	pixman_region32_init(&region);
+	scene_entry_blur_region(entry, data, &region);
+	pixman_region32_intersect(&region, &region, render_region);
+	if (!pixman_region32_empty(&region)) {
+		struct wlr_texture *texture = scene_blur_get_texture(blur);
+		wlr_render_pass_add_texture(data->render_pass, &(struct wlr_render_texture_options){
+			.texture = texture,
+			.dst_box = { .width = texture->width, .height = texture->height },
+			.clip = &region,
+			.blend_mode = WLR_RENDER_BLEND_MODE_NONE,
+		});
+	}
+	pixman_region32_fini(&region);
+}
+
 static void scene_entry_render(struct render_list_entry *entry, const struct render_data *data) {
 	struct wlr_scene_node *node = entry->node;
 
@@ -1920,7 +2282,12 @@ static void scene_entry_render(struct render_list_entry *entry, const struct ren
 
 	pixman_region32_t render_region;
 	pixman_region32_init(&render_region);
-	pixman_region32_copy(&render_region, &node->visible);
+	if (data->blur_source) {
+		// Blur reaches behind the nodes above, so render all of it
+		scene_node_bounds(node, entry->x, entry->y, &render_region);
+	} else {
+		pixman_region32_copy(&render_region, &node->visible);
+	}
 	pixman_region32_translate(&render_region, -data->logical.x, -data->logical.y);
 	if (workspace) {
 		scale_region(&render_region, scale, false);
@@ -1991,6 +2358,8 @@ static void scene_entry_render(struct render_list_entry *entry, const struct ren
 	case WLR_SCENE_NODE_BUFFER:;
 		struct wlr_scene_buffer *scene_buffer = wlr_scene_buffer_from_node(node);
 
+		scene_entry_render_blur(entry, &render_region, data);
+
 		if (scene_buffer->is_single_pixel_buffer) {
 			// Render the buffer as a rect, this is likely to be more efficient
 			wlr_render_pass_add_rect(data->render_pass, &(struct wlr_render_rect_options){
@@ -2057,6 +2426,10 @@ static void scene_entry_render(struct render_list_entry *entry, const struct ren
 			.wait_point = scene_buffer->wait_point,
 		});
 
+		if (data->blur_source) {
+			break;
+		}
+
 		struct wlr_scene_output_sample_event sample_event = {
 			.output = data->output,
 			.direct_scanout = false,
@@ -2241,6 +2614,23 @@ static void scene_handle_color_manager_v1_destroy(struct wl_listener *listener,
 	scene->color_manager_v1 = NULL;
 }
 
+void wlr_scene_set_blur_passes(struct wlr_scene *scene, int passes) {
+	if (passes < 0) {
+		passes = 0;
+	} else if (passes > SCENE_BLUR_MAX_PASSES) {
+		passes = SCENE_BLUR_MAX_PASSES;
+	}
+	if (scene->blur_passes == passes) {
+		return;
+	}
+
+	scene->blur_passes = passes;
+	struct wlr_scene_output *scene_output;
+	wl_list_for_each(scene_output, &scene->outputs, link) {
+		scene_output_damage_whole(scene_output);
+	}
+}
+
 void wlr_scene_set_color_manager_v1(struct wlr_scene *scene, struct wlr_color_manager_v1 *manager) {
 	assert(scene->color_manager_v1 == NULL);
 	scene->color_manager_v1 = manager;
@@ -2361,7 +2751,9 @@ struct wlr_scene_output *wlr_scene_output_create(struct wlr_scene *scene,
 	wlr_addon_init(&scene_output->addon, &output->addons, scene, &output_addon_impl);
 
 	wlr_damage_ring_init(&scene_output->damage_ring);
+	scene_output->scanout.status = WLR_SCENE_SCANOUT_EMPTY;
 	pixman_region32_init(&scene_output->pending_commit_damage);
+	pixman_region32_init(&scene_output->blur_stale);
 	wl_list_init(&scene_output->damage_highlight_regions);
 
 	int prev_output_index = -1;
@@ -2452,6 +2844,9 @@ void wlr_scene_output_destroy(struct wlr_scene_output *scene_output) {
 	wlr_color_transform_unref(scene_output->prev_supplied_color_transform);
 	wlr_color_transform_unref(scene_output->combined_color_transform);
 	wl_array_release(&scene_output->render_list);
+	scene_blur_destroy(scene_output->blur_cache);
+	pixman_region32_fini(&scene_output->blur_stale);
+	wl_array_release(&scene_output->blur_sources);
 	free(scene_output);
 }
 
@@ -2595,6 +2990,173 @@ static bool construct_render_list_iterator(struct wlr_scene_node *node,
 	return false;
 }
 
+static void scene_output_blur_finish(struct wlr_scene_output *scene_output) {
+	scene_blur_destroy(scene_output->blur_cache);
+	scene_output->blur_cache = NULL;
+	pixman_region32_clear(&scene_output->blur_stale);
+	scene_output->blur_sources.size = 0;
+}
+
+// Renders the blur sources to the blur cache and blurs them within the region
+static bool scene_output_render_blur(struct wlr_scene_output *scene_output,
+		const struct render_data *render_data, struct render_list_entry *list_data,
+		int list_len, const pixman_region32_t *region) {
+	struct scene_blur *blur = scene_output->blur_cache;
+	struct wlr_buffer *buffer = scene_blur_get_source(blur);
+	struct wlr_render_pass *render_pass = wlr_renderer_begin_buffer_pass(
+		scene_output->output->renderer, buffer, NULL);
+	if (render_pass == NULL) {
+		return false;
+	}
+
+	struct render_data source_data = *render_data;
+	source_data.render_pass = render_pass;
+	source_data.blur_source = true;
+	pixman_region32_init(&source_data.damage);
+	wlr_region_expand(&source_data.damage, region,
+		scene_blur_radius(scene_output->scene->blur_passes));
+	pixman_region32_intersect_rect(&source_data.damage, &source_data.damage,
+		0, 0, buffer->width, buffer->height);
+
+	wlr_render_pass_add_rect(render_pass, &(struct wlr_render_rect_options){
+		.box = { .width = buffer->width, .height = buffer->height },
+		.color = { .r = 0, .g = 0, .b = 0, .a = 1 },
+		.clip = &source_data.damage,
+	});
+	for (int i = list_len - 1; i >= 0; i--) {
+		struct render_list_entry *entry = &list_data[i];
+		if (scene_node_is_blur_source(entry->node)) {
+			scene_entry_render(entry, &source_data);
+		}
+	}
+	pixman_region32_fini(&source_data.damage);
+
+	return wlr_render_pass_submit(render_pass) && scene_blur_render(blur, region);
+}
+
+/**
+ * Brings the blur cache up to date where the blur regions of the frame need
+ * it. The blurred sources are only rendered again where they changed since
+ * the last time, or where they were never needed before.
+ */
+static void scene_output_update_blur(struct wlr_scene_output *scene_output,
+		const struct render_data *render_data, struct render_list_entry *list_data,
+		int list_len, int width, int height) {
+	int passes = scene_output->scene->blur_passes;
+	if (passes == 0) {
+		if (scene_output->blur_cache != NULL) {
+			scene_output_blur_finish(scene_output);
+		}
+		return;
+	}
+
+	pixman_region32_t needed;
+	pixman_region32_init(&needed);
+	for (int i = 0; i < list_len; i++) {
+		struct render_list_entry *entry = &list_data[i];
+		if (entry->node->type != WLR_SCENE_NODE_BUFFER ||
+				pixman_region32_empty(&wlr_scene_buffer_from_node(entry->node)->blur_region)) {
+			continue;
+		}
+
+		pixman_region32_t region;
+		pixman_region32_init(&region);
+		scene_entry_blur_region(entry, render_data, &region);
+		pixman_region32_union(&needed, &needed, &region);
+		pixman_region32_fini(&region);
+	}
+	if (pixman_region32_empty(&needed)) {
+		pixman_region32_fini(&needed);
+		return;
+	}
+
+	if (scene_output->blur_cache != NULL &&
+			(!scene_blur_matches(scene_output->blur_cache, width, height, passes) ||
+			scene_output->blur_scale != render_data->scale ||
+			scene_output->blur_transform != render_data->transform)) {
+		scene_output_blur_finish(scene_output);
+	}
+	if (scene_output->blur_cache == NULL) {
+		scene_output->blur_cache = scene_blur_create(scene_output->output,
+			width, height, passes);
+		if (scene_output->blur_cache == NULL) {
+			pixman_region32_fini(&needed);
+			return;
+		}
+		scene_output->blur_scale = render_data->scale;
+		scene_output->blur_transform = render_data->transform;
+		pixman_region32_union_rect(&scene_output->blur_stale,
+			&scene_output->blur_stale, 0, 0, width, height);
+	}
+
+	// Blur sources which moved, appeared or went away are stale where they
+	// were and where they are now
+	struct wl_array sources;
+	wl_array_init(&sources);
+	for (int i = 0; i < list_len; i++) {
+		struct render_list_entry *entry = &list_data[i];
+		if (!scene_node_is_blur_source(entry->node)) {
+			continue;
+		}
+
+		struct wlr_fbox fbox = {
+			.x = entry->x - render_data->logical.x,
+			.y = entry->y - render_data->logical.y,
+		};
+		scene_node_get_size(entry->node, &fbox.width, &fbox.height);
+		transform_output_box(&fbox, render_data);
+
+		struct wlr_box *box = wl_array_add(&sources, sizeof(*box));
+		if (box != NULL) {
+			*box = (struct wlr_box){
+				.x = floor(fbox.x),
+				.y = floor(fbox.y),
+				.width = ceil(fbox.x + fbox.width) - floor(fbox.x),
+				.height = ceil(fbox.y + fbox.height) - floor(fbox.y),
+			};
+		}
+	}
+	if (sources.size != scene_output->blur_sources.size || (sources.size > 0 &&
+			memcmp(sources.data, scene_output->blur_sources.data, sources.size) != 0)) {
+		pixman_region32_t moved;
+		pixman_region32_init(&moved);
+		struct wlr_box *box;
+		wl_array_for_each(box, &sources) {
+			pixman_region32_union_rect(&moved, &moved,
+				box->x, box->y, box->width, box->height);
+		}
+		wl_array_for_each(box, &scene_output->blur_sources) {
+			pixman_region32_union_rect(&moved, &moved,
+				box->x, box->y, box->width, box->height);
+		}
+		scene_output_blur_damage(scene_output, &moved);
+		pixman_region32_fini(&moved);
+	}
+	wl_array_release(&scene_output->blur_sources);
+	scene_output->blur_sources = sources;
+
+	pixman_region32_t refresh;
+	pixman_region32_init(&refresh);
+	pixman_region32_intersect(&refresh, &scene_output->blur_stale, &needed);
+	if (!pixman_region32_empty(&refresh)) {
+		if (scene_output_render_blur(scene_output, render_data,
+				list_data, list_len, &refresh)) {
+			pixman_region32_subtract(&scene_output->blur_stale,
+				&scene_output->blur_stale, &refresh);
+			scene_output->blur.refreshes++;
+			scene_output->blur.area += region_area(&refresh);
+
+			// What's drawn behind the blur regions changed
+			scene_output_damage(scene_output, &refresh);
+		} else {
+			wlr_log(WLR_ERROR, "Failed to render the blur cache");
+			scene_output_blur_finish(scene_output);
+		}
+	}
+	pixman_region32_fini(&refresh);
+	pixman_region32_fini(&needed);
+}
+
 static void scene_buffer_send_dmabuf_feedback(const struct wlr_scene *scene,
 		struct wlr_scene_buffer *scene_buffer,
 		const struct wlr_linux_dmabuf_feedback_v1_init_options *options) {
@@ -2670,19 +3232,24 @@ enum scene_direct_scanout_result {
 
 static enum scene_direct_scanout_result scene_entry_try_direct_scanout(
 		struct render_list_entry *entry, struct wlr_output_state *state,
-		const struct render_data *data) {
+		const struct render_data *data, enum wlr_scene_scanout_status *status) {
 	struct wlr_scene_output *scene_output = data->output;
 	struct wlr_scene_node *node = entry->node;
 
 	if (scene_cbs.fullscreen_global_enabled()) {
+		*status = WLR_SCENE_SCANOUT_FULLSCREEN_GLOBAL;
 		return SCANOUT_INELIGIBLE;
 	}
 
 	if (!scene_output->scene->direct_scanout) {
+		*status = WLR_SCENE_SCANOUT_DISABLED;
 		return SCANOUT_INELIGIBLE;
 	}
 
 	if (node->type != WLR_SCENE_NODE_BUFFER) {
+		*status = node->type == WLR_SCENE_NODE_DECORATION ||
+			node->type == WLR_SCENE_NODE_SHADOW ?
+			WLR_SCENE_SCANOUT_DECORATION : WLR_SCENE_SCANOUT_NOT_BUFFER;
 		return SCANOUT_INELIGIBLE;
 	}
 
@@ -2690,15 +3257,24 @@ static enum scene_direct_scanout_result scene_entry_try_direct_scanout(
 			WLR_OUTPUT_STATE_ENABLED |
 			WLR_OUTPUT_STATE_RENDER_FORMAT)) {
 		// Legacy DRM will explode if we try to modeset with a direct scanout buffer
+		*status = WLR_SCENE_SCANOUT_MODESET;
 		return SCANOUT_INELIGIBLE;
 	}
 
 	if (!wlr_output_is_direct_scanout_allowed(scene_output->output)) {
+		*status = WLR_SCENE_SCANOUT_NOT_ALLOWED;
 		return SCANOUT_INELIGIBLE;
 	}
 
 	struct wlr_scene_buffer *buffer = wlr_scene_buffer_from_node(node);
 	if (buffer->buffer == NULL) {
+		*status = WLR_SCENE_SCANOUT_NO_BUFFER;
+		return SCANOUT_INELIGIBLE;
+	}
+
+	// The display would show the buffer as is, without blending it
+	if (buffer->opacity != 1) {
+		*status = WLR_SCENE_SCANOUT_TRANSLUCENT;
 		return SCANOUT_INELIGIBLE;
 	}
 
@@ -2712,11 +3288,13 @@ static enum scene_direct_scanout_result scene_entry_try_direct_scanout(
 	};
 
 	if (buffer->transform != data->transform) {
+		*status = WLR_SCENE_SCANOUT_TRANSFORM;
 		return SCANOUT_INELIGIBLE;
 	}
 
 	const struct wlr_output_image_description *img_desc = output_pending_image_description(scene_output->output, state);
 	if (!color_management_is_scanout_allowed(img_desc, buffer)) {
+		*status = WLR_SCENE_SCANOUT_COLORIMETRY;
 		return SCANOUT_INELIGIBLE;
 	}
 
@@ -2736,6 +3314,7 @@ static enum scene_direct_scanout_result scene_entry_try_direct_scanout(
 	struct wlr_output_state pending;
 	wlr_output_state_init(&pending);
 	if (!wlr_output_state_copy(&pending, state)) {
+		*status = WLR_SCENE_SCANOUT_TEST_FAILED;
 		return SCANOUT_CANDIDATE;
 	}
 
@@ -2784,6 +3363,12 @@ static enum scene_direct_scanout_result scene_entry_try_direct_scanout(
 	}
 
 	if (!wlr_output_test_state(scene_output->output, &pending)) {
+		// Tell apart buffers that need to be scaled or cropped by the display
+		// engine from other failures (format, modifier, planes)
+		bool scaled = pending.buffer_dst_box.width != wlr_buffer->width ||
+			pending.buffer_dst_box.height != wlr_buffer->height ||
+			!wlr_fbox_empty(&pending.buffer_src_box);
+		*status = scaled ? WLR_SCENE_SCANOUT_SCALE : WLR_SCENE_SCANOUT_TEST_FAILED;
 		wlr_output_state_finish(&pending);
 		return SCANOUT_CANDIDATE;
 	}
@@ -2798,9 +3383,50 @@ static enum scene_direct_scanout_result scene_entry_try_direct_scanout(
 		.release_point = data->output->out_point,
 	};
 	wl_signal_emit_mutable(&buffer->events.output_sample, &sample_event);
+	*status = WLR_SCENE_SCANOUT_SUCCESS;
 	return SCANOUT_SUCCESS;
 }
 
+const char *wlr_scene_scanout_status_name(enum wlr_scene_scanout_status status) {
+	switch (status) {
+	case WLR_SCENE_SCANOUT_SUCCESS:
+		return "success";
+	case WLR_SCENE_SCANOUT_DISABLED:
+		return "disabled";
+	case WLR_SCENE_SCANOUT_NOT_ALLOWED:
+		return "not_allowed";
+	case WLR_SCENE_SCANOUT_FULLSCREEN_GLOBAL:
+		return "fullscreen_global";
+	case WLR_SCENE_SCANOUT_EMPTY:
+		return "empty";
+	case WLR_SCENE_SCANOUT_MULTIPLE_ENTRIES:
+		return "multiple_entries";
+	case WLR_SCENE_SCANOUT_DECORATION:
+		return "decoration";
+	case WLR_SCENE_SCANOUT_NOT_BUFFER:
+		return "not_buffer";
+	case WLR_SCENE_SCANOUT_COLOR_TRANSFORM:
+		return "color_transform";
+	case WLR_SCENE_SCANOUT_DAMAGE_HIGHLIGHT:
+		return "damage_highlight";
+	case WLR_SCENE_SCANOUT_MODESET:
+		return "modeset";
+	case WLR_SCENE_SCANOUT_NO_BUFFER:
+		return "no_buffer";
+	case WLR_SCENE_SCANOUT_TRANSLUCENT:
+		return "translucent";
+	case WLR_SCENE_SCANOUT_TRANSFORM:
+		return "transform";
+	case WLR_SCENE_SCANOUT_COLORIMETRY:
+		return "colorimetry";
+	case WLR_SCENE_SCANOUT_SCALE:
+		return "scale";
+	case WLR_SCENE_SCANOUT_TEST_FAILED:
+		return "test_failed";
+	}
+	return "unknown";
+}
+
 bool wlr_scene_output_needs_frame(struct wlr_scene_output *scene_output) {
 	return scene_output->output->needs_frame ||
 		!pixman_region32_empty(&scene_output->pending_commit_damage) ||
@@ -2965,10 +3591,6 @@ bool wlr_scene_output_build_state(struct wlr_scene_output *scene_output,
 			render_gamma_lut = true;
 		}
 	}
-	if (scene_cbs.overview_workspaces_enabled()) {
-		scene_output_damage_whole(scene_output);
-	}
-
 	struct render_data render_data = {
 		.transform = output->transform,
 		.scale = output->scale,
@@ -3062,6 +3684,9 @@ bool wlr_scene_output_build_state(struct wlr_scene_output *scene_output,
 		pixman_region32_fini(&acc_damage);
 	}
 
+	scene_output_update_blur(scene_output, &render_data, list_data, list_len,
+		resolution_width, resolution_height);
+
 	wlr_output_state_set_damage(state, &scene_output->pending_commit_damage);
 
 	// We only want to try direct scanout if:
@@ -3069,9 +3694,32 @@ bool wlr_scene_output_build_state(struct wlr_scene_output *scene_output,
 	// - There are no color transforms that need to be applied
 	// - Damage highlight debugging is not enabled
 	enum scene_direct_scanout_result scanout_result = SCANOUT_INELIGIBLE;
-	if (options->color_transform == NULL && !render_gamma_lut && list_len == 1
-			&& debug_damage != WLR_SCENE_DEBUG_DAMAGE_HIGHLIGHT) {
-		scanout_result = scene_entry_try_direct_scanout(&list_data[0], state, &render_data);
+	enum wlr_scene_scanout_status scanout_status = WLR_SCENE_SCANOUT_EMPTY;
+	if (options->color_transform != NULL || render_gamma_lut) {
+		scanout_status = WLR_SCENE_SCANOUT_COLOR_TRANSFORM;
+	} else if (debug_damage == WLR_SCENE_DEBUG_DAMAGE_HIGHLIGHT) {
+		scanout_status = WLR_SCENE_SCANOUT_DAMAGE_HIGHLIGHT;
+	} else if (list_len == 0) {
+		scanout_status = WLR_SCENE_SCANOUT_EMPTY;
+	} else if (list_len > 1) {
+		scanout_status = WLR_SCENE_SCANOUT_MULTIPLE_ENTRIES;
+		for (int i = 0; i < list_len; i++) {
+			enum wlr_scene_node_type type = list_data[i].node->type;
+			if (type == WLR_SCENE_NODE_DECORATION || type == WLR_SCENE_NODE_SHADOW) {
+				scanout_status = WLR_SCENE_SCANOUT_DECORATION;
+				break;
+			}
+		}
+	} else {
+		scanout_result = scene_entry_try_direct_scanout(&list_data[0], state,
+			&render_data, &scanout_status);
+	}
+	scene_output->scanout.frames++;
+	scene_output->last_frame.entries = list_len;
+	scene_output->last_frame.damage_area =
+		region_area(&scene_output->pending_commit_damage);
+	if (scanout_result == SCANOUT_SUCCESS) {
+		scene_output->scanout.scanout_frames++;
 	}
 
 	if (scanout_result == SCANOUT_INELIGIBLE) {
@@ -3088,9 +3736,11 @@ bool wlr_scene_output_build_state(struct wlr_scene_output *scene_output,
 	bool scanout = scanout_result == SCANOUT_SUCCESS;
 	if (scene_output->prev_scanout != scanout) {
 		scene_output->prev_scanout = scanout;
-		wlr_log(WLR_DEBUG, "Direct scan-out %s",
-			scanout ? "enabled" : "disabled");
+		wlr_log(WLR_DEBUG, "Direct scan-out %s (%s)",
+			scanout ? "enabled" : "disabled",
+			wlr_scene_scanout_status_name(scanout_status));
 	}
+	scene_output->scanout.status = scanout_status;
 
 	if (scanout) {
 		scene_output_state_attempt_gamma(scene_output, state);
@@ -389,8 +389,9 @@ static void session_destroy(struct wlr_ext_image_copy_capture_session_v1 *sessio
 			EXT_IMAGE_COPY_CAPTURE_FRAME_V1_FAILURE_REASON_STOPPED);
 	}
 
-	if (session->source->impl->stop) {
-		session->source->impl->stop(session->source);
+	struct wlr_ext_image_capture_source_v1 *source = session->source;
+	if (source->impl->stop) {
+		source->impl->stop(source);
 	}
 
 	ext_image_copy_capture_session_v1_send_stopped(session->resource);
@@ -404,6 +405,10 @@ static void session_destroy(struct wlr_ext_image_copy_capture_session_v1 *sessio
 	assert(wl_list_empty(&session->events.destroy.listener_list));
 
 	free(session);
+
+	assert(source->num_sessions > 0);
+	source->num_sessions--;
+	wlr_ext_image_capture_source_v1_check_unused(source);
 }
 
 static void session_handle_source_destroy(struct wl_listener *listener, void *data) {
@@ -469,6 +474,7 @@ static void session_create(struct wl_resource *parent_resource, uint32_t new_id,
 
 	session->resource = session_resource;
 	session->source = source;
+	source->num_sessions++;
 	pixman_region32_init_rect(&session->damage, 0, 0, source->width,
 			source->height);
 
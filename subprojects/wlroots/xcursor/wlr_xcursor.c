@@ -181,12 +181,11 @@ static struct wlr_xcursor *xcursor_create_from_xcursor_images(
 static struct wlr_xcursor *xcursor_theme_get_cursor(struct wlr_xcursor_theme *theme,
 	const char *name);
 
-static void load_callback(struct xcursor_images *images, void *data) {
-	struct wlr_xcursor_theme *theme = data;
-
+static struct wlr_xcursor *theme_add_cursor(struct wlr_xcursor_theme *theme,
+		struct xcursor_images *images) {
 	if (xcursor_theme_get_cursor(theme, images->name)) {
 		xcursor_images_destroy(images);
-		return;
+		return NULL;
 	}
 
 	struct wlr_xcursor *cursor = xcursor_create_from_xcursor_images(images, theme);
@@ -197,6 +196,7 @@ static void load_callback(struct xcursor_images *images, void *data) {
 		if (cursors == NULL) {
 			theme->cursor_count--;
 			xcursor_destroy(cursor);
+			cursor = NULL;
 		} else {
 			theme->cursors = cursors;
 			theme->cursors[theme->cursor_count - 1] = cursor;
@@ -204,9 +204,15 @@ static void load_callback(struct xcursor_images *images, void *data) {
 	}
 
 	xcursor_images_destroy(images);
+	return cursor;
 }
 
-struct wlr_xcursor_theme *wlr_xcursor_theme_load(const char *name, int size) {
+static void load_callback(struct xcursor_images *images, void *data) {
+	struct wlr_xcursor_theme *theme = data;
+	theme_add_cursor(theme, images);
+}
+
+static struct wlr_xcursor_theme *theme_create(const char *name, int size) {
 	struct wlr_xcursor_theme *theme = calloc(1, sizeof(*theme));
 	if (!theme) {
 		return NULL;
@@ -218,13 +224,22 @@ struct wlr_xcursor_theme *wlr_xcursor_theme_load(const char *name, int size) {
 
 	theme->name = strdup(name);
 	if (!theme->name) {
-		goto out_error_name;
+		free(theme);
+		return NULL;
 	}
 	theme->size = size;
 	theme->cursor_count = 0;
 	theme->cursors = NULL;
+	return theme;
+}
+
+struct wlr_xcursor_theme *wlr_xcursor_theme_load(const char *name, int size) {
+	struct wlr_xcursor_theme *theme = theme_create(name, size);
+	if (!theme) {
+		return NULL;
+	}
 
-	xcursor_load_theme(name, size, load_callback, theme);
+	xcursor_load_theme(theme->name, size, load_callback, theme);
 
 	if (theme->cursor_count == 0) {
 		load_default_theme(theme);
@@ -234,10 +249,32 @@ struct wlr_xcursor_theme *wlr_xcursor_theme_load(const char *name, int size) {
 			theme->name, size, theme->cursor_count);
 
 	return theme;
+}
 
-out_error_name:
-	free(theme);
-	return NULL;
+struct wlr_xcursor_theme *wlr_xcursor_theme_load_lazy(const char *name, int size) {
+	struct wlr_xcursor_theme *theme = theme_create(name, size);
+	if (!theme) {
+		return NULL;
+	}
+	theme->lazy = true;
+
+	// Every compositor needs the default cursor, and the theme is useless
+	// without it
+	if (wlr_xcursor_theme_get_cursor(theme, "default") == NULL) {
+		theme->lazy = false;
+		for (size_t i = 0; i < theme->missing_len; i++) {
+			free(theme->missing[i]);
+		}
+		free(theme->missing);
+		theme->missing = NULL;
+		theme->missing_len = 0;
+		load_default_theme(theme);
+	}
+
+	wlr_log(WLR_DEBUG, "Opened cursor theme '%s' at size %d%s",
+			theme->name, size, theme->lazy ? "" : " (built-in fallback)");
+
+	return theme;
 }
 
 void wlr_xcursor_theme_destroy(struct wlr_xcursor_theme *theme) {
@@ -248,7 +285,11 @@ void wlr_xcursor_theme_destroy(struct wlr_xcursor_theme *theme) {
 	for (unsigned int i = 0; i < theme->cursor_count; i++) {
 		xcursor_destroy(theme->cursors[i]);
 	}
+	for (size_t i = 0; i < theme->missing_len; i++) {
+		free(theme->missing[i]);
+	}
 
+	free(theme->missing);
 	free(theme->name);
 	free(theme->cursors);
 	free(theme);
@@ -265,9 +306,42 @@ static struct wlr_xcursor *xcursor_theme_get_cursor(struct wlr_xcursor_theme *th
 	return NULL;
 }
 
-struct wlr_xcursor *wlr_xcursor_theme_get_cursor(struct wlr_xcursor_theme *theme,
+static struct wlr_xcursor *xcursor_theme_find_cursor(struct wlr_xcursor_theme *theme,
 		const char *name) {
 	struct wlr_xcursor *xcursor = xcursor_theme_get_cursor(theme, name);
+	if (xcursor || !theme->lazy) {
+		return xcursor;
+	}
+
+	// Remember missing cursors, looking them up hits the file system
+	for (size_t i = 0; i < theme->missing_len; i++) {
+		if (strcmp(name, theme->missing[i]) == 0) {
+			return NULL;
+		}
+	}
+
+	struct xcursor_images *images =
+		xcursor_load_theme_cursor(theme->name, name, theme->size);
+	if (images) {
+		return theme_add_cursor(theme, images);
+	}
+
+	char **missing = realloc(theme->missing,
+		(theme->missing_len + 1) * sizeof(theme->missing[0]));
+	if (missing == NULL) {
+		return NULL;
+	}
+	theme->missing = missing;
+	char *missing_name = strdup(name);
+	if (missing_name != NULL) {
+		theme->missing[theme->missing_len++] = missing_name;
+	}
+	return NULL;
+}
+
+struct wlr_xcursor *wlr_xcursor_theme_get_cursor(struct wlr_xcursor_theme *theme,
+		const char *name) {
+	struct wlr_xcursor *xcursor = xcursor_theme_find_cursor(theme, name);
 	if (xcursor) {
 		return xcursor;
 	}
@@ -303,7 +377,7 @@ struct wlr_xcursor *wlr_xcursor_theme_get_cursor(struct wlr_xcursor_theme *theme
 	} else {
 		return NULL;
 	}
-	return xcursor_theme_get_cursor(theme, fallback);
+	return xcursor_theme_find_cursor(theme, fallback);
 }
 
 static int xcursor_frame_and_duration(struct wlr_xcursor *cursor,
@@ -821,3 +821,94 @@ xcursor_load_theme(const char *theme, int size,
 		   void *user_data) {
 	return xcursor_load_theme_protected(theme, size, load_callback, user_data, NULL);
 }
+
+static struct xcursor_images *
+xcursor_load_cursor_protected(const char *theme, const char *name, int size,
+			      struct xcursor_nodelist *visited_nodes)
+{
+	char *full, *dir;
+	char *inherits = NULL;
+	const char *path, *i;
+	char *xcursor_path;
+	size_t si;
+	struct xcursor_nodelist current_node;
+	struct xcursor_images *images = NULL;
+	FILE *f;
+
+	if (!theme)
+		theme = "default";
+
+	current_node.next = visited_nodes;
+	current_node.node = theme;
+	current_node.nodelen = strlen(theme);
+	visited_nodes = &current_node;
+
+	xcursor_path = xcursor_library_path();
+	for (path = xcursor_path;
+	     path && !images;
+	     path = xcursor_next_path(path)) {
+		dir = xcursor_build_theme_dir(path, theme);
+		if (!dir)
+			continue;
+
+		full = xcursor_build_fullname(dir, "cursors", name);
+		if (full) {
+			f = fopen(full, "r");
+			if (f) {
+				images = xcursor_xc_file_load_images(f, size);
+				fclose(f);
+			}
+			free(full);
+		}
+
+		if (!images && !inherits) {
+			full = xcursor_build_fullname(dir, "", "index.theme");
+			inherits = xcursor_theme_inherits(full);
+			free(full);
+		}
+
+		free(dir);
+	}
+
+	for (i = inherits; i && !images; i = xcursor_next_path(i)) {
+		si = strlen(i);
+		if (nodelist_contains(visited_nodes, i, si))
+			continue;
+		images = xcursor_load_cursor_protected(i, name, size, visited_nodes);
+	}
+
+	free(inherits);
+	free(xcursor_path);
+	return images;
+}
+
+/** Load a single cursor of a theme
+ *
+ * This function looks the cursor up in the given theme and its inherited
+ * themes, in the same order as xcursor_load_theme(), and only reads the
+ * first file found.
+ *
+ * \param theme The name of theme that should be searched
+ * \param name The name of the cursor
+ * \param size The desired size of the cursor images
+ * \return The cursor images, to be destroyed with xcursor_images_destroy(),
+ * or NULL if the theme has no such cursor
+ */
+struct xcursor_images *
+xcursor_load_theme_cursor(const char *theme, const char *name, int size)
+{
+	struct xcursor_images *images;
+
+	if (!name || !*name || name[0] == '.' || strchr(name, '/'))
+		return NULL;
+
+	images = xcursor_load_cursor_protected(theme, name, size, NULL);
+	if (images) {
+		images->name = strdup(name);
+		if (!images->name) {
+			xcursor_images_destroy(images);
+			return NULL;
+		}
+	}
+	return images;
+}
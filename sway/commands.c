@@ -44,6 +44,7 @@ struct cmd_results *checkarg(int argc, const char *name, enum expected_args type
 /* Keep alphabetized */
 static const struct cmd_handler handlers[] = {
 	{ "assign", cmd_assign },
+	{ "background_blur", cmd_background_blur },
 	{ "bar", cmd_bar },
 	{ "bindcode", cmd_bindcode },
 	{ "bindgesture", cmd_bindgesture },
@@ -81,8 +82,10 @@ static const struct cmd_handler handlers[] = {
 	{ "force_display_urgency_hint", cmd_force_display_urgency_hint },
 	{ "force_focus_wrapping", cmd_force_focus_wrapping },
 	{ "fullscreen", cmd_fullscreen },
+	{ "fullscreen_fast_path", cmd_fullscreen_fast_path },
 	{ "fullscreen_on_request", cmd_fullscreen_on_request },
 	{ "gaps", cmd_gaps },
+	{ "hidden_frame_rate", cmd_hidden_frame_rate },
 	{ "hide_edge_borders", cmd_hide_edge_borders },
 	{ "input", cmd_input },
 	{ "lua", cmd_lua },
@@ -128,6 +131,7 @@ static const struct cmd_handler config_handlers[] = {
 	{ "fullscreen_movefocus", cmd_fullscreen_movefocus },
 	{ "gesture_scroll_enable", cmd_gesture_scroll_enable },
 	{ "gesture_scroll_fingers", cmd_gesture_scroll_fingers },
+	{ "gesture_scroll_kinetic", cmd_gesture_scroll_kinetic },
 	{ "gesture_scroll_sensitivity", cmd_gesture_scroll_sensitivity },
 	{ "gesture_scroll_sensitivity_mouse", cmd_gesture_scroll_sensitivity_mouse },
 	{ "include", cmd_include },
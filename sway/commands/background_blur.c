@@ -0,0 +1,32 @@
+#include <stdlib.h>
+#include <string.h>
+#include <wlr/types/wlr_scene.h>
+#include "sway/commands.h"
+#include "sway/config.h"
+#include "sway/tree/root.h"
+
+struct cmd_results *cmd_background_blur(int argc, char **argv) {
+	struct cmd_results *error = NULL;
+	if ((error = checkarg(argc, "background_blur", EXPECTED_EQUAL_TO, 1))) {
+		return error;
+	}
+
+	int passes;
+	if (strcmp(argv[0], "disable") == 0) {
+		passes = 0;
+	} else {
+		char *inv;
+		passes = strtol(argv[0], &inv, 10);
+		if (*inv != '\0' || passes <= 0 || passes > 5) {
+			return cmd_results_new(CMD_INVALID,
+				"Expected 'background_blur <1-5>|disable'");
+		}
+	}
+
+	config->background_blur = passes;
+	if (!config->reading) {
+		wlr_scene_set_blur_passes(root->root_scene, passes);
+	}
+
+	return cmd_results_new(CMD_SUCCESS, NULL);
+}
@@ -73,7 +73,7 @@ struct cmd_results *cmd_exec_process(int argc, char **argv) {
 	sway_log(SWAY_DEBUG, "Child process created with pid %d", child);
 	if (ctx != NULL) {
 		sway_log(SWAY_DEBUG, "Recording workspace for process %d", child);
-		ctx->pid = child;
+		launcher_ctx_set_pid(ctx, child);
 	}
 
 	free(cmd);
@@ -0,0 +1,13 @@
+#include "sway/commands.h"
+#include "util.h"
+
+struct cmd_results *cmd_fullscreen_fast_path(int argc, char **argv) {
+	struct cmd_results *error = NULL;
+	if ((error = checkarg(argc, "fullscreen_fast_path", EXPECTED_EQUAL_TO, 1))) {
+		return error;
+	}
+
+	config->fullscreen_fast_path = parse_boolean(argv[0], config->fullscreen_fast_path);
+
+	return cmd_results_new(CMD_SUCCESS, NULL);
+}
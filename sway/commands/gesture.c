@@ -192,6 +192,20 @@ struct cmd_results *cmd_gesture_scroll_fingers(int argc, char **argv) {
 	return cmd_results_new(CMD_SUCCESS, NULL);
 }
 
+/**
+ * Enable or disable the kinetic deceleration of gesture scrolling in config
+ */
+struct cmd_results *cmd_gesture_scroll_kinetic(int argc, char **argv) {
+	struct cmd_results *error = NULL;
+	if ((error = checkarg(argc, "gesture_scroll_kinetic", EXPECTED_AT_LEAST, 1))) {
+		return error;
+	}
+
+	config->gesture_scroll_kinetic = parse_boolean(argv[0], true);
+
+	return cmd_results_new(CMD_SUCCESS, NULL);
+}
+
 /**
  * Set the sensitivity value for gesture scrolling in config
  */
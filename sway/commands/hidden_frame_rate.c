@@ -0,0 +1,32 @@
+#include <stdlib.h>
+#include <string.h>
+#include "sway/commands.h"
+#include "sway/config.h"
+#include "sway/output.h"
+#include "sway/server.h"
+
+struct cmd_results *cmd_hidden_frame_rate(int argc, char **argv) {
+	struct cmd_results *error = NULL;
+	if ((error = checkarg(argc, "hidden_frame_rate", EXPECTED_EQUAL_TO, 1))) {
+		return error;
+	}
+
+	int rate;
+	if (strcmp(argv[0], "pause") == 0) {
+		rate = 0;
+	} else {
+		char *inv;
+		rate = strtol(argv[0], &inv, 10);
+		if (*inv != '\0' || rate <= 0 || rate > 1000) {
+			return cmd_results_new(CMD_INVALID,
+				"Expected 'hidden_frame_rate <1-1000>|pause'");
+		}
+	}
+
+	config->hidden_frame_rate = rate;
+	if (!wl_list_empty(&server.hidden_views)) {
+		output_schedule_hidden_frame_done();
+	}
+
+	return cmd_results_new(CMD_SUCCESS, NULL);
+}
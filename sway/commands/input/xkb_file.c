@@ -1,5 +1,5 @@
-#include <unistd.h>
 #include <errno.h>
+#include <sys/stat.h>
 #include "sway/config.h"
 #include "sway/commands.h"
 #include "sway/log.h"
@@ -15,6 +15,7 @@ struct cmd_results *input_cmd_xkb_file(int argc, char **argv) {
 		return cmd_results_new(CMD_FAILURE, "No input device defined.");
 	}
 
+	ic->xkb_file_mtime = (struct timespec){0};
 	if (strcmp(argv[0], "-") == 0) {
 		free(ic->xkb_file);
 		ic->xkb_file = NULL;
@@ -32,8 +33,11 @@ struct cmd_results *input_cmd_xkb_file(int argc, char **argv) {
 			return cmd_results_new(CMD_FAILURE, "Unable to allocate resource");
 		}
 
-		bool can_access = access(ic->xkb_file, F_OK) != -1;
-		if (!can_access) {
+		struct stat st;
+		bool can_access = stat(ic->xkb_file, &st) != -1;
+		if (can_access) {
+			ic->xkb_file_mtime = st.st_mtim;
+		} else {
 			sway_log_errno(SWAY_ERROR, "Unable to access xkb file '%s'",
 					ic->xkb_file);
 			config_add_swaynag_warning("Unable to access xkb file '%s'",
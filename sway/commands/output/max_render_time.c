@@ -10,9 +10,26 @@ struct cmd_results *output_cmd_max_render_time(int argc, char **argv) {
 		return cmd_results_new(CMD_INVALID, "Missing max render time argument.");
 	}
 
+	int consumed = 1;
 	int max_render_time;
 	if (!strcmp(*argv, "off")) {
 		max_render_time = 0;
+	} else if (!strcmp(*argv, "auto")) {
+		max_render_time = MAX_RENDER_TIME_AUTO;
+		int percentile = MAX_RENDER_TIME_DEFAULT_PERCENTILE;
+		if (argc > 1) {
+			char *end;
+			int value = strtol(argv[1], &end, 10);
+			if (!*end) {
+				if (value < 50 || value > 100) {
+					return cmd_results_new(CMD_INVALID,
+						"Invalid max render time percentile, expected 50-100.");
+				}
+				percentile = value;
+				consumed++;
+			}
+		}
+		config->handler_context.output_config->max_render_time_percentile = percentile;
 	} else {
 		char *end;
 		max_render_time = strtol(*argv, &end, 10);
@@ -22,7 +39,7 @@ struct cmd_results *output_cmd_max_render_time(int argc, char **argv) {
 	}
 	config->handler_context.output_config->max_render_time = max_render_time;
 
-	config->handler_context.leftovers.argc = argc - 1;
-	config->handler_context.leftovers.argv = argv + 1;
+	config->handler_context.leftovers.argc = argc - consumed;
+	config->handler_context.leftovers.argv = argv + consumed;
 	return NULL;
 }
@@ -8,11 +8,18 @@
 #include "list.h"
 #include "sway/log.h"
 
+// Time spent validating the config, reported with the reload that follows
+static double validate_ms;
+
 static void title_bar_update_iterator(struct sway_container *con, void *data) {
 	container_update_title_bar(con);
 }
 
 static void do_reload(void *data) {
+	struct timespec start;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	struct timespec reload_start = start;
+
 	// store bar ids to check against new bars for barconfig_update events
 	list_t *bar_ids = create_list();
 	for (int i = 0; i < config->bars->length; ++i) {
@@ -31,6 +38,10 @@ static void do_reload(void *data) {
 		return;
 	}
 
+	struct sway_reload_stats *stats = &config->reload_stats;
+	stats->validate = validate_ms;
+	config_reload_lap(&start);
+
 	ipc_event_workspace(NULL, NULL, "reload");
 
 	load_swaybars();
@@ -45,10 +56,17 @@ static void do_reload(void *data) {
 		}
 	}
 	list_free_items_and_destroy(bar_ids);
+	stats->bars = config_reload_lap(&start);
 
 	root_for_each_container(title_bar_update_iterator, NULL);
 
 	arrange_root();
+
+	stats->total = stats->validate + config_reload_lap(&reload_start);
+	sway_log(SWAY_DEBUG, "Reloaded in %.1fms (validate %.1fms, parse %.1fms, "
+		"inputs %.1fms, seats %.1fms, outputs %.1fms, bars %.1fms)",
+		stats->total, stats->validate, stats->parse, stats->inputs,
+		stats->seats, stats->outputs, stats->bars);
 }
 
 struct cmd_results *cmd_reload(int argc, char **argv) {
@@ -62,9 +80,12 @@ struct cmd_results *cmd_reload(int argc, char **argv) {
 		path = config->current_config_path;
 	}
 
+	struct timespec start;
+	clock_gettime(CLOCK_MONOTONIC, &start);
 	if (!load_main_config(path, true, true)) {
 		return cmd_results_new(CMD_FAILURE, "Error(s) reloading config.");
 	}
+	validate_ms = config_reload_lap(&start);
 
 	// The reload command frees a lot of stuff, so to avoid use-after-frees
 	// we schedule the reload to happen using an idle event.
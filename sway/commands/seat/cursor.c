@@ -1,18 +1,26 @@
 #include <linux/input-event-codes.h>
 
+#include <stdlib.h>
 #include <strings.h>
+#include <time.h>
 #include <wlr/types/wlr_cursor.h>
 #include <wlr/types/wlr_pointer.h>
 #include "sway/commands.h"
 #include "sway/input/cursor.h"
+#include "sway/input/seat.h"
 #include "sway/server.h"
+#include "util.h"
 
 static struct cmd_results *press_or_release(struct sway_cursor *cursor,
 		char *action, char *button_str);
 
+static struct cmd_results *swipe(struct sway_cursor *cursor,
+		int argc, char **argv);
+
 static const char expected_syntax[] = "Expected 'cursor <move> <x> <y>' or "
 					"'cursor <set> <x> <y>' or "
-					"'cursor <press|release> <button[1-9]|event-name-or-code>'";
+					"'cursor <press|release> <button[1-9]|event-name-or-code>' or "
+					"'cursor swipe <begin <fingers>|update <fingers> <dx> <dy>|end|cancel>'";
 
 static struct cmd_results *handle_command(struct sway_cursor *cursor,
 		int argc, char **argv) {
@@ -35,6 +43,11 @@ static struct cmd_results *handle_command(struct sway_cursor *cursor,
 		wlr_cursor_warp_absolute(cursor->cursor, NULL, x, y);
 		cursor_rebase(cursor);
 		wlr_seat_pointer_notify_frame(cursor->seat->wlr_seat);
+	} else if (strcasecmp(argv[0], "swipe") == 0) {
+		struct cmd_results *error = NULL;
+		if ((error = swipe(cursor, argc - 1, argv + 1))) {
+			return error;
+		}
 	} else {
 		if (argc < 2) {
 			return cmd_results_new(CMD_INVALID, "%s", expected_syntax);
@@ -129,3 +142,39 @@ static struct cmd_results *press_or_release(struct sway_cursor *cursor,
 	wlr_seat_pointer_notify_frame(cursor->seat->wlr_seat);
 	return cmd_results_new(CMD_SUCCESS, NULL);
 }
+
+static struct cmd_results *swipe(struct sway_cursor *cursor,
+		int argc, char **argv) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	uint32_t time_msec = timespec_to_msec(&now);
+
+	if (argc == 2 && strcasecmp(argv[0], "begin") == 0) {
+		struct wlr_pointer_swipe_begin_event event = {
+			.pointer = NULL,
+			.time_msec = time_msec,
+			.fingers = strtoul(argv[1], NULL, 10),
+		};
+		seatop_swipe_begin(cursor->seat, &event);
+	} else if (argc == 4 && strcasecmp(argv[0], "update") == 0) {
+		struct wlr_pointer_swipe_update_event event = {
+			.pointer = NULL,
+			.time_msec = time_msec,
+			.fingers = strtoul(argv[1], NULL, 10),
+			.dx = strtod(argv[2], NULL),
+			.dy = strtod(argv[3], NULL),
+		};
+		seatop_swipe_update(cursor->seat, &event);
+	} else if (argc == 1 && (strcasecmp(argv[0], "end") == 0 ||
+			strcasecmp(argv[0], "cancel") == 0)) {
+		struct wlr_pointer_swipe_end_event event = {
+			.pointer = NULL,
+			.time_msec = time_msec,
+			.cancelled = strcasecmp(argv[0], "cancel") == 0,
+		};
+		seatop_swipe_end(cursor->seat, &event);
+	} else {
+		return cmd_results_new(CMD_INVALID, "%s", expected_syntax);
+	}
+	return NULL;
+}
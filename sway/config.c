@@ -15,15 +15,19 @@
 #include <strings.h>
 #include <linux/input-event-codes.h>
 #include <wlr/types/wlr_output.h>
+#include <wlr/types/wlr_scene.h>
 #include "sway/input/input-manager.h"
+#include "sway/input/keyboard.h"
 #include "sway/input/seat.h"
 #include "sway/input/switch.h"
 #include "sway/commands.h"
 #include "sway/config.h"
 #include "sway/criteria.h"
+#include "sway/output.h"
 #include "sway/server.h"
 #include "sway/swaynag.h"
 #include "sway/tree/arrange.h"
+#include "sway/tree/root.h"
 #include "sway/log.h"
 #include "pango.h"
 #include "stringop.h"
@@ -34,12 +38,18 @@ struct sway_config *config = NULL;
 
 static struct xkb_state *keysym_translation_state_create(
 		struct xkb_rule_names rules, uint32_t context_flags) {
-	struct xkb_context *context = xkb_context_new(context_flags | XKB_CONTEXT_NO_SECURE_GETENV);
-	struct xkb_keymap *xkb_keymap = xkb_keymap_new_from_names(
-		context,
-		&rules,
-		XKB_KEYMAP_COMPILE_NO_FLAGS);
-	xkb_context_unref(context);
+	struct xkb_keymap *xkb_keymap;
+	if (context_flags == 0) {
+		// Shared with the keyboards using the same layout
+		xkb_keymap = sway_keyboard_compile_keymap_from_names(&rules, NULL);
+	} else {
+		struct xkb_context *context = xkb_context_new(context_flags | XKB_CONTEXT_NO_SECURE_GETENV);
+		xkb_keymap = xkb_keymap_new_from_names(
+			context,
+			&rules,
+			XKB_KEYMAP_COMPILE_NO_FLAGS);
+		xkb_context_unref(context);
+	}
 	if (xkb_keymap == NULL) {
 		sway_log(SWAY_ERROR, "Failed to compile keysym translation XKB keymap");
 		return NULL;
@@ -299,6 +309,7 @@ static void config_defaults(struct sway_config *config) {
 	config->focus_ring_length = 0;
 	config->gesture_scroll_enable = true;
 	config->gesture_scroll_fingers = 3;
+	config->gesture_scroll_kinetic = true;
 	config->gesture_scroll_sentitivity = 1.0f;
 	config->gesture_scroll_sentitivity_mouse = 1.0f;
 
@@ -379,6 +390,9 @@ static void config_defaults(struct sway_config *config) {
 	config->tiling_drag = true;
 	config->tiling_drag_threshold = 9;
 	config->primary_selection = true;
+	config->fullscreen_fast_path = false;
+	config->hidden_frame_rate = 1;
+	config->background_blur = 2;
 
 	config->smart_gaps = SMART_GAPS_OFF;
 	config->gaps_inner = 0;
@@ -591,6 +605,14 @@ static bool load_config(const char *path, struct sway_config *config,
 	return config->active || !config->validating || config_load_success;
 }
 
+double config_reload_lap(struct timespec *start) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	double ms = (timespec_to_nsec(&now) - timespec_to_nsec(start)) / 1000000.0;
+	*start = now;
+	return ms;
+}
+
 bool load_main_config(const char *file, bool is_active, bool validating) {
 	char *path;
 	if (file != NULL) {
@@ -610,6 +632,11 @@ bool load_main_config(const char *file, bool is_active, bool validating) {
 		return false;
 	}
 
+	if (is_active && validating) {
+		// A reload validates first, which recompiles the keymaps once
+		sway_keyboard_keymap_cache_invalidate();
+	}
+
 	struct sway_config *old_config = config;
 	config = calloc(1, sizeof(struct sway_config));
 	if (!config) {
@@ -640,15 +667,13 @@ bool load_main_config(const char *file, bool is_active, bool validating) {
 		config->primary_selection = old_config->primary_selection;
 
 		if (!config->validating) {
-			if (old_config->swaybg_client != NULL) {
-				wl_client_destroy(old_config->swaybg_client);
-			}
-
 			if (old_config->swaynag_config_errors.client != NULL) {
 				wl_client_destroy(old_config->swaynag_config_errors.client);
 			}
 
-			input_manager_reset_all_inputs();
+			// Inputs, seats, outputs and swaybg are compared against the
+			// old config after parsing and only touched if they changed.
+			config->reload_stats.count = old_config->reload_stats.count + 1;
 		}
 	}
 
@@ -658,6 +683,9 @@ bool load_main_config(const char *file, bool is_active, bool validating) {
 
 	config->reading = true;
 
+	struct timespec start;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
 	bool success = load_config(path, config, &config->swaynag_config_errors);
 
 	if (validating) {
@@ -669,32 +697,56 @@ bool load_main_config(const char *file, bool is_active, bool validating) {
 	// Only really necessary if not explicitly `font` is set in the config.
 	config_update_font_height();
 
+	struct sway_reload_stats *stats = &config->reload_stats;
+	stats->parse = config_reload_lap(&start);
+
 	if (!validating) {
-		input_manager_verify_fallback_seat();
+		if (is_active) {
+			input_manager_apply_reloaded_configs(old_config);
+		} else {
+			input_manager_verify_fallback_seat();
 
-		for (int i = 0; i < config->input_configs->length; i++) {
-			input_manager_apply_input_config(config->input_configs->items[i]);
-		}
+			for (int i = 0; i < config->input_configs->length; i++) {
+				input_manager_apply_input_config(config->input_configs->items[i]);
+			}
 
-		for (int i = 0; i < config->input_type_configs->length; i++) {
-			input_manager_apply_input_config(
-					config->input_type_configs->items[i]);
-		}
+			for (int i = 0; i < config->input_type_configs->length; i++) {
+				input_manager_apply_input_config(
+						config->input_type_configs->items[i]);
+			}
 
-		for (int i = 0; i < config->seat_configs->length; i++) {
-			input_manager_apply_seat_config(config->seat_configs->items[i]);
+			for (int i = 0; i < config->seat_configs->length; i++) {
+				input_manager_apply_seat_config(config->seat_configs->items[i]);
+			}
 		}
 		sway_switch_retrigger_bindings_for_all();
+		config_reload_lap(&start);
 
-		spawn_swaybg();
+		stats->swaybg_kept = is_active && keep_swaybg(old_config);
+		if (!stats->swaybg_kept) {
+			if (old_config && old_config->swaybg_client != NULL) {
+				wl_client_destroy(old_config->swaybg_client);
+			}
+			spawn_swaybg();
+		}
 
 		config->reloading = false;
+		wlr_scene_set_blur_passes(root->root_scene, config->background_blur);
+		if (!wl_list_empty(&server.hidden_views)) {
+			// hidden_frame_rate was reset with the config
+			output_schedule_hidden_frame_done();
+		}
 		if (is_active) {
-			request_modeset();
+			stats->modeset = !output_configs_equal(old_config->output_configs,
+				config->output_configs);
+			if (stats->modeset) {
+				request_modeset();
+			}
 			if (config->swaynag_config_errors.client != NULL) {
 				swaynag_show(&config->swaynag_config_errors);
 			}
 		}
+		stats->outputs = config_reload_lap(&start);
 	}
 
 	if (old_config) {
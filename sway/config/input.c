@@ -5,6 +5,7 @@
 #include "sway/input/keyboard.h"
 #include "sway/server.h"
 #include "sway/log.h"
+#include "stringop.h"
 
 struct input_config *new_input_config(const char* identifier) {
 	struct input_config *input = calloc(1, sizeof(struct input_config));
@@ -120,6 +121,7 @@ void merge_input_config(struct input_config *dst, struct input_config *src) {
 	if (src->xkb_file_is_set) {
 		free(dst->xkb_file);
 		dst->xkb_file = src->xkb_file ? strdup(src->xkb_file) : NULL;
+		dst->xkb_file_mtime = src->xkb_file_mtime;
 		dst->xkb_file_is_set = dst->xkb_file != NULL;
 	}
 	if (src->xkb_layout) {
@@ -399,6 +401,88 @@ void free_input_config(struct input_config *ic) {
 	free(ic);
 }
 
+static bool input_tools_equal(list_t *a, list_t *b) {
+	if (a->length != b->length) {
+		return false;
+	}
+	for (int i = 0; i < a->length; i++) {
+		struct input_config_tool *tool_a = a->items[i];
+		struct input_config_tool *tool_b = b->items[i];
+		if (tool_a->type != tool_b->type || tool_a->mode != tool_b->mode) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool input_boxes_equal(const struct wlr_box *a, const struct wlr_box *b) {
+	if (!a || !b) {
+		return a == b;
+	}
+	return a->x == b->x && a->y == b->y &&
+		a->width == b->width && a->height == b->height;
+}
+
+bool input_config_equal(const struct input_config *a,
+		const struct input_config *b) {
+	if (!a || !b) {
+		return a == b;
+	}
+	if (a->mapped_from_region || b->mapped_from_region) {
+		if (!a->mapped_from_region || !b->mapped_from_region ||
+				memcmp(a->mapped_from_region, b->mapped_from_region,
+					sizeof(*a->mapped_from_region)) != 0) {
+			return false;
+		}
+	}
+	if (a->calibration_matrix.configured != b->calibration_matrix.configured ||
+			(a->calibration_matrix.configured &&
+			 memcmp(a->calibration_matrix.matrix, b->calibration_matrix.matrix,
+				 sizeof(a->calibration_matrix.matrix)) != 0)) {
+		return false;
+	}
+	return strcmp(a->identifier, b->identifier) == 0 &&
+		a->accel_profile == b->accel_profile &&
+		a->click_method == b->click_method &&
+		a->clickfinger_button_map == b->clickfinger_button_map &&
+		a->drag_3fg == b->drag_3fg &&
+		a->drag == b->drag &&
+		a->drag_lock == b->drag_lock &&
+		a->dwt == b->dwt &&
+		a->dwtp == b->dwtp &&
+		a->left_handed == b->left_handed &&
+		a->middle_emulation == b->middle_emulation &&
+		a->natural_scroll == b->natural_scroll &&
+		a->pointer_accel == b->pointer_accel &&
+		a->rotation_angle == b->rotation_angle &&
+		a->scroll_factor == b->scroll_factor &&
+		a->repeat_delay == b->repeat_delay &&
+		a->repeat_rate == b->repeat_rate &&
+		a->scroll_button == b->scroll_button &&
+		a->scroll_button_lock == b->scroll_button_lock &&
+		a->scroll_method == b->scroll_method &&
+		a->send_events == b->send_events &&
+		a->tap == b->tap &&
+		a->tap_button_map == b->tap_button_map &&
+		lenient_strcmp(a->xkb_layout, b->xkb_layout) == 0 &&
+		lenient_strcmp(a->xkb_model, b->xkb_model) == 0 &&
+		lenient_strcmp(a->xkb_options, b->xkb_options) == 0 &&
+		lenient_strcmp(a->xkb_rules, b->xkb_rules) == 0 &&
+		lenient_strcmp(a->xkb_variant, b->xkb_variant) == 0 &&
+		lenient_strcmp(a->xkb_file, b->xkb_file) == 0 &&
+		a->xkb_file_mtime.tv_sec == b->xkb_file_mtime.tv_sec &&
+		a->xkb_file_mtime.tv_nsec == b->xkb_file_mtime.tv_nsec &&
+		a->xkb_file_is_set == b->xkb_file_is_set &&
+		a->xkb_numlock == b->xkb_numlock &&
+		a->xkb_capslock == b->xkb_capslock &&
+		a->mapped_to == b->mapped_to &&
+		lenient_strcmp(a->mapped_to_output, b->mapped_to_output) == 0 &&
+		input_boxes_equal(a->mapped_to_region, b->mapped_to_region) &&
+		input_tools_equal(a->tools, b->tools) &&
+		a->capturable == b->capturable &&
+		input_boxes_equal(&a->region, &b->region);
+}
+
 int input_identifier_cmp(const void *item, const void *data) {
 	const struct input_config *ic = item;
 	const char *identifier = data;
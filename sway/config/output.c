@@ -22,6 +22,7 @@
 #include "sway/tree/arrange.h"
 #include "sway/tree/root.h"
 #include "sway/log.h"
+#include "stringop.h"
 #include "util.h"
 
 #if WLR_HAS_DRM_BACKEND
@@ -74,6 +75,7 @@ struct output_config *new_output_config(const char *name) {
 	oc->transform = -1;
 	oc->subpixel = WL_OUTPUT_SUBPIXEL_UNKNOWN;
 	oc->max_render_time = -1;
+	oc->max_render_time_percentile = MAX_RENDER_TIME_DEFAULT_PERCENTILE;
 	oc->adaptive_sync = -1;
 	oc->render_bit_depth = RENDER_BIT_DEPTH_DEFAULT;
 	oc->color_profile = COLOR_PROFILE_DEFAULT;
@@ -235,6 +237,7 @@ static void merge_output_config(struct output_config *dst, struct output_config
 	}
 	if (src->max_render_time != -1) {
 		dst->max_render_time = src->max_render_time;
+		dst->max_render_time_percentile = src->max_render_time_percentile;
 	}
 	if (src->adaptive_sync != -1) {
 		dst->adaptive_sync = src->adaptive_sync;
@@ -791,6 +794,15 @@ static bool finalize_output_config(struct output_config *oc, struct sway_output
 	}
 	output->color_transform = config_applied->color_transform;
 
+	bool render_time_auto = oc && oc->max_render_time == MAX_RENDER_TIME_AUTO;
+	if (render_time_auto != output->render_time.enabled) {
+		wlr_scene_timer_finish(&output->render_time.timer);
+		memset(&output->render_time, 0, sizeof(output->render_time));
+		output->render_time.enabled = render_time_auto;
+	}
+	if (render_time_auto) {
+		output->render_time.percentile = oc->max_render_time_percentile;
+	}
 	output->max_render_time = oc && oc->max_render_time > 0 ? oc->max_render_time : 0;
 	output->allow_tearing = oc && oc->allow_tearing > 0;
 	output->hdr = applied->image_description != NULL;
@@ -1284,6 +1296,90 @@ void free_output_config(struct output_config *oc) {
 	free(oc);
 }
 
+static bool double_lists_equal(list_t *a, list_t *b) {
+	if (!a || !b) {
+		return a == b;
+	}
+	if (a->length != b->length) {
+		return false;
+	}
+	for (int i = 0; i < a->length; i++) {
+		if (*(double *)a->items[i] != *(double *)b->items[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool modifiers_equal(const struct sway_scroller_modifiers *a,
+		const struct sway_scroller_modifiers *b) {
+	return a->set == b->set &&
+		a->reorder_set == b->reorder_set && a->reorder == b->reorder &&
+		a->mode_set == b->mode_set && a->mode == b->mode &&
+		a->insert_set == b->insert_set && a->insert == b->insert &&
+		a->fit_set == b->fit_set && a->fit == b->fit &&
+		a->focus_set == b->focus_set && a->focus == b->focus &&
+		a->center_horizontal_set == b->center_horizontal_set &&
+		a->center_horizontal == b->center_horizontal &&
+		a->center_vertical_set == b->center_vertical_set &&
+		a->center_vertical == b->center_vertical;
+}
+
+static bool output_config_equal(const struct output_config *a,
+		const struct output_config *b) {
+	// Color transforms are loaded anew for every config, so any output that
+	// has one is considered changed.
+	if (a->color_transform || b->color_transform) {
+		return false;
+	}
+	if (a->custom_mode != b->custom_mode || (a->custom_mode == 1 &&
+			memcmp(&a->drm_mode, &b->drm_mode, sizeof(a->drm_mode)) != 0)) {
+		return false;
+	}
+	return strcmp(a->name, b->name) == 0 &&
+		a->enabled == b->enabled &&
+		a->power == b->power &&
+		a->width == b->width &&
+		a->height == b->height &&
+		a->refresh_rate == b->refresh_rate &&
+		a->x == b->x &&
+		a->y == b->y &&
+		a->scale == b->scale &&
+		a->scale_force == b->scale_force &&
+		a->scale_filter == b->scale_filter &&
+		a->transform == b->transform &&
+		a->subpixel == b->subpixel &&
+		a->max_render_time == b->max_render_time &&
+		a->max_render_time_percentile == b->max_render_time_percentile &&
+		a->adaptive_sync == b->adaptive_sync &&
+		a->render_bit_depth == b->render_bit_depth &&
+		a->color_profile == b->color_profile &&
+		a->allow_tearing == b->allow_tearing &&
+		a->hdr == b->hdr &&
+		a->layout_type == b->layout_type &&
+		a->layout_default_width == b->layout_default_width &&
+		a->layout_default_height == b->layout_default_height &&
+		double_lists_equal(a->layout_widths, b->layout_widths) &&
+		double_lists_equal(a->layout_heights, b->layout_heights) &&
+		modifiers_equal(&a->layout_default_modifiers,
+			&b->layout_default_modifiers) &&
+		lenient_strcmp(a->background, b->background) == 0 &&
+		lenient_strcmp(a->background_option, b->background_option) == 0 &&
+		lenient_strcmp(a->background_fallback, b->background_fallback) == 0;
+}
+
+bool output_configs_equal(list_t *a, list_t *b) {
+	if (a->length != b->length) {
+		return false;
+	}
+	for (int i = 0; i < a->length; i++) {
+		if (!output_config_equal(a->items[i], b->items[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
 static void handle_swaybg_client_destroy(struct wl_listener *listener,
 		void *data) {
 	struct sway_config *sway_config =
@@ -1405,3 +1501,48 @@ bool spawn_swaybg(void) {
 	free(cmd);
 	return result;
 }
+
+static bool swaybg_args_equal(struct sway_config *a, struct sway_config *b) {
+	if (lenient_strcmp(a->swaybg_command, b->swaybg_command) != 0) {
+		return false;
+	}
+	int i = 0, j = 0;
+	while (true) {
+		while (i < a->output_configs->length &&
+				!((struct output_config *)a->output_configs->items[i])->background) {
+			i++;
+		}
+		while (j < b->output_configs->length &&
+				!((struct output_config *)b->output_configs->items[j])->background) {
+			j++;
+		}
+		if (i == a->output_configs->length || j == b->output_configs->length) {
+			return i == a->output_configs->length &&
+				j == b->output_configs->length;
+		}
+		struct output_config *oc_a = a->output_configs->items[i++];
+		struct output_config *oc_b = b->output_configs->items[j++];
+		if (strcmp(oc_a->name, oc_b->name) != 0 ||
+				strcmp(oc_a->background, oc_b->background) != 0 ||
+				lenient_strcmp(oc_a->background_option,
+					oc_b->background_option) != 0 ||
+				lenient_strcmp(oc_a->background_fallback,
+					oc_b->background_fallback) != 0) {
+			return false;
+		}
+	}
+}
+
+bool keep_swaybg(struct sway_config *old_config) {
+	if (!old_config->swaybg_client || !swaybg_args_equal(old_config, config)) {
+		return false;
+	}
+
+	config->swaybg_client = old_config->swaybg_client;
+	wl_list_remove(&old_config->swaybg_client_destroy.link);
+	config->swaybg_client_destroy.notify = handle_swaybg_client_destroy;
+	wl_client_add_destroy_listener(config->swaybg_client,
+		&config->swaybg_client_destroy);
+	old_config->swaybg_client = NULL;
+	return true;
+}
@@ -3,6 +3,7 @@
 #include <string.h>
 #include "sway/config.h"
 #include "sway/log.h"
+#include "stringop.h"
 
 struct seat_config *new_seat_config(const char* name) {
 	struct seat_config *seat = calloc(1, sizeof(struct seat_config));
@@ -206,6 +207,42 @@ void free_seat_config(struct seat_config *seat) {
 	free(seat);
 }
 
+static bool seat_config_equal(struct seat_config *a, struct seat_config *b) {
+	if (strcmp(a->name, b->name) != 0 ||
+			a->fallback != b->fallback ||
+			a->hide_cursor_timeout != b->hide_cursor_timeout ||
+			a->hide_cursor_when_typing != b->hide_cursor_when_typing ||
+			a->allow_constrain != b->allow_constrain ||
+			a->shortcuts_inhibit != b->shortcuts_inhibit ||
+			a->keyboard_grouping != b->keyboard_grouping ||
+			a->idle_inhibit_sources != b->idle_inhibit_sources ||
+			a->idle_wake_sources != b->idle_wake_sources ||
+			lenient_strcmp(a->xcursor_theme.name, b->xcursor_theme.name) != 0 ||
+			a->xcursor_theme.size != b->xcursor_theme.size ||
+			a->attachments->length != b->attachments->length) {
+		return false;
+	}
+	for (int i = 0; i < a->attachments->length; ++i) {
+		struct seat_attachment_config *attachment = a->attachments->items[i];
+		if (!seat_config_get_attachment(b, attachment->identifier)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool seat_configs_equal(list_t *a, list_t *b) {
+	if (a->length != b->length) {
+		return false;
+	}
+	for (int i = 0; i < a->length; ++i) {
+		if (!seat_config_equal(a->items[i], b->items[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
 int seat_name_cmp(const void *item, const void *data) {
 	const struct seat_config *sc = item;
 	const char *name = data;
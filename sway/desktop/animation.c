@@ -3,7 +3,9 @@
 #include "sway/log.h"
 #include <wayland-server-core.h>
 #include "sway/output.h"
+#include "sway/desktop/frame_clock.h"
 #include "sway/desktop/transaction.h"
+#include "util.h"
 
 #define NDIM 2
 
@@ -154,6 +156,8 @@ struct sway_animation_state {
 struct sway_animation {
 	bool animating;
 	struct timespec start;
+	// The latest time sampled, outputs may predict presentations in any order
+	struct timespec last_sample;
 	double time;
 	uint32_t id;
 
@@ -360,7 +364,21 @@ void animation_set_default_callbacks(struct sway_animation_callbacks *callbacks)
 	animation->default_callbacks.callback_end_data = callbacks->callback_end_data;
 }
 
+static bool callbacks_equal(struct sway_animation_callbacks *a,
+		struct sway_animation_callbacks *b) {
+	return a->callback_begin == b->callback_begin &&
+		a->callback_begin_data == b->callback_begin_data &&
+		a->callback_step == b->callback_step &&
+		a->callback_step_data == b->callback_step_data &&
+		a->callback_end == b->callback_end &&
+		a->callback_end_data == b->callback_end_data;
+}
+
 void animation_set_callbacks(struct sway_animation_callbacks *callbacks) {
+	if (!callbacks_equal(&animation->pending.callbacks, callbacks)) {
+		// The changes waiting to be coalesced were made for the current ones
+		transaction_flush();
+	}
 	animation->pending.callbacks.callback_begin = callbacks->callback_begin;
 	animation->pending.callbacks.callback_begin_data = callbacks->callback_begin_data;
 	animation->pending.callbacks.callback_step = callbacks->callback_step;
@@ -410,6 +428,9 @@ const char *animation_get_type(struct sway_animation_path *path) {
 
 // Set the type of the pending animation
 void animation_set_type(enum sway_animation_type anim) {
+	if (animation->pending.type != anim) {
+		transaction_flush();
+	}
 	animation->pending.type = anim;
 	switch (anim) {
 	case ANIMATION_DISABLED:
@@ -644,6 +665,7 @@ void animation_begin() {
 		animation_reset_path(path);
 		animation->animating = true;
 		clock_gettime(CLOCK_MONOTONIC, &animation->start);
+		animation->last_sample = animation->start;
 		if (animation->current.callbacks.callback_begin) {
 			animation->current.callbacks.callback_begin(animation->current.callbacks.callback_begin_data);
 		}
@@ -695,9 +717,37 @@ last:
 	return true;
 }
 
-void animation_animate(struct wlr_output *output) {
+struct sway_animation_clock_stats animation_clock_stats = {0};
+
+/**
+ * Get the time to evaluate the animation at for the frame being rendered for
+ * the output: when the frame will be shown, rather than now, so motion stays
+ * even however late in the refresh cycle the frame is rendered.
+ */
+static void animation_sample_time(struct wlr_output *wlr_output,
+		struct timespec *time) {
 	struct timespec now;
 	clock_gettime(CLOCK_MONOTONIC, &now);
+	struct sway_output *output = wlr_output->data;
+	int64_t predicted = timespec_to_nsec(&now);
+	if (output && frame_clock_predict(timespec_to_nsec(&now),
+			timespec_to_nsec(&output->last_presentation), output->refresh_nsec,
+			output->max_render_time, &predicted)) {
+		animation_clock_stats.predicted++;
+	} else {
+		animation_clock_stats.fallback++;
+	}
+	timespec_from_nsec(time, predicted);
+
+	if (timespec_to_nsec(time) < timespec_to_nsec(&animation->last_sample)) {
+		*time = animation->last_sample;
+	}
+	animation->last_sample = *time;
+}
+
+void animation_animate(struct wlr_output *output) {
+	struct timespec now;
+	animation_sample_time(output, &now);
 	bool ended = animation_set_time(&now);
 
 	// Save old filters and push new
@@ -0,0 +1,42 @@
+#include <stdlib.h>
+#include "sway/desktop/frame_clock.h"
+
+bool frame_clock_predict(int64_t now, int64_t last_presentation,
+		uint32_t refresh_nsec, int max_render_time, int64_t *predicted) {
+	int64_t target = last_presentation + refresh_nsec;
+	// A presentation reported in the future can't be trusted
+	if (refresh_nsec == 0 || last_presentation <= 0 || target > now + 2 * (int64_t)refresh_nsec) {
+		*predicted = now + (int64_t)max_render_time * 1000000;
+		return false;
+	}
+
+	if (target <= now) {
+		target += ((now - target) / refresh_nsec + 1) * refresh_nsec;
+	}
+	*predicted = target;
+	return true;
+}
+
+static int compare_render_time(const void *a, const void *b) {
+	int64_t ta = *(const int64_t *)a;
+	int64_t tb = *(const int64_t *)b;
+	return (ta > tb) - (ta < tb);
+}
+
+int frame_clock_max_render_time(int64_t *samples, int len, int percentile,
+		int margin, uint32_t refresh_nsec) {
+	if (len <= 0 || refresh_nsec == 0) {
+		return 0;
+	}
+	qsort(samples, len, sizeof(int64_t), compare_render_time);
+	int idx = (len - 1) * percentile / 100;
+
+	// Round up to the next millisecond, plus 1 msec of timer slack
+	int msec = (samples[idx] + 999999) / 1000000 + 1 + margin;
+	int refresh_msec = refresh_nsec / 1000000;
+	if (msec >= refresh_msec) {
+		// We can't delay rendering at all
+		return 0;
+	}
+	return msec;
+}
@@ -1,48 +1,99 @@
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #include <wlr/types/wlr_xdg_activation_v1.h>
 #include "sway/input/seat.h"
 #include "sway/output.h"
 #include "sway/desktop/launcher.h"
+#include "sway/desktop/pid_cache.h"
 #include "sway/server.h"
 #include "sway/tree/node.h"
 #include "sway/tree/container.h"
 #include "sway/tree/workspace.h"
 #include "sway/tree/root.h"
 #include "sway/log.h"
+#include "khashl.h"
 
-/**
- * Get the pid of a parent process given the pid of a child process.
- *
- * Returns the parent pid or NULL if the parent pid cannot be determined.
- */
-static pid_t get_parent_pid(pid_t child) {
-	pid_t parent = -1;
-	char file_name[100];
-	char *buffer = NULL;
-	const char *sep = " ";
-	FILE *stat = NULL;
-	size_t buf_size = 0;
-
-	snprintf(file_name, sizeof(file_name), "/proc/%d/stat", child);
-
-	if ((stat = fopen(file_name, "r"))) {
-		if (getline(&buffer, &buf_size, stat) != -1) {
-			strtok(buffer, sep); // pid
-			strtok(NULL, sep);   // executable name
-			strtok(NULL, sep);   // state
-			char *token = strtok(NULL, sep);   // parent pid
-			parent = strtol(token, NULL, 10);
-		}
-		free(buffer);
-		fclose(stat);
+typedef struct launcher_ctx *launcher_ctx_ptr;
+
+static kh_inline khint_t ctx_hash_fn(pid_t pid) {
+	return kh_hash_uint32((khint_t)pid);
+}
+
+static kh_inline int ctx_eq_fn(pid_t a, pid_t b) {
+	return a == b;
+}
+
+KHASHL_MAP_INIT(KH_LOCAL, ctx_map_t, ctx_map, pid_t, launcher_ctx_ptr,
+	ctx_hash_fn, ctx_eq_fn)
+
+// The pending launcher contexts with a pid, by pid
+static ctx_map_t *ctx_by_pid = NULL;
+static struct pid_cache *pid_cache = NULL;
+
+// Deep enough for any real process tree, and stops loops in broken ones
+#define MAX_ANCESTRY_DEPTH 64
+
+void launcher_init(void) {
+	if (ctx_by_pid) {
+		sway_abort("launcher already initialized");
+	}
+	ctx_by_pid = ctx_map_init();
+	if (!ctx_by_pid) {
+		sway_abort("Failed to allocate launcher context map");
 	}
+	pid_cache = pid_cache_create("/proc");
+	if (!pid_cache) {
+		sway_abort("Failed to allocate the pid cache");
+	}
+}
+
+void launcher_fini(void) {
+	// Contexts destroyed after this are just not in the map anymore
+	ctx_map_destroy(ctx_by_pid);
+	ctx_by_pid = NULL;
+	pid_cache_destroy(pid_cache);
+	pid_cache = NULL;
+}
+
+static void ctx_index_remove(struct launcher_ctx *ctx) {
+	if (!ctx_by_pid || ctx->pid <= 0) {
+		return;
+	}
+	khint_t k = ctx_map_get(ctx_by_pid, ctx->pid);
+	// The pid may have been reused and taken over by a newer context
+	if (k != kh_end(ctx_by_pid) && kh_val(ctx_by_pid, k) == ctx) {
+		ctx_map_del(ctx_by_pid, k);
+	}
+}
 
-	if (parent) {
-		return (parent == child) ? -1 : parent;
+static struct launcher_ctx *ctx_index_get(pid_t pid) {
+	if (!ctx_by_pid) {
+		return NULL;
 	}
+	khint_t k = ctx_map_get(ctx_by_pid, pid);
+	return k == kh_end(ctx_by_pid) ? NULL : kh_val(ctx_by_pid, k);
+}
 
-	return -1;
+void launcher_ctx_set_pid(struct launcher_ctx *ctx, pid_t pid) {
+	ctx_index_remove(ctx);
+	ctx->pid = pid;
+	if (!ctx_by_pid) {
+		return;
+	}
+	int absent;
+	khint_t k = ctx_map_put(ctx_by_pid, pid, &absent);
+	if (absent < 0) {
+		sway_abort("Failed to insert launcher context into hash map (OOM)");
+	}
+	if (!absent && kh_val(ctx_by_pid, k) != ctx) {
+		// The process of the older context exited and its pid was reused
+		struct launcher_ctx *old = kh_val(ctx_by_pid, k);
+		sway_log(SWAY_DEBUG, "Launcher context for pid %d replaced", pid);
+		old->pid = 0;
+	}
+	kh_val(ctx_by_pid, k) = ctx;
 }
 
 void launcher_ctx_consume(struct launcher_ctx *ctx) {
@@ -57,6 +108,7 @@ void launcher_ctx_consume(struct launcher_ctx *ctx) {
 	ctx->token = NULL;
 
 	// Prevent additional matches
+	ctx_index_remove(ctx);
 	wl_list_remove(&ctx->link);
 	wl_list_init(&ctx->link);
 }
@@ -70,34 +122,75 @@ void launcher_ctx_destroy(struct launcher_ctx *ctx) {
 	if (ctx->seat) {
 		wl_list_remove(&ctx->seat_destroy.link);
 	}
+	ctx_index_remove(ctx);
 	wl_list_remove(&ctx->link);
 	wlr_xdg_activation_token_v1_destroy(ctx->token);
 	free(ctx->fallback_name);
 	free(ctx);
 }
 
+/**
+ * Find a context for a process in a transient systemd scope, like the ones
+ * flatpak or app launchers start apps in. Such apps aren't descendants of the
+ * process that launched them, but share their scope with it.
+ */
+static struct launcher_ctx *launcher_ctx_find_cgroup(pid_t pid) {
+	char cgroup[PATH_MAX];
+	if (!pid_cache_get_cgroup(pid_cache, pid, cgroup, sizeof(cgroup))) {
+		return NULL;
+	}
+	size_t len = strlen(cgroup);
+	if (len < strlen(".scope") || strcmp(&cgroup[len - strlen(".scope")], ".scope") != 0) {
+		return NULL;
+	}
+	// Everything we launch starts in our own scope, if we have one
+	char own_cgroup[PATH_MAX];
+	if (pid_cache_get_cgroup(pid_cache, getpid(), own_cgroup, sizeof(own_cgroup)) &&
+			strcmp(cgroup, own_cgroup) == 0) {
+		return NULL;
+	}
+
+	struct launcher_ctx *ctx;
+	wl_list_for_each(ctx, &server.pending_launcher_ctxs, link) {
+		char ctx_cgroup[PATH_MAX];
+		if (ctx->pid > 0 && pid_cache_get_cgroup(pid_cache, ctx->pid,
+				ctx_cgroup, sizeof(ctx_cgroup)) && strcmp(cgroup, ctx_cgroup) == 0) {
+			sway_log(SWAY_DEBUG, "found %s match for pid %d in %s: %s",
+				node_type_to_str(ctx->node->type), pid, cgroup,
+				node_get_name(ctx->node));
+			return ctx;
+		}
+	}
+	return NULL;
+}
+
 struct launcher_ctx *launcher_ctx_find_pid(pid_t pid) {
 	if (wl_list_empty(&server.pending_launcher_ctxs)) {
 		return NULL;
 	}
+	if (!pid_cache) {
+		return NULL;
+	}
 
 	struct launcher_ctx *ctx = NULL;
 	sway_log(SWAY_DEBUG, "Looking up workspace for pid %d", pid);
 
-	do {
-		struct launcher_ctx *_ctx = NULL;
-		wl_list_for_each(_ctx, &server.pending_launcher_ctxs, link) {
-			if (pid == _ctx->pid) {
-				ctx = _ctx;
-				sway_log(SWAY_DEBUG,
-					"found %s match for pid %d: %s",
-					node_type_to_str(ctx->node->type), pid, node_get_name(ctx->node));
-				break;
-			}
+	// The furthest ancestor with a context wins
+	pid_t ancestor = pid;
+	for (int depth = 0; ancestor > 1 && depth < MAX_ANCESTRY_DEPTH; depth++) {
+		struct launcher_ctx *match = ctx_index_get(ancestor);
+		if (match) {
+			ctx = match;
+			sway_log(SWAY_DEBUG,
+				"found %s match for pid %d: %s",
+				node_type_to_str(ctx->node->type), ancestor, node_get_name(ctx->node));
 		}
-		pid = get_parent_pid(pid);
-	} while (pid > 1);
+		ancestor = pid_cache_get_parent(pid_cache, ancestor);
+	}
 
+	if (!ctx) {
+		ctx = launcher_ctx_find_cgroup(pid);
+	}
 	return ctx;
 }
 
@@ -22,6 +22,8 @@
 #include "sway/tree/workspace.h"
 #include "sway/desktop/animation.h"
 
+struct sway_layer_commit_stats sway_layer_commit_stats = {0};
+
 struct wlr_layer_surface_v1 *toplevel_layer_surface_from_surface(
 		struct wlr_surface *surface) {
 	struct wlr_layer_surface_v1 *layer;
@@ -78,30 +80,7 @@ static void arrange_surface(struct sway_output *output, const struct wlr_box *fu
 	}
 }
 
-void arrange_layers(struct sway_output *output) {
-	struct wlr_box usable_area = { 0 };
-	wlr_output_effective_resolution(output->wlr_output,
-			&usable_area.width, &usable_area.height);
-	const struct wlr_box full_area = usable_area;
-
-	arrange_surface(output, &full_area, &usable_area, output->layers.shell_overlay, true);
-	arrange_surface(output, &full_area, &usable_area, output->layers.shell_top, true);
-	arrange_surface(output, &full_area, &usable_area, output->layers.shell_bottom, true);
-	arrange_surface(output, &full_area, &usable_area, output->layers.shell_background, true);
-
-	arrange_surface(output, &full_area, &usable_area, output->layers.shell_overlay, false);
-	arrange_surface(output, &full_area, &usable_area, output->layers.shell_top, false);
-	arrange_surface(output, &full_area, &usable_area, output->layers.shell_bottom, false);
-	arrange_surface(output, &full_area, &usable_area, output->layers.shell_background, false);
-
-	if (!wlr_box_equal(&usable_area, &output->usable_area)) {
-		sway_log(SWAY_DEBUG, "Usable area changed, rearranging output");
-		output->usable_area = usable_area;
-		arrange_output(output);
-	} else {
-		arrange_popups(root->layers.popup);
-	}
-
+static void layers_update_keyboard_focus(struct sway_output *output) {
 	// Find topmost keyboard interactive layer, if such a layer exists
 	struct wlr_scene_tree *layers_above_shell[] = {
 		output->layers.shell_overlay,
@@ -140,6 +119,33 @@ void arrange_layers(struct sway_output *output) {
 	}
 }
 
+void arrange_layers(struct sway_output *output) {
+	struct wlr_box usable_area = { 0 };
+	wlr_output_effective_resolution(output->wlr_output,
+			&usable_area.width, &usable_area.height);
+	const struct wlr_box full_area = usable_area;
+
+	arrange_surface(output, &full_area, &usable_area, output->layers.shell_overlay, true);
+	arrange_surface(output, &full_area, &usable_area, output->layers.shell_top, true);
+	arrange_surface(output, &full_area, &usable_area, output->layers.shell_bottom, true);
+	arrange_surface(output, &full_area, &usable_area, output->layers.shell_background, true);
+
+	arrange_surface(output, &full_area, &usable_area, output->layers.shell_overlay, false);
+	arrange_surface(output, &full_area, &usable_area, output->layers.shell_top, false);
+	arrange_surface(output, &full_area, &usable_area, output->layers.shell_bottom, false);
+	arrange_surface(output, &full_area, &usable_area, output->layers.shell_background, false);
+
+	if (!wlr_box_equal(&usable_area, &output->usable_area)) {
+		sway_log(SWAY_DEBUG, "Usable area changed, rearranging output");
+		output->usable_area = usable_area;
+		arrange_output(output);
+	} else {
+		arrange_popups(root->layers.popup);
+	}
+
+	layers_update_keyboard_focus(output);
+}
+
 static struct wlr_scene_tree *sway_layer_get_scene(struct sway_output *output,
 		enum zwlr_layer_shell_v1_layer type) {
 	switch (type) {
@@ -264,31 +270,102 @@ static void handle_node_destroy(struct wl_listener *listener, void *data) {
 	free(layer);
 }
 
+// Layer surface state that differs from the one the layers were arranged
+// with, as a mask of enum wlr_layer_surface_v1_state_field. Clients often
+// send their whole state again with each commit, so the committed mask
+// alone doesn't tell what changed.
+static uint32_t layer_surface_changed(struct sway_layer_surface *surface) {
+	const struct wlr_layer_surface_v1_state *state = &surface->layer_surface->current;
+	const struct wlr_layer_surface_v1_state *arranged = &surface->arranged;
+	uint32_t changed = 0;
+	if (state->desired_width != arranged->desired_width ||
+			state->desired_height != arranged->desired_height) {
+		changed |= WLR_LAYER_SURFACE_V1_STATE_DESIRED_SIZE;
+	}
+	if (state->anchor != arranged->anchor) {
+		changed |= WLR_LAYER_SURFACE_V1_STATE_ANCHOR;
+	}
+	if (state->exclusive_zone != arranged->exclusive_zone) {
+		changed |= WLR_LAYER_SURFACE_V1_STATE_EXCLUSIVE_ZONE;
+	}
+	if (state->margin.top != arranged->margin.top ||
+			state->margin.right != arranged->margin.right ||
+			state->margin.bottom != arranged->margin.bottom ||
+			state->margin.left != arranged->margin.left) {
+		changed |= WLR_LAYER_SURFACE_V1_STATE_MARGIN;
+	}
+	if (state->keyboard_interactive != arranged->keyboard_interactive) {
+		changed |= WLR_LAYER_SURFACE_V1_STATE_KEYBOARD_INTERACTIVITY;
+	}
+	if (state->layer != arranged->layer) {
+		changed |= WLR_LAYER_SURFACE_V1_STATE_LAYER;
+	}
+	if (state->exclusive_edge != arranged->exclusive_edge) {
+		changed |= WLR_LAYER_SURFACE_V1_STATE_EXCLUSIVE_EDGE;
+	}
+	return changed;
+}
+
+// Configures a surface that doesn't reserve any space, which can't change
+// the usable area or the placement of other surfaces
+static void arrange_non_exclusive_surface(struct sway_layer_surface *surface) {
+	struct sway_output *output = surface->output;
+	struct wlr_box full_area = { 0 };
+	wlr_output_effective_resolution(output->wlr_output,
+			&full_area.width, &full_area.height);
+	struct wlr_box usable_area = output->usable_area;
+	wlr_scene_layer_surface_v1_configure(surface->scene, &full_area, &usable_area);
+	arrange_popups(root->layers.popup);
+}
+
 static void handle_surface_commit(struct wl_listener *listener, void *data) {
 	struct sway_layer_surface *surface =
 		wl_container_of(listener, surface, surface_commit);
+	++sway_layer_commit_stats.commits;
 
 	struct wlr_layer_surface_v1 *layer_surface = surface->layer_surface;
-	uint32_t committed = layer_surface->current.committed;
-	if (layer_surface->initialized && committed & WLR_LAYER_SURFACE_V1_STATE_LAYER) {
+	uint32_t changed = layer_surface_changed(surface);
+	bool was_exclusive = surface->arranged.exclusive_zone > 0;
+	surface->arranged = layer_surface->current;
+	if (layer_surface->initialized && changed & WLR_LAYER_SURFACE_V1_STATE_LAYER) {
 		enum zwlr_layer_shell_v1_layer layer_type = layer_surface->current.layer;
 		struct wlr_scene_tree *output_layer = sway_layer_get_scene(
 			surface->output, layer_type);
 		wlr_scene_node_reparent(&surface->scene->tree->node, output_layer);
 	}
 
-	if (layer_surface->initial_commit || committed || layer_surface->surface->mapped != surface->mapped) {
-		surface->mapped = layer_surface->surface->mapped;
-		if (committed & WLR_LAYER_SURFACE_V1_STATE_DESIRED_SIZE) {
-			surface->pending.width = layer_surface->current.desired_width;
-			surface->pending.height = layer_surface->current.desired_height;
-			node_set_dirty(&surface->node);
-			animation_set_type(ANIMATION_LAYER_SHELL);
-		}
+	bool map_changed = layer_surface->surface->mapped != surface->mapped;
+	if (!layer_surface->initial_commit && !map_changed && !changed) {
+		// Only the content changed, which the scene already shows
+		return;
+	}
+	surface->mapped = layer_surface->surface->mapped;
+	if (changed & WLR_LAYER_SURFACE_V1_STATE_DESIRED_SIZE) {
+		surface->pending.width = layer_surface->current.desired_width;
+		surface->pending.height = layer_surface->current.desired_height;
+		node_set_dirty(&surface->node);
+		animation_set_type(ANIMATION_LAYER_SHELL);
+	}
+
+	uint32_t geometry = changed & ~WLR_LAYER_SURFACE_V1_STATE_KEYBOARD_INTERACTIVITY;
+	bool exclusive = was_exclusive || layer_surface->current.exclusive_zone > 0;
+	if (layer_surface->initial_commit || map_changed || (geometry && exclusive)) {
+		++sway_layer_commit_stats.arranged;
 		arrange_layers(surface->output);
-		if (committed != (committed & WLR_LAYER_SURFACE_V1_STATE_KEYBOARD_INTERACTIVITY)) {
-			transaction_commit_dirty();
+	} else {
+		if (geometry) {
+			++sway_layer_commit_stats.configured;
+			arrange_non_exclusive_surface(surface);
 		}
+		if (changed & (WLR_LAYER_SURFACE_V1_STATE_KEYBOARD_INTERACTIVITY |
+				WLR_LAYER_SURFACE_V1_STATE_LAYER)) {
+			layers_update_keyboard_focus(surface->output);
+		}
+	}
+	if (geometry) {
+		transaction_commit_dirty();
+	}
+	if (layer_surface->initial_commit || map_changed || geometry) {
 		cursor_rebase_all();
 	}
 }
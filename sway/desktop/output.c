@@ -1,5 +1,6 @@
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 #include <strings.h>
 #include <time.h>
 #include <wayland-server-core.h>
@@ -21,6 +22,7 @@
 #include "sway/log.h"
 #include "sway/config.h"
 #include "sway/desktop/animation.h"
+#include "sway/desktop/frame_clock.h"
 #include "sway/desktop/transaction.h"
 #include "sway/input/input-manager.h"
 #include "sway/input/seat.h"
@@ -34,6 +36,7 @@
 #include "sway/tree/root.h"
 #include "sway/tree/view.h"
 #include "sway/tree/workspace.h"
+#include "util.h"
 
 #if WLR_HAS_DRM_BACKEND
 #include <wlr/backend/drm.h>
@@ -206,6 +209,56 @@ static void send_frame_done_iterator(struct wlr_scene_buffer *buffer,
 	}
 }
 
+// Surfaces of hidden views have no primary output, so they are skipped by
+// send_frame_done_iterator() and would never get frame callbacks again
+static void send_hidden_frame_done_iterator(struct wlr_scene_buffer *buffer,
+		int x, int y, void *user_data) {
+	struct timespec *when = user_data;
+	if (buffer->primary_output) {
+		return;
+	}
+
+	struct wlr_scene_surface *scene_surface = wlr_scene_surface_try_from_buffer(buffer);
+	if (scene_surface == NULL) {
+		return;
+	}
+	wlr_scene_surface_send_frame_done(scene_surface, when);
+}
+
+static int handle_hidden_frame_timer(void *data) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	struct sway_view *view;
+	wl_list_for_each(view, &server.hidden_views, hidden_link) {
+		wlr_scene_node_for_each_buffer(&view->content_tree->node,
+			send_hidden_frame_done_iterator, &now);
+	}
+
+	if (!wl_list_empty(&server.hidden_views)) {
+		output_schedule_hidden_frame_done();
+	}
+	return 0;
+}
+
+void output_schedule_hidden_frame_done(void) {
+	if (server.hidden_frame_timer == NULL) {
+		server.hidden_frame_timer = wl_event_loop_add_timer(server.wl_event_loop,
+			handle_hidden_frame_timer, NULL);
+		if (server.hidden_frame_timer == NULL) {
+			sway_log(SWAY_ERROR, "Failed to create the hidden frame timer");
+			return;
+		}
+	}
+
+	// A delay of 0 disarms the timer when the hidden views are paused
+	int delay = 0;
+	if (config->hidden_frame_rate > 0) {
+		delay = 1000 / config->hidden_frame_rate;
+	}
+	wl_event_source_timer_update(server.hidden_frame_timer, delay);
+}
+
 static enum wlr_scale_filter_mode get_scale_filter(struct sway_output *output,
 		struct wlr_scene_buffer *buffer) {
 	// if we are scaling down, we should always choose linear
@@ -235,6 +288,10 @@ void output_configure_scene(struct sway_output *output,
 		scene_descriptor_try_get(node, SWAY_SCENE_DESC_CONTAINER);
 	if (con) {
 		opacity = con->pending.alpha;
+		if (config->fullscreen_fast_path &&
+				con->pending.fullscreen_layout == FULLSCREEN_ENABLED) {
+			opacity = 1.0f;
+		}
 	}
 
 	if (node->type == WLR_SCENE_NODE_BUFFER) {
@@ -283,6 +340,78 @@ static bool output_can_tear(struct sway_output *output) {
 	return false;
 }
 
+/**
+ * Store the render and commit time of the previous frame. Must be called
+ * before building the next frame, which recycles the scene timer.
+ */
+static void render_time_add_sample(struct sway_output *output) {
+	if (output->render_time.commit_duration <= 0) {
+		return;
+	}
+	int64_t duration = wlr_scene_timer_get_duration_ns(&output->render_time.timer);
+	if (duration < output->render_time.commit_duration) {
+		// The GPU timer is unavailable or doesn't include the commit
+		duration = output->render_time.commit_duration;
+	}
+	output->render_time.commit_duration = 0;
+
+	output->render_time.samples[output->render_time.samples_idx] = duration;
+	output->render_time.samples_idx =
+		(output->render_time.samples_idx + 1) % RENDER_TIME_SAMPLES;
+	if (output->render_time.samples_len < RENDER_TIME_SAMPLES) {
+		output->render_time.samples_len++;
+	}
+}
+
+/**
+ * Compute max_render_time from the configured percentile of the measured
+ * render times. Returns 0 (composite right after refresh) until there are
+ * enough samples.
+ */
+static int render_time_compute(struct sway_output *output) {
+	int len = output->render_time.samples_len;
+	if (len < RENDER_TIME_SAMPLES / 4) {
+		return 0;
+	}
+	int64_t sorted[RENDER_TIME_SAMPLES];
+	memcpy(sorted, output->render_time.samples, len * sizeof(int64_t));
+	return frame_clock_max_render_time(sorted, len, output->render_time.percentile,
+		output->render_time.margin, output->refresh_nsec);
+}
+
+static void render_time_handle_present(struct sway_output *output,
+		const struct wlr_output_event_present *event) {
+	struct timespec *target = &output->render_time.target;
+	if (target->tv_sec == 0 && target->tv_nsec == 0) {
+		return;
+	}
+	int64_t late = timespec_to_nsec(&event->when) - timespec_to_nsec(target);
+	*target = (struct timespec){0};
+
+	output->render_time.frames++;
+	if (output->max_render_time != 0 && late > (int64_t)output->refresh_nsec / 2) {
+		output->render_time.missed++;
+		output->render_time.frames_since_miss = 0;
+		if (output->render_time.margin < 4) {
+			output->render_time.margin++;
+		}
+	} else if (++output->render_time.frames_since_miss >= 256) {
+		output->render_time.frames_since_miss = 0;
+		if (output->render_time.margin > 0) {
+			output->render_time.margin--;
+		}
+	}
+}
+
+static void frame_time_add_sample(struct sway_output *output, int64_t duration) {
+	output->frame_time.samples[output->frame_time.samples_idx] = duration;
+	output->frame_time.samples_idx =
+		(output->frame_time.samples_idx + 1) % FRAME_TIME_SAMPLES;
+	if (output->frame_time.samples_len < FRAME_TIME_SAMPLES) {
+		output->frame_time.samples_len++;
+	}
+}
+
 static int output_repaint_timer_handler(void *data) {
 	struct sway_output *output = data;
 
@@ -302,6 +431,13 @@ static int output_repaint_timer_handler(void *data) {
 		return 0;
 	}
 
+	struct timespec repaint_start;
+	clock_gettime(CLOCK_MONOTONIC, &repaint_start);
+	if (output->render_time.enabled) {
+		render_time_add_sample(output);
+		opts.timer = &output->render_time.timer;
+	}
+
 	struct wlr_output_state pending;
 	wlr_output_state_init(&pending);
 
@@ -323,7 +459,27 @@ static int output_repaint_timer_handler(void *data) {
 
 	if (!wlr_output_commit_state(output->wlr_output, &pending)) {
 		sway_log(SWAY_ERROR, "Page-flip failed on output %s", output->wlr_output->name);
-	} else if (animation_animating_output(output->wlr_output)) {
+		wlr_output_state_finish(&pending);
+		return 0;
+	}
+
+	struct timespec now, duration;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	timespec_sub(&duration, &now, &repaint_start);
+	frame_time_add_sample(output, timespec_to_nsec(&duration));
+
+	if (output->render_time.enabled) {
+		output->render_time.commit_duration = timespec_to_nsec(&duration);
+		// The frame should be presented on the first refresh after now
+		int64_t target;
+		if (frame_clock_predict(timespec_to_nsec(&now),
+				timespec_to_nsec(&output->last_presentation),
+				output->refresh_nsec, 0, &target)) {
+			timespec_from_nsec(&output->render_time.target, target);
+		}
+	}
+
+	if (animation_animating_output(output->wlr_output)) {
 		// During animation, schedule the next frame directly from the
 		// vblank-driven render path instead of relying solely on the
 		// independent 16ms animation timer. This keeps animation frames
@@ -342,6 +498,18 @@ static void handle_frame(struct wl_listener *listener, void *user_data) {
 		return;
 	}
 
+	server.transaction_stats.frames++;
+	transaction_flush();
+
+	// Interactive layout changes are committed and gestures move the scene
+	// once per refresh, before rendering
+	transaction_pacing_frame(output);
+	layout_scroll_frame(output);
+
+	if (output->render_time.enabled) {
+		output->max_render_time = render_time_compute(output);
+	}
+
 	// Compute predicted milliseconds until the next refresh. It's used for
 	// delaying both output rendering and surface frame callbacks.
 	int msec_until_refresh = 0;
@@ -478,6 +646,9 @@ static void begin_destroy(struct sway_output *output) {
 	wl_event_source_remove(output->repaint_timer);
 	output->repaint_timer = NULL;
 
+	wlr_scene_timer_finish(&output->render_time.timer);
+	output->render_time.timer = (struct wlr_scene_timer){0};
+
 	request_modeset();
 }
 
@@ -499,6 +670,10 @@ static void handle_present(struct wl_listener *listener, void *data) {
 		return;
 	}
 
+	if (output->render_time.enabled) {
+		render_time_handle_present(output, output_event);
+	}
+
 	output->last_presentation = output_event->when;
 	output->refresh_nsec = output_event->refresh;
 }
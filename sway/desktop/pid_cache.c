@@ -0,0 +1,222 @@
+#define _DEFAULT_SOURCE // syscall()
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "sway/desktop/pid_cache.h"
+#include "khashl.h"
+
+// Dead processes are only dropped when looked up again, so past this many
+// entries the ones that exited are pruned
+#define PID_CACHE_MAX 128
+
+struct pid_entry {
+	pid_t parent;
+	int pidfd;
+};
+
+static kh_inline khint_t pid_hash_fn(pid_t pid) {
+	return kh_hash_uint32((khint_t)pid);
+}
+
+static kh_inline int pid_eq_fn(pid_t a, pid_t b) {
+	return a == b;
+}
+
+KHASHL_MAP_INIT(KH_LOCAL, pid_map_t, pid_map, pid_t, struct pid_entry,
+	pid_hash_fn, pid_eq_fn)
+
+struct pid_cache {
+	char *proc_root;
+	pid_map_t *map;
+	struct pid_cache_stats stats;
+};
+
+struct pid_cache *pid_cache_create(const char *proc_root) {
+	struct pid_cache *cache = calloc(1, sizeof(struct pid_cache));
+	if (!cache) {
+		return NULL;
+	}
+	cache->proc_root = strdup(proc_root);
+	cache->map = pid_map_init();
+	if (!cache->proc_root || !cache->map) {
+		pid_cache_destroy(cache);
+		return NULL;
+	}
+	return cache;
+}
+
+void pid_cache_destroy(struct pid_cache *cache) {
+	if (!cache) {
+		return;
+	}
+	if (cache->map) {
+		khint_t k;
+		kh_foreach(cache->map, k) {
+			close(kh_val(cache->map, k).pidfd);
+		}
+		pid_map_destroy(cache->map);
+	}
+	free(cache->proc_root);
+	free(cache);
+}
+
+static int open_pidfd(pid_t pid) {
+#ifdef SYS_pidfd_open
+	return syscall(SYS_pidfd_open, pid, 0);
+#else
+	return -1;
+#endif
+}
+
+// A pidfd becomes readable once its process exits
+static bool process_exited(int pidfd) {
+	struct pollfd pollfd = { .fd = pidfd, .events = POLLIN };
+	return poll(&pollfd, 1, 0) != 0;
+}
+
+/**
+ * Read a file of a process with a single read, which is all procfs needs to
+ * return the whole of a small file.
+ */
+static ssize_t read_proc_file(struct pid_cache *cache, pid_t pid,
+		const char *name, char *buffer, size_t size) {
+	char path[PATH_MAX];
+	snprintf(path, sizeof(path), "%s/%d/%s", cache->proc_root, pid, name);
+	int fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		return -1;
+	}
+	ssize_t len = read(fd, buffer, size - 1);
+	close(fd);
+	if (len < 0) {
+		return -1;
+	}
+	buffer[len] = '\0';
+	return len;
+}
+
+static pid_t read_parent(struct pid_cache *cache, pid_t pid) {
+	char buffer[512];
+	cache->stats.reads++;
+	if (read_proc_file(cache, pid, "stat", buffer, sizeof(buffer)) < 0) {
+		return -1;
+	}
+
+	// The executable name can contain spaces and parentheses, the state and
+	// the parent pid follow the last parenthesis
+	char *name_end = strrchr(buffer, ')');
+	char state;
+	int parent;
+	if (!name_end || sscanf(name_end + 1, " %c %d", &state, &parent) != 2) {
+		return -1;
+	}
+	if (parent <= 0 || parent == pid) {
+		return -1;
+	}
+	return parent;
+}
+
+static void prune(struct pid_cache *cache) {
+	pid_t *exited = calloc(kh_size(cache->map), sizeof(pid_t));
+	size_t len = 0;
+	khint_t k;
+	kh_foreach(cache->map, k) {
+		int pidfd = kh_val(cache->map, k).pidfd;
+		if (!exited || process_exited(pidfd)) {
+			close(pidfd);
+			if (exited) {
+				exited[len++] = kh_key(cache->map, k);
+			}
+		}
+	}
+	if (!exited) {
+		pid_map_clear(cache->map);
+		return;
+	}
+	for (size_t i = 0; i < len; ++i) {
+		pid_map_del(cache->map, pid_map_get(cache->map, exited[i]));
+	}
+	free(exited);
+}
+
+pid_t pid_cache_get_parent(struct pid_cache *cache, pid_t pid) {
+	if (pid <= 0) {
+		return -1;
+	}
+
+	khint_t k = pid_map_get(cache->map, pid);
+	if (k != kh_end(cache->map)) {
+		struct pid_entry entry = kh_val(cache->map, k);
+		if (!process_exited(entry.pidfd)) {
+			cache->stats.hits++;
+			return entry.parent;
+		}
+		close(entry.pidfd);
+		pid_map_del(cache->map, k);
+	}
+
+	// Open the pidfd first: if the pid is reused after that, the pidfd says
+	// the process we read exited
+	int pidfd = open_pidfd(pid);
+	pid_t parent = read_parent(cache, pid);
+	if (pidfd < 0) {
+		return parent;
+	}
+	if (parent < 0 || process_exited(pidfd)) {
+		close(pidfd);
+		return parent;
+	}
+
+	if (kh_size(cache->map) >= PID_CACHE_MAX) {
+		prune(cache);
+	}
+	int absent;
+	k = pid_map_put(cache->map, pid, &absent);
+	if (absent < 0) {
+		close(pidfd);
+		return parent;
+	}
+	kh_val(cache->map, k) = (struct pid_entry){
+		.parent = parent,
+		.pidfd = pidfd,
+	};
+	return parent;
+}
+
+bool pid_cache_get_cgroup(struct pid_cache *cache, pid_t pid,
+		char *cgroup, size_t size) {
+	char buffer[4096];
+	if (pid <= 0 || read_proc_file(cache, pid, "cgroup", buffer, sizeof(buffer)) < 0) {
+		return false;
+	}
+
+	// The cgroup v2 hierarchy is the one with id 0 and no controllers
+	char *line = buffer;
+	while (line && strncmp(line, "0::", 3) != 0) {
+		line = strchr(line, '\n');
+		if (line) {
+			line++;
+		}
+	}
+	if (!line) {
+		return false;
+	}
+	char *path = line + 3;
+	size_t len = strcspn(path, "\n");
+	if (len == 0 || len >= size) {
+		return false;
+	}
+	memcpy(cgroup, path, len);
+	cgroup[len] = '\0';
+	return true;
+}
+
+void pid_cache_get_stats(struct pid_cache *cache, struct pid_cache_stats *stats) {
+	*stats = cache->stats;
+	stats->entries = kh_size(cache->map);
+}
@@ -1116,6 +1116,10 @@ static void arrange_container(struct sway_container *con,
 			wlr_scene_node_set_enabled(&con->title_bar.tree->node, false);
 		}
 
+		int scroll_x, scroll_y;
+		layout_scroll_get_scene_offset(workspace, con, &scroll_x, &scroll_y);
+		wlr_scene_node_set_position(&con->content_tree->node, scroll_x, scroll_y);
+
 		if (!root->filters->free_animation_activation_filter(workspace, root->filters->free_animation_activation_filter_data)) {
 			arrange_children(workspace, con->current.layout,
 				con->current.children, con->current.focused_inactive_child,
@@ -1198,7 +1202,8 @@ static void animate_fullscreen(struct wlr_scene_tree *tree,
 	animation_update_container(fs, fs->animation.w1, fs->animation.h1, t, x, y);
 	if (ws) {
 		struct sway_output *output = ws->output;
-		wlr_scene_node_set_position(&output->fullscreen_background->node, fs->animation.xt - output->lx, fs->animation.yt - output->ly);
+		wlr_scene_node_set_position(&output->fullscreen_background->node, fs->animation.xt - output->lx,
+			fs->animation.yt - output->ly + ws->animation.switch_y);
 		wlr_scene_rect_set_size(output->fullscreen_background, fs->animation.wt, fs->animation.ht);
 		wlr_scene_node_set_position(fs_node, fs->animation.xt - output->lx, fs->animation.yt - output->ly);
 		wlr_scene_node_set_position(&fs->view->output_handler->node, fs->animation.xt - output->lx, fs->animation.yt - output->ly);
@@ -1230,6 +1235,12 @@ static void scaled_floating_position(struct sway_workspace *ws, double scale,
 	*y_out = miny + scale * (y_in - woy);
 }
 
+// Sticky floaters stay in place while their workspace is switched away
+static int floating_switch_y(struct sway_workspace *ws,
+		struct sway_container *floater) {
+	return container_is_sticky_or_child(floater) ? 0 : ws->animation.switch_y;
+}
+
 static void arrange_workspace_floating(struct sway_workspace *ws) {
 	for (int i = 0; i < ws->current.floating->length; i++) {
 		struct sway_container *floater = ws->current.floating->items[i];
@@ -1264,15 +1275,16 @@ static void arrange_workspace_floating(struct sway_workspace *ws) {
 		wlr_scene_node_set_enabled(&floater->decoration.tree->node, true);
 
 		arrange_container(floater, true, ws->gaps_inner, ws);
+		int switch_y = floating_switch_y(ws, floater);
 		// Correct position when scaled
 		if (layout_scale_enabled(ws)) {
 			double x, y;
 			const float scale = layout_scale_get(ws);
 			scaled_floating_position(ws, scale, floater->animation.x0, floater->animation.y0, &x, &y);
-			wlr_scene_node_set_position(&floater->scene_tree->node, x, y);
+			wlr_scene_node_set_position(&floater->scene_tree->node, x, y + switch_y);
 		} else {
 			wlr_scene_node_set_position(&floater->scene_tree->node,
-				floater->animation.x0, floater->animation.y0);
+				floater->animation.x0, floater->animation.y0 + switch_y);
 		}
 	}
 }
@@ -1300,14 +1312,15 @@ static void animate_workspace_floating(struct sway_workspace *ws) {
 			child->scene_tree->node.info.wlr_output = NULL;
 		}
 		animation_update_container(child, ws->width, ws->height, t, x, y);
+		int switch_y = floating_switch_y(ws, child);
 		if (layout_scale_enabled(ws)) {
 			double x, y;
 			const float scale = layout_scale_get(ws);
 			scaled_floating_position(ws, scale, child->animation.xt, child->animation.yt, &x, &y);
-			wlr_scene_node_set_position(&child->scene_tree->node, x, y);
+			wlr_scene_node_set_position(&child->scene_tree->node, x, y + switch_y);
 		} else {
 			wlr_scene_node_set_position(&child->scene_tree->node,
-				child->animation.xt, child->animation.yt);
+				child->animation.xt, child->animation.yt + switch_y);
 		}
 		animate_container(child, child->animation.wt, child->animation.ht, true, ws->gaps_inner, ws);
 	}
@@ -1482,6 +1495,9 @@ static void arrange_output(struct sway_output *output) {
 			struct sway_container *fs = child->current.fullscreen;
 			wlr_scene_node_set_enabled(&child->layers.tiling->node, !fs && tiling);
 			wlr_scene_node_set_enabled(&child->layers.fullscreen->node, fs);
+			// Workspace switches translate the layer
+			wlr_scene_node_set_position(&child->layers.fullscreen->node,
+				0, child->animation.switch_y);
 
 			if ((child->split.split != WORKSPACE_SPLIT_NONE &&
 				(child->current.fullscreen || child->split.sibling->current.fullscreen)) ||
@@ -1506,8 +1522,11 @@ static void arrange_output(struct sway_output *output) {
 				struct wlr_box *area = workspace_get_output_usable_area(child);
 				struct side_gaps *gaps = &child->current_gaps;
 
+				int scroll_x, scroll_y;
+				layout_scroll_get_scene_offset(child, NULL, &scroll_x, &scroll_y);
 				wlr_scene_node_set_position(&child->layers.tiling->node,
-					gaps->left + area->x, gaps->top + area->y);
+					gaps->left + area->x + scroll_x,
+					gaps->top + area->y + scroll_y + child->animation.switch_y);
 
 				if (tiling) {
 					arrange_workspace_tiling(child,
@@ -1962,6 +1981,11 @@ static void transaction_progress(void) {
 		return;
 	}
 
+	if (server.paced_output) {
+		wlr_output_schedule_frame(server.paced_output->wlr_output);
+		return;
+	}
+
 	transaction_commit_pending();
 }
 
@@ -2046,6 +2070,7 @@ static void set_surface_preferred_buffer_scale(struct sway_view *view) {
 static void transaction_commit(struct sway_transaction *transaction) {
 	sway_log(SWAY_DEBUG, "Transaction %p committing with %i instructions",
 			transaction, transaction->instructions->length);
+	++server.transactions_committed;
 	transaction->num_waiting = 0;
 	for (int i = 0; i < transaction->instructions->length; ++i) {
 		struct sway_transaction_instruction *instruction =
@@ -2074,6 +2099,7 @@ static void transaction_commit(struct sway_transaction *transaction) {
 		node->instruction = instruction;
 	}
 	transaction->num_configures = transaction->num_waiting;
+	server.transaction_stats.configures += transaction->num_configures;
 	if (debug.txn_timings) {
 		clock_gettime(CLOCK_MONOTONIC, &transaction->commit_time);
 	}
@@ -2103,6 +2129,10 @@ static void transaction_commit(struct sway_transaction *transaction) {
 static void save_animation_variables();
 
 static void transaction_commit_pending(void) {
+	if (server.transaction_idle) {
+		wl_event_source_remove(server.transaction_idle);
+		server.transaction_idle = NULL;
+	}
 	if (server.queued_transaction) {
 		return;
 	}
@@ -2311,6 +2341,13 @@ static void overview_recompute_scales() {
 	}
 }
 
+static void handle_transaction_idle(void *data) {
+	server.transaction_idle = NULL;
+	if (server.pending_transaction) {
+		transaction_commit_pending();
+	}
+}
+
 static void _transaction_commit_dirty(bool server_request, bool delayed,
 		bool disable_animations) {
 	if (!server.dirty_nodes->length) {
@@ -2319,6 +2356,11 @@ static void _transaction_commit_dirty(bool server_request, bool delayed,
 
 	overview_recompute_scales();
 
+	if (server.pending_transaction &&
+			server.pending_transaction->disable_animations != disable_animations) {
+		// The changes coalesced so far keep their own animations
+		transaction_flush();
+	}
 	if (!server.pending_transaction) {
 		server.pending_transaction = transaction_create();
 		if (!server.pending_transaction) {
@@ -2338,7 +2380,27 @@ static void _transaction_commit_dirty(bool server_request, bool delayed,
 		return;
 	}
 
-	transaction_commit_pending();
+	if (server.paced_output) {
+		// It will be committed by transaction_pacing_frame()
+		wlr_output_schedule_frame(server.paced_output->wlr_output);
+		return;
+	}
+
+	if (disable_animations || debug.txn_nocoalesce || server.queued_transaction) {
+		// A queued transaction commits the pending one when it's applied
+		transaction_commit_pending();
+		return;
+	}
+
+	if (server.transaction_idle) {
+		server.transaction_stats.coalesced++;
+		return;
+	}
+	server.transaction_idle = wl_event_loop_add_idle(server.wl_event_loop,
+		handle_transaction_idle, NULL);
+	if (!server.transaction_idle) {
+		transaction_commit_pending();
+	}
 }
 
 void transaction_commit_dirty(void) {
@@ -2353,6 +2415,17 @@ void transaction_commit_dirty_delayed(void) {
 	_transaction_commit_dirty(true, true, false);
 }
 
+void transaction_flush(void) {
+	if (!server.transaction_idle) {
+		return;
+	}
+	wl_event_source_remove(server.transaction_idle);
+	server.transaction_idle = NULL;
+	if (server.pending_transaction) {
+		transaction_commit_pending();
+	}
+}
+
 void transaction_commit_delayed(void) {
 	if (!server.pending_transaction) {
 		return;
@@ -2363,3 +2436,24 @@ void transaction_commit_delayed(void) {
 void transaction_commit_dirty_disable_animations() {
 	_transaction_commit_dirty(true, false, true);
 }
+
+void transaction_pacing_begin(struct sway_output *output) {
+	server.paced_output = output && output->enabled ? output : NULL;
+}
+
+void transaction_pacing_end(void) {
+	if (!server.paced_output) {
+		return;
+	}
+	server.paced_output = NULL;
+	if (server.pending_transaction) {
+		transaction_commit_pending();
+	}
+}
+
+void transaction_pacing_frame(struct sway_output *output) {
+	if (server.paced_output != output || !server.pending_transaction) {
+		return;
+	}
+	transaction_commit_pending();
+}
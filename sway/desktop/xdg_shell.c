@@ -22,13 +22,13 @@
 
 static struct sway_xdg_popup *popup_create(
 	struct wlr_xdg_popup *wlr_popup, struct sway_view *view,
-	struct wlr_scene_tree *parent, struct wlr_scene_tree *image_capture_parent);
+	struct wlr_scene_tree *parent, struct sway_xdg_popup *parent_popup);
 
 static void popup_handle_new_popup(struct wl_listener *listener, void *data) {
 	struct sway_xdg_popup *popup =
 		wl_container_of(listener, popup, new_popup);
 	struct wlr_xdg_popup *wlr_popup = data;
-	popup_create(wlr_popup, popup->view, popup->xdg_surface_tree, popup->image_capture_tree);
+	popup_create(wlr_popup, popup->view, popup->xdg_surface_tree, popup);
 }
 
 static void popup_handle_destroy(struct wl_listener *listener, void *data) {
@@ -38,10 +38,22 @@ static void popup_handle_destroy(struct wl_listener *listener, void *data) {
 	wl_list_remove(&popup->destroy.link);
 	wl_list_remove(&popup->surface_commit.link);
 	wl_list_remove(&popup->reposition.link);
+	wl_list_remove(&popup->link);
 	wlr_scene_node_destroy(&popup->scene_tree->node);
 	free(popup);
 }
 
+static void popup_create_image_capture_tree(struct sway_xdg_popup *popup) {
+	struct sway_xdg_shell_view *xdg_shell_view =
+		wl_container_of(popup->view, xdg_shell_view, view);
+	struct wlr_scene_tree *parent = popup->parent ?
+		popup->parent->image_capture_tree : xdg_shell_view->image_capture_tree;
+	if (parent) {
+		popup->image_capture_tree =
+			wlr_scene_xdg_surface_create(parent, popup->wlr_xdg_popup->base);
+	}
+}
+
 static void popup_unconstrain(struct sway_xdg_popup *popup) {
 	struct sway_view *view = popup->view;
 	struct wlr_xdg_popup *wlr_popup = popup->wlr_xdg_popup;
@@ -83,7 +95,7 @@ static void popup_handle_reposition(struct wl_listener *listener, void *data) {
 
 static struct sway_xdg_popup *popup_create(struct wlr_xdg_popup *wlr_popup,
 		struct sway_view *view, struct wlr_scene_tree *parent,
-		struct wlr_scene_tree *image_capture_parent) {
+		struct sway_xdg_popup *parent_popup) {
 	struct wlr_xdg_surface *xdg_surface = wlr_popup->base;
 
 	struct sway_xdg_popup *popup = calloc(1, sizeof(struct sway_xdg_popup));
@@ -93,6 +105,7 @@ static struct sway_xdg_popup *popup_create(struct wlr_xdg_popup *wlr_popup,
 
 	popup->wlr_xdg_popup = wlr_popup;
 	popup->view = view;
+	popup->parent = parent_popup;
 
 	popup->scene_tree = wlr_scene_tree_create(parent);
 	if (!popup->scene_tree) {
@@ -119,15 +132,12 @@ static struct sway_xdg_popup *popup_create(struct wlr_xdg_popup *wlr_popup,
 		return NULL;
 	}
 
-	popup->image_capture_tree = wlr_scene_xdg_surface_create(image_capture_parent, xdg_surface);
-	if (popup->image_capture_tree == NULL) {
-		return NULL;
-	}
-
 	popup->wlr_xdg_popup = xdg_surface->popup;
 	struct sway_xdg_shell_view *shell_view =
 		wl_container_of(view, shell_view, view);
 	xdg_surface->data = shell_view;
+	wl_list_insert(shell_view->popups.prev, &popup->link);
+	popup_create_image_capture_tree(popup);
 
 	wl_signal_add(&xdg_surface->surface->events.commit, &popup->surface_commit);
 	popup->surface_commit.notify = popup_handle_surface_commit;
@@ -229,6 +239,19 @@ static void set_resizing(struct sway_view *view, bool resizing) {
 	wlr_xdg_toplevel_set_resizing(view->wlr_xdg_toplevel, resizing);
 }
 
+static void set_suspended(struct sway_view *view, bool suspended) {
+	if (xdg_shell_view_from_view(view) == NULL) {
+		return;
+	}
+	struct wlr_xdg_toplevel *toplevel = view->wlr_xdg_toplevel;
+	// The scene may hide the view while it is being unmapped
+	if (!toplevel->base->initialized || wl_resource_get_version(toplevel->resource) <
+			XDG_TOPLEVEL_STATE_SUSPENDED_SINCE_VERSION) {
+		return;
+	}
+	wlr_xdg_toplevel_set_suspended(toplevel, suspended);
+}
+
 static bool wants_floating(struct sway_view *view) {
 	struct wlr_xdg_toplevel *toplevel = view->wlr_xdg_toplevel;
 	struct wlr_xdg_toplevel_state *state = &toplevel->current;
@@ -267,6 +290,32 @@ static void close_popups(struct sway_view *view) {
 	}
 }
 
+static void set_image_capture(struct sway_view *view, bool enabled) {
+	struct sway_xdg_shell_view *xdg_shell_view =
+		xdg_shell_view_from_view(view);
+	if (xdg_shell_view == NULL) {
+		return;
+	}
+	struct sway_xdg_popup *popup;
+	if (!enabled) {
+		// The trees are destroyed along with the scene
+		xdg_shell_view->image_capture_tree = NULL;
+		wl_list_for_each(popup, &xdg_shell_view->popups, link) {
+			popup->image_capture_tree = NULL;
+		}
+		return;
+	}
+	if (view->wlr_xdg_toplevel == NULL) {
+		return;
+	}
+	xdg_shell_view->image_capture_tree = wlr_scene_xdg_surface_create(
+		&view->image_capture_scene->tree, view->wlr_xdg_toplevel->base);
+	// Parents come first, so their trees already exist
+	wl_list_for_each(popup, &xdg_shell_view->popups, link) {
+		popup_create_image_capture_tree(popup);
+	}
+}
+
 static void destroy(struct sway_view *view) {
 	struct sway_xdg_shell_view *xdg_shell_view =
 		xdg_shell_view_from_view(view);
@@ -285,6 +334,8 @@ static const struct sway_view_impl view_impl = {
 	.set_tiled = set_tiled,
 	.set_fullscreen = set_fullscreen,
 	.set_resizing = set_resizing,
+	.set_suspended = set_suspended,
+	.set_image_capture = set_image_capture,
 	.wants_floating = wants_floating,
 	.is_transient_for = is_transient_for,
 	.close = _close,
@@ -404,7 +455,7 @@ static void handle_new_popup(struct wl_listener *listener, void *data) {
 	struct wlr_xdg_popup *wlr_popup = data;
 
 	struct sway_xdg_popup *popup = popup_create(wlr_popup,
-		&xdg_shell_view->view, root->layers.popup, xdg_shell_view->image_capture_tree);
+		&xdg_shell_view->view, root->layers.popup, NULL);
 	if (!popup) {
 		return;
 	}
@@ -655,8 +706,7 @@ void handle_xdg_shell_toplevel(struct wl_listener *listener, void *data) {
 	wl_signal_add(&xdg_toplevel->events.destroy, &xdg_shell_view->destroy);
 
 	wlr_scene_xdg_surface_create(xdg_shell_view->view.content_tree, xdg_toplevel->base);
-	xdg_shell_view->image_capture_tree =
-		wlr_scene_xdg_surface_create(&xdg_shell_view->view.image_capture_scene->tree, xdg_toplevel->base);
+	wl_list_init(&xdg_shell_view->popups);
 
 	xdg_toplevel->base->data = xdg_shell_view;
 }
@@ -507,6 +507,20 @@ static void get_constraints(struct sway_view *view, double *min_width,
 	*max_height = size_hints->max_height > 0 ? size_hints->max_height : DBL_MAX;
 }
 
+static void set_image_capture(struct sway_view *view, bool enabled) {
+	struct sway_xwayland_view *xwayland_view = xwayland_view_from_view(view);
+	if (xwayland_view == NULL) {
+		return;
+	}
+	if (!enabled) {
+		// Destroyed along with the scene
+		xwayland_view->image_capture_scene_surface = NULL;
+	} else if (view->surface) {
+		xwayland_view->image_capture_scene_surface =
+			wlr_scene_surface_create(&view->image_capture_scene->tree, view->surface);
+	}
+}
+
 static const struct sway_view_impl view_impl = {
 	.get_constraints = get_constraints,
 	.get_string_prop = get_string_prop,
@@ -515,6 +529,7 @@ static const struct sway_view_impl view_impl = {
 	.set_activated = set_activated,
 	.set_tiled = set_tiled,
 	.set_fullscreen = set_fullscreen,
+	.set_image_capture = set_image_capture,
 	.wants_floating = wants_floating,
 	.is_transient_for = is_transient_for,
 	.close = _close,
@@ -612,8 +627,10 @@ static void handle_unmap(struct wl_listener *listener, void *data) {
 	wl_list_remove(&xwayland_view->commit.link);
 	wl_list_remove(&xwayland_view->surface_tree_destroy.link);
 
-	wlr_scene_node_destroy(&xwayland_view->image_capture_scene_surface->buffer->node);
-	xwayland_view->image_capture_scene_surface = NULL;
+	if (xwayland_view->image_capture_scene_surface) {
+		wlr_scene_node_destroy(&xwayland_view->image_capture_scene_surface->buffer->node);
+		xwayland_view->image_capture_scene_surface = NULL;
+	}
 
 	if (xwayland_view->surface_tree) {
 		wlr_scene_node_destroy(&xwayland_view->surface_tree->node);
@@ -657,8 +674,10 @@ static void handle_map(struct wl_listener *listener, void *data) {
 			&xwayland_view->surface_tree_destroy);
 	}
 
-	xwayland_view->image_capture_scene_surface =
-		wlr_scene_surface_create(&xwayland_view->view.image_capture_scene->tree, xsurface->surface);
+	if (view->image_capture_scene) {
+		xwayland_view->image_capture_scene_surface =
+			wlr_scene_surface_create(&view->image_capture_scene->tree, xsurface->surface);
+	}
 
 	transaction_commit_dirty();
 }
@@ -17,7 +17,9 @@
 #include <wlr/types/wlr_xcursor_manager.h>
 #include <wlr/util/region.h>
 #include "config.h"
+#include "list.h"
 #include "sway/log.h"
+#include "stringop.h"
 #include "util.h"
 #include "sway/commands.h"
 #include "sway/input/cursor.h"
@@ -1113,7 +1115,7 @@ void sway_cursor_destroy(struct sway_cursor *cursor) {
 	wl_list_remove(&cursor->tool_button.link);
 	wl_list_remove(&cursor->request_set_cursor.link);
 
-	wlr_xcursor_manager_destroy(cursor->xcursor_manager);
+	xcursor_manager_release(cursor->xcursor_manager);
 	wlr_cursor_destroy(cursor->cursor);
 	free(cursor);
 }
@@ -1481,3 +1483,79 @@ void handle_request_set_cursor_shape(struct wl_listener *listener, void *data) {
 
 	cursor_set_image(seat->cursor, wlr_cursor_shape_v1_name(event->shape), focused_client);
 }
+
+struct xcursor_cache_entry {
+	struct wlr_xcursor_manager *manager;
+	int refs;
+};
+
+static list_t *xcursor_cache = NULL; // struct xcursor_cache_entry
+
+struct wlr_xcursor_manager *xcursor_manager_acquire(const char *theme,
+		uint32_t size) {
+	if (!xcursor_cache) {
+		xcursor_cache = create_list();
+	}
+	for (int i = 0; i < xcursor_cache->length; ++i) {
+		struct xcursor_cache_entry *entry = xcursor_cache->items[i];
+		if (entry->manager->size == size &&
+				lenient_strcmp(entry->manager->name, theme) == 0) {
+			entry->refs++;
+			return entry->manager;
+		}
+	}
+
+	struct xcursor_cache_entry *entry = calloc(1, sizeof(*entry));
+	if (!sway_assert(entry, "could not allocate xcursor cache entry")) {
+		return NULL;
+	}
+	entry->manager = wlr_xcursor_manager_create(theme, size);
+	if (!entry->manager) {
+		free(entry);
+		return NULL;
+	}
+	entry->refs = 1;
+	list_add(xcursor_cache, entry);
+	return entry->manager;
+}
+
+void xcursor_manager_release(struct wlr_xcursor_manager *manager) {
+	if (!manager || !xcursor_cache) {
+		return;
+	}
+	for (int i = 0; i < xcursor_cache->length; ++i) {
+		struct xcursor_cache_entry *entry = xcursor_cache->items[i];
+		if (entry->manager != manager) {
+			continue;
+		}
+		if (--entry->refs == 0) {
+			wlr_xcursor_manager_destroy(entry->manager);
+			list_del(xcursor_cache, i);
+			free(entry);
+		}
+		return;
+	}
+}
+
+void xcursor_cache_get_stats(struct sway_xcursor_cache_stats *stats) {
+	*stats = (struct sway_xcursor_cache_stats){0};
+	if (!xcursor_cache) {
+		return;
+	}
+	stats->managers = xcursor_cache->length;
+	for (int i = 0; i < xcursor_cache->length; ++i) {
+		struct xcursor_cache_entry *entry = xcursor_cache->items[i];
+		struct wlr_xcursor_manager_theme *theme;
+		wl_list_for_each(theme, &entry->manager->scaled_themes, link) {
+			stats->themes++;
+			stats->cursors += theme->theme->cursor_count;
+			for (unsigned int j = 0; j < theme->theme->cursor_count; ++j) {
+				struct wlr_xcursor *xcursor = theme->theme->cursors[j];
+				for (unsigned int k = 0; k < xcursor->image_count; ++k) {
+					struct wlr_xcursor_image *image = xcursor->images[k];
+					stats->bytes += (size_t)image->width * image->height * 4;
+				}
+			}
+		}
+	}
+}
@@ -709,11 +709,12 @@ void input_manager_configure_xcursor(void) {
 	}
 }
 
-struct input_config *input_device_get_config(struct sway_input_device *device) {
+static struct input_config *find_device_config(struct sway_config *cfg,
+		struct sway_input_device *device) {
 	struct input_config *wildcard_config = NULL;
 	struct input_config *input_config = NULL;
-	for (int i = 0; i < config->input_configs->length; ++i) {
-		input_config = config->input_configs->items[i];
+	for (int i = 0; i < cfg->input_configs->length; ++i) {
+		input_config = cfg->input_configs->items[i];
 		if (strcmp(input_config->identifier, device->identifier) == 0) {
 			return input_config;
 		} else if (strcmp(input_config->identifier, "*") == 0) {
@@ -722,8 +723,8 @@ struct input_config *input_device_get_config(struct sway_input_device *device) {
 	}
 
 	const char *device_type = input_device_get_type(device);
-	for (int i = 0; i < config->input_type_configs->length; ++i) {
-		input_config = config->input_type_configs->items[i];
+	for (int i = 0; i < cfg->input_type_configs->length; ++i) {
+		input_config = cfg->input_type_configs->items[i];
 		if (strcmp(input_config->identifier + 5, device_type) == 0) {
 			return input_config;
 		}
@@ -731,3 +732,100 @@ struct input_config *input_device_get_config(struct sway_input_device *device) {
 
 	return wildcard_config;
 }
+
+struct input_config *input_device_get_config(struct sway_input_device *device) {
+	return find_device_config(config, device);
+}
+
+// The bindings a keyboard repeats or waits to release belong to the old
+// config, which is freed once the new one is applied
+static void keyboard_forget_bindings(struct sway_keyboard *keyboard) {
+	if (!keyboard) {
+		return;
+	}
+	sway_keyboard_disarm_key_repeat(keyboard);
+	keyboard->held_binding = NULL;
+}
+
+void input_manager_apply_reloaded_configs(struct sway_config *old_config) {
+	struct sway_reload_stats *stats = &config->reload_stats;
+	struct timespec start;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	input_manager_verify_fallback_seat();
+
+	struct sway_seat *seat;
+	wl_list_for_each(seat, &server.input->seats, link) {
+		struct sway_seat_device *seat_device;
+		wl_list_for_each(seat_device, &seat->devices, link) {
+			keyboard_forget_bindings(seat_device->keyboard);
+		}
+		struct sway_keyboard_group *group;
+		wl_list_for_each(group, &seat->keyboard_groups, link) {
+			keyboard_forget_bindings(group->seat_device->keyboard);
+		}
+	}
+
+	// Devices attach to seats depending on the seat configs, so any change
+	// there resets everything as before. Otherwise only the devices whose
+	// effective input config differs are reset and reconfigured.
+	bool seats_changed =
+		!seat_configs_equal(old_config->seat_configs, config->seat_configs);
+
+	list_t *changed = create_list();
+	bool keyboard_changed = false;
+	struct sway_input_device *input_device = NULL;
+	wl_list_for_each(input_device, &server.input->devices, link) {
+		if (seats_changed || !input_config_equal(
+				find_device_config(old_config, input_device),
+				find_device_config(config, input_device))) {
+			list_add(changed, input_device);
+			keyboard_changed |=
+				input_device->wlr_device->type == WLR_INPUT_DEVICE_KEYBOARD;
+		}
+	}
+
+	if (changed->length > 0) {
+		// Avoid spamming configuration updates for all keyboard devices
+		if (keyboard_changed) {
+			wl_list_for_each(seat, &server.input->seats, link) {
+				wlr_seat_set_keyboard(seat->wlr_seat, NULL);
+			}
+		}
+		for (int i = 0; i < changed->length; ++i) {
+			input_manager_reset_input(changed->items[i]);
+		}
+		wl_list_for_each(seat, &server.input->seats, link) {
+			struct sway_keyboard_group *group;
+			wl_list_for_each(group, &seat->keyboard_groups, link) {
+				sway_keyboard_disarm_key_repeat(group->seat_device->keyboard);
+			}
+		}
+		for (int i = 0; i < changed->length; ++i) {
+			input_manager_configure_input(changed->items[i]);
+		}
+	}
+	stats->inputs_reset = changed->length;
+	list_free(changed);
+
+	// The bindings were parsed anew and need the keysyms of the configured
+	// layout, whether or not the layout itself changed.
+	for (int i = 0; i < config->input_configs->length; ++i) {
+		retranslate_keysyms(config->input_configs->items[i]);
+	}
+	for (int i = 0; i < config->input_type_configs->length; ++i) {
+		retranslate_keysyms(config->input_type_configs->items[i]);
+	}
+
+	stats->inputs = config_reload_lap(&start);
+
+	stats->seats_applied = 0;
+	if (seats_changed) {
+		for (int i = 0; i < config->seat_configs->length; ++i) {
+			input_manager_apply_seat_config(config->seat_configs->items[i]);
+		}
+		stats->seats_applied = config->seat_configs->length;
+	}
+
+	stats->seats = config_reload_lap(&start);
+}
@@ -879,50 +879,216 @@ static void handle_xkb_context_log(struct xkb_context *context,
 	}
 }
 
-struct xkb_keymap *sway_keyboard_compile_keymap(struct input_config *ic,
-		char **error) {
-	struct xkb_context *context = xkb_context_new(XKB_CONTEXT_NO_SECURE_GETENV);
-	if (!sway_assert(context, "cannot create XKB context")) {
-		return NULL;
+/**
+ * Compiled keymaps are shared by every keyboard, keyboard group and keysym
+ * translation state using the same rule names or xkb file content, across
+ * reloads. All of them use a single XKB context.
+ */
+#define KEYMAP_CACHE_SIZE 16
+
+struct keymap_cache_entry {
+	char *rules, *model, *layout, *variant, *options;
+	char *xkb_file; // content, not the path
+	uint64_t xkb_file_hash;
+	struct xkb_keymap *keymap;
+};
+
+static struct {
+	struct xkb_context *context;
+	list_t *entries; // struct keymap_cache_entry, most recently used first
+} keymap_cache;
+
+static uint64_t keymap_cache_hash(const char *data) {
+	// FNV-1a
+	uint64_t hash = 0xcbf29ce484222325;
+	for (const char *c = data; *c; ++c) {
+		hash ^= (unsigned char)*c;
+		hash *= 0x100000001b3;
 	}
-	xkb_context_set_user_data(context, error);
-	xkb_context_set_log_fn(context, handle_xkb_context_log);
+	return hash;
+}
 
-	struct xkb_keymap *keymap = NULL;
+static void keymap_cache_entry_destroy(struct keymap_cache_entry *entry) {
+	free(entry->rules);
+	free(entry->model);
+	free(entry->layout);
+	free(entry->variant);
+	free(entry->options);
+	free(entry->xkb_file);
+	xkb_keymap_unref(entry->keymap);
+	free(entry);
+}
 
-	if (ic && ic->xkb_file) {
-		FILE *keymap_file = fopen(ic->xkb_file, "r");
-		if (!keymap_file) {
-			sway_log_errno(SWAY_ERROR, "cannot read xkb file %s", ic->xkb_file);
-			if (error) {
-				*error = format_str("cannot read xkb file %s: %s",
-					ic->xkb_file, strerror(errno));
-			}
-			goto cleanup;
+static bool keymap_cache_entry_match(struct keymap_cache_entry *entry,
+		const struct xkb_rule_names *rules, const char *xkb_file,
+		uint64_t xkb_file_hash) {
+	if (xkb_file || entry->xkb_file) {
+		return xkb_file && entry->xkb_file &&
+			entry->xkb_file_hash == xkb_file_hash &&
+			strcmp(entry->xkb_file, xkb_file) == 0;
+	}
+	return lenient_strcmp(entry->rules, rules->rules) == 0 &&
+		lenient_strcmp(entry->model, rules->model) == 0 &&
+		lenient_strcmp(entry->layout, rules->layout) == 0 &&
+		lenient_strcmp(entry->variant, rules->variant) == 0 &&
+		lenient_strcmp(entry->options, rules->options) == 0;
+}
+
+static struct xkb_context *keymap_cache_get_context(void) {
+	if (!keymap_cache.context) {
+		keymap_cache.context = xkb_context_new(XKB_CONTEXT_NO_SECURE_GETENV);
+		if (!sway_assert(keymap_cache.context, "cannot create XKB context")) {
+			return NULL;
 		}
+		xkb_context_set_log_fn(keymap_cache.context, handle_xkb_context_log);
+		keymap_cache.entries = create_list();
+	}
+	return keymap_cache.context;
+}
 
-		keymap = xkb_keymap_new_from_file(context, keymap_file,
-					XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS);
+// Returns a new reference to the keymap, compiling it if it isn't cached
+static struct xkb_keymap *keymap_cache_get(const struct xkb_rule_names *rules,
+		const char *xkb_file, char **error) {
+	struct xkb_context *context = keymap_cache_get_context();
+	if (!context) {
+		return NULL;
+	}
 
-		if (fclose(keymap_file) != 0) {
-			sway_log_errno(SWAY_ERROR, "Failed to close xkb file %s",
-					ic->xkb_file);
+	uint64_t xkb_file_hash = xkb_file ? keymap_cache_hash(xkb_file) : 0;
+	for (int i = 0; i < keymap_cache.entries->length; ++i) {
+		struct keymap_cache_entry *entry = keymap_cache.entries->items[i];
+		if (keymap_cache_entry_match(entry, rules, xkb_file, xkb_file_hash)) {
+			list_del(keymap_cache.entries, i);
+			list_insert(keymap_cache.entries, 0, entry);
+			return xkb_keymap_ref(entry->keymap);
 		}
+	}
+
+	xkb_context_set_user_data(context, error);
+	struct xkb_keymap *keymap;
+	if (xkb_file) {
+		keymap = xkb_keymap_new_from_string(context, xkb_file,
+			XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS);
 	} else {
-		struct xkb_rule_names rules = {0};
-		if (ic) {
-			input_config_fill_rule_names(ic, &rules);
-		}
-		keymap = xkb_keymap_new_from_names(context, &rules,
+		keymap = xkb_keymap_new_from_names(context, rules,
 			XKB_KEYMAP_COMPILE_NO_FLAGS);
 	}
-
-cleanup:
 	xkb_context_set_user_data(context, NULL);
-	xkb_context_unref(context);
+	if (!keymap) {
+		return NULL;
+	}
+
+	struct keymap_cache_entry *entry = calloc(1, sizeof(*entry));
+	if (!entry) {
+		return keymap;
+	}
+	if (xkb_file) {
+		entry->xkb_file = strdup(xkb_file);
+		entry->xkb_file_hash = xkb_file_hash;
+	} else {
+		entry->rules = rules->rules ? strdup(rules->rules) : NULL;
+		entry->model = rules->model ? strdup(rules->model) : NULL;
+		entry->layout = rules->layout ? strdup(rules->layout) : NULL;
+		entry->variant = rules->variant ? strdup(rules->variant) : NULL;
+		entry->options = rules->options ? strdup(rules->options) : NULL;
+	}
+	entry->keymap = xkb_keymap_ref(keymap);
+	list_insert(keymap_cache.entries, 0, entry);
+
+	if (keymap_cache.entries->length > KEYMAP_CACHE_SIZE) {
+		int last = keymap_cache.entries->length - 1;
+		keymap_cache_entry_destroy(keymap_cache.entries->items[last]);
+		list_del(keymap_cache.entries, last);
+	}
 	return keymap;
 }
 
+void sway_keyboard_keymap_cache_invalidate(void) {
+	if (!keymap_cache.context) {
+		return;
+	}
+	// Keymaps compiled from rule names depend on files in the XKB include
+	// path, which may have changed. Those compiled from an xkb file are keyed
+	// by its content and stay valid.
+	for (int i = keymap_cache.entries->length - 1; i >= 0; --i) {
+		struct keymap_cache_entry *entry = keymap_cache.entries->items[i];
+		if (!entry->xkb_file) {
+			keymap_cache_entry_destroy(entry);
+			list_del(keymap_cache.entries, i);
+		}
+	}
+}
+
+void sway_keyboard_keymap_cache_finish(void) {
+	if (!keymap_cache.context) {
+		return;
+	}
+	for (int i = 0; i < keymap_cache.entries->length; ++i) {
+		keymap_cache_entry_destroy(keymap_cache.entries->items[i]);
+	}
+	list_free(keymap_cache.entries);
+	keymap_cache.entries = NULL;
+	xkb_context_unref(keymap_cache.context);
+	keymap_cache.context = NULL;
+}
+
+static char *read_xkb_file(const char *path, char **error) {
+	FILE *keymap_file = fopen(path, "r");
+	if (!keymap_file) {
+		sway_log_errno(SWAY_ERROR, "cannot read xkb file %s", path);
+		if (error) {
+			*error = format_str("cannot read xkb file %s: %s",
+				path, strerror(errno));
+		}
+		return NULL;
+	}
+
+	char *content = NULL;
+	size_t size = 0;
+	if (getdelim(&content, &size, '\0', keymap_file) < 0 && !ferror(keymap_file)) {
+		// Empty file, let xkbcommon report it
+		free(content);
+		content = strdup("");
+	} else if (ferror(keymap_file)) {
+		sway_log_errno(SWAY_ERROR, "cannot read xkb file %s", path);
+		if (error) {
+			*error = format_str("cannot read xkb file %s: %s",
+				path, strerror(errno));
+		}
+		free(content);
+		content = NULL;
+	}
+
+	if (fclose(keymap_file) != 0) {
+		sway_log_errno(SWAY_ERROR, "Failed to close xkb file %s", path);
+	}
+	return content;
+}
+
+struct xkb_keymap *sway_keyboard_compile_keymap_from_names(
+		const struct xkb_rule_names *rules, char **error) {
+	return keymap_cache_get(rules, NULL, error);
+}
+
+struct xkb_keymap *sway_keyboard_compile_keymap(struct input_config *ic,
+		char **error) {
+	if (ic && ic->xkb_file) {
+		char *content = read_xkb_file(ic->xkb_file, error);
+		if (!content) {
+			return NULL;
+		}
+		struct xkb_keymap *keymap = keymap_cache_get(NULL, content, error);
+		free(content);
+		return keymap;
+	}
+
+	struct xkb_rule_names rules = {0};
+	if (ic) {
+		input_config_fill_rule_names(ic, &rules);
+	}
+	return keymap_cache_get(&rules, NULL, error);
+}
+
 static bool repeat_info_match(struct sway_keyboard *a, struct wlr_keyboard *b) {
 	return a->repeat_rate == b->repeat_info.rate &&
 		a->repeat_delay == b->repeat_info.delay;
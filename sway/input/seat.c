@@ -1004,10 +1004,10 @@ void seat_configure_xcursor(struct sway_seat *seat) {
 					cursor_theme) ||
 				server.xwayland.xcursor_manager->size != cursor_size)) {
 
-			wlr_xcursor_manager_destroy(server.xwayland.xcursor_manager);
+			xcursor_manager_release(server.xwayland.xcursor_manager);
 
 			server.xwayland.xcursor_manager =
-				wlr_xcursor_manager_create(cursor_theme, cursor_size);
+				xcursor_manager_acquire(cursor_theme, cursor_size);
 			sway_assert(server.xwayland.xcursor_manager,
 						"Cannot create XCursor manager for theme");
 
@@ -1032,9 +1032,9 @@ void seat_configure_xcursor(struct sway_seat *seat) {
 				seat->cursor->xcursor_manager, cursor_theme) ||
 			seat->cursor->xcursor_manager->size != cursor_size) {
 
-		wlr_xcursor_manager_destroy(seat->cursor->xcursor_manager);
+		xcursor_manager_release(seat->cursor->xcursor_manager);
 		seat->cursor->xcursor_manager =
-			wlr_xcursor_manager_create(cursor_theme, cursor_size);
+			xcursor_manager_acquire(cursor_theme, cursor_size);
 		if (!seat->cursor->xcursor_manager) {
 			sway_log(SWAY_ERROR,
 				"Cannot create XCursor manager for theme '%s'", cursor_theme);
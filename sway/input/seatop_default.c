@@ -1160,7 +1160,8 @@ static void handle_swipe_update(struct sway_seat *seat,
 static void handle_swipe_end(struct sway_seat *seat,
 		struct wlr_pointer_swipe_end_event *event) {
 	if (config->gesture_scroll_enable) {
-		if (layout_scroll_end(seat)) {
+		bool kinetic = config->gesture_scroll_kinetic && !event->cancelled;
+		if (layout_scroll_end(seat, kinetic)) {
 			return;
 		}
 	}
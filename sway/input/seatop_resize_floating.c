@@ -29,6 +29,7 @@ static void handle_button(struct sway_seat *seat, uint32_t time_msec,
 		container_set_resizing(con, false);
 		container_floating_move_to(con, con->pending.x, con->pending.y, true);
 		arrange_container(con); // Send configure w/o resizing hint
+		transaction_pacing_end();
 		animation_set_type(ANIMATION_WINDOW_SIZE);
 		transaction_commit_dirty();
 		seatop_begin_default(seat);
@@ -156,10 +157,15 @@ static void handle_unref(struct sway_seat *seat, struct sway_container *con) {
 	}
 }
 
+static void handle_end(struct sway_seat *seat) {
+	transaction_pacing_end();
+}
+
 static const struct sway_seatop_impl seatop_impl = {
 	.button = handle_button,
 	.pointer_motion = handle_pointer_motion,
 	.unref = handle_unref,
+	.end = handle_end,
 };
 
 void seatop_begin_resize_floating(struct sway_seat *seat,
@@ -192,6 +198,8 @@ void seatop_begin_resize_floating(struct sway_seat *seat,
 	container_raise_floating(con);
 	animation_set_type(ANIMATION_DISABLED);
 	transaction_commit_dirty();
+	transaction_pacing_begin(con->pending.workspace ?
+		con->pending.workspace->output : NULL);
 
 	const char *image = edge == WLR_EDGE_NONE ?
 		"se-resize" : wlr_xcursor_get_resize_name(edge);
@@ -63,6 +63,7 @@ static void handle_button(struct sway_seat *seat, uint32_t time_msec,
 			arrange_workspace(e->con->pending.workspace);
 			layout_tiling_resize_callback(e->con);
 		}
+		transaction_pacing_end();
 		animation_set_type(ANIMATION_WINDOW_SIZE);
 		transaction_commit_dirty();
 		seatop_begin_default(seat);
@@ -104,10 +105,15 @@ static void handle_unref(struct sway_seat *seat, struct sway_container *con) {
 	}
 }
 
+static void handle_end(struct sway_seat *seat) {
+	transaction_pacing_end();
+}
+
 static const struct sway_seatop_impl seatop_impl = {
 	.button = handle_button,
 	.pointer_motion = handle_pointer_motion,
 	.unref = handle_unref,
+	.end = handle_end,
 };
 
 void seatop_begin_resize_tiling(struct sway_seat *seat,
@@ -155,5 +161,7 @@ void seatop_begin_resize_tiling(struct sway_seat *seat,
 
 	animation_set_type(ANIMATION_DISABLED);
 	transaction_commit_dirty();
+	transaction_pacing_begin(e->con->pending.workspace ?
+		e->con->pending.workspace->output : NULL);
 	wlr_seat_pointer_notify_clear_focus(seat->wlr_seat);
 }
@@ -1,4 +1,5 @@
 #include <wlr/types/wlr_cursor.h>
+#include "sway/desktop/transaction.h"
 #include "sway/input/cursor.h"
 #include "sway/input/seat.h"
 #include "sway/tree/layout.h"
@@ -14,7 +15,7 @@ static void finalize_move(struct sway_seat *seat) {
 	struct wlr_cursor *cursor = seat->cursor->cursor;
 	layout_scroll_update(seat, cursor->x - e->x, cursor->y - e->y, config->gesture_scroll_sentitivity_mouse);
 
-	layout_scroll_end(seat);
+	layout_scroll_end(seat, false);
 
 	seatop_begin_default(seat);
 }
@@ -43,10 +44,15 @@ static void handle_unref(struct sway_seat *seat, struct sway_container *con) {
 	}
 }
 
+static void handle_end(struct sway_seat *seat) {
+	transaction_pacing_end();
+}
+
 static const struct sway_seatop_impl seatop_impl = {
 	.button = handle_button,
 	.pointer_motion = handle_pointer_motion,
 	.unref = handle_unref,
+	.end = handle_end,
 };
 
 void seatop_begin_scroll_tiling(struct sway_seat *seat,
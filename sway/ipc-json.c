@@ -411,6 +411,46 @@ static void ipc_json_describe_enabled_output(struct sway_output *output,
 	}
 
 	json_object_object_add(object, "max_render_time", json_object_new_int(output->max_render_time));
+	json_object_object_add(object, "max_render_time_auto",
+		json_object_new_boolean(output->render_time.enabled));
+	if (output->render_time.enabled) {
+		json_object *render_time = json_object_new_object();
+		json_object_object_add(render_time, "percentile",
+			json_object_new_int(output->render_time.percentile));
+		json_object_object_add(render_time, "frames",
+			json_object_new_int64(output->render_time.frames));
+		json_object_object_add(render_time, "missed",
+			json_object_new_int64(output->render_time.missed));
+		double miss_rate = output->render_time.frames > 0 ?
+			(double)output->render_time.missed / output->render_time.frames : 0.0;
+		json_object_object_add(render_time, "miss_rate",
+			json_object_new_double(miss_rate));
+		json_object_object_add(object, "render_time", render_time);
+	}
+	if (output->scene_output) {
+		json_object *scanout = json_object_new_object();
+		json_object_object_add(scanout, "status", json_object_new_string(
+			wlr_scene_scanout_status_name(output->scene_output->scanout.status)));
+		json_object_object_add(scanout, "frames",
+			json_object_new_int64(output->scene_output->scanout.frames));
+		json_object_object_add(scanout, "scanout_frames",
+			json_object_new_int64(output->scene_output->scanout.scanout_frames));
+		json_object_object_add(object, "scanout", scanout);
+
+		json_object *frame = json_object_new_object();
+		json_object_object_add(frame, "entries",
+			json_object_new_int(output->scene_output->last_frame.entries));
+		json_object_object_add(frame, "damage_area",
+			json_object_new_int64(output->scene_output->last_frame.damage_area));
+		json_object_object_add(object, "last_frame", frame);
+
+		json_object *blur = json_object_new_object();
+		json_object_object_add(blur, "refreshes",
+			json_object_new_int64(output->scene_output->blur.refreshes));
+		json_object_object_add(blur, "area",
+			json_object_new_int64(output->scene_output->blur.area));
+		json_object_object_add(object, "blur", blur);
+	}
 	json_object_object_add(object, "allow_tearing", json_object_new_boolean(output->allow_tearing));
 	json_object_object_add(object, "hdr", json_object_new_boolean(output->hdr));
 }
@@ -579,6 +619,8 @@ static void ipc_json_describe_view(struct sway_container *c, json_object *object
 	bool fully_visible = view_is_fully_visible(c->view);
 	json_object_object_add(object, "fully_visible", json_object_new_boolean(fully_visible));
 
+	json_object_object_add(object, "suspended", json_object_new_boolean(c->view->hidden));
+
 	bool has_titlebar = c->title_bar.tree->node.enabled;
 	struct wlr_box window_box = {
 		c->pending.content_x - c->pending.x,
@@ -942,6 +942,23 @@ void ipc_client_handle_command(struct ipc_client *client, uint32_t payload_lengt
 	{
 		json_object *json = json_object_new_object();
 		json_object_object_add(json, "config", json_object_new_string(config->current_config));
+		struct sway_reload_stats *stats = &config->reload_stats;
+		if (stats->count > 0) {
+			json_object *reload = json_object_new_object();
+			json_object_object_add(reload, "count", json_object_new_int(stats->count));
+			json_object_object_add(reload, "validate", json_object_new_double(stats->validate));
+			json_object_object_add(reload, "parse", json_object_new_double(stats->parse));
+			json_object_object_add(reload, "inputs", json_object_new_double(stats->inputs));
+			json_object_object_add(reload, "seats", json_object_new_double(stats->seats));
+			json_object_object_add(reload, "outputs", json_object_new_double(stats->outputs));
+			json_object_object_add(reload, "bars", json_object_new_double(stats->bars));
+			json_object_object_add(reload, "total", json_object_new_double(stats->total));
+			json_object_object_add(reload, "inputs_reset", json_object_new_int(stats->inputs_reset));
+			json_object_object_add(reload, "seats_applied", json_object_new_int(stats->seats_applied));
+			json_object_object_add(reload, "swaybg_kept", json_object_new_boolean(stats->swaybg_kept));
+			json_object_object_add(reload, "modeset", json_object_new_boolean(stats->modeset));
+			json_object_object_add(json, "reload", reload);
+		}
 		const char *json_string = json_object_to_json_string(json);
 		ipc_send_reply(client, payload_type, json_string,
 			(uint32_t)strlen(json_string));
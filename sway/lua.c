@@ -13,8 +13,11 @@
 #include "sway/desktop/animation.h"
 #include "sway/desktop/launcher.h"
 #include "sway/ipc-server.h"
+#include "sway/layers.h"
+#include "sway/input/cursor.h"
 #include "sway/desktop/transaction.h"
 #include "sway/server.h"
+#include "sway/sway_text_node.h"
 #include "stringop.h"
 
 #if 0
@@ -545,7 +548,7 @@ static int scroll_exec_process(lua_State *L) {
 	}
 
 	if (ctx != NULL) {
-		ctx->pid = child;
+		launcher_ctx_set_pid(ctx, child);
 		lua_newtable(L);
 		lua_pushinteger(L, ctx->pid);
 		lua_setfield(L, -2, "pid");
@@ -1931,8 +1934,98 @@ static int scroll_remove_callback(lua_State *L) {
 	return 0;
 }
 
+static int scroll_output_get_frame_times(lua_State *L) {
+	int argc = lua_gettop(L);
+	if (argc == 0) {
+		lua_createtable(L, 0, 0);
+		return 1;
+	}
+	struct sway_output *output = lua_to_output(L, -1);
+	if (!output) {
+		lua_createtable(L, 0, 0);
+		return 1;
+	}
+	int len = output->frame_time.samples_len;
+	int first = (output->frame_time.samples_idx - len + FRAME_TIME_SAMPLES) %
+		FRAME_TIME_SAMPLES;
+	lua_createtable(L, len, 0);
+	for (int i = 0; i < len; ++i) {
+		lua_pushinteger(L,
+			output->frame_time.samples[(first + i) % FRAME_TIME_SAMPLES]);
+		lua_rawseti(L, -2, i + 1);
+	}
+	return 1;
+}
+
+static int scroll_transactions_committed(lua_State *L) {
+	lua_pushinteger(L, server.transactions_committed);
+	return 1;
+}
+
+struct lua_stat {
+	const char *name;
+	uint64_t value;
+};
+
+// Pushes a table of counters keyed by name
+static int push_stats(lua_State *L, const struct lua_stat *stats, size_t len) {
+	lua_createtable(L, 0, (int)len);
+	for (size_t i = 0; i < len; ++i) {
+		lua_pushinteger(L, stats[i].value);
+		lua_setfield(L, -2, stats[i].name);
+	}
+	return 1;
+}
+
+static int scroll_transaction_stats(lua_State *L) {
+	struct lua_stat stats[] = {
+		{ "committed", server.transactions_committed },
+		{ "coalesced", server.transaction_stats.coalesced },
+		{ "configures", server.transaction_stats.configures },
+		{ "frames", server.transaction_stats.frames },
+	};
+	return push_stats(L, stats, sizeof(stats) / sizeof(stats[0]));
+}
+
+static int scroll_animation_clock_stats(lua_State *L) {
+	struct lua_stat stats[] = {
+		{ "predicted", animation_clock_stats.predicted },
+		{ "fallback", animation_clock_stats.fallback },
+	};
+	return push_stats(L, stats, sizeof(stats) / sizeof(stats[0]));
+}
+
+static int scroll_text_render_stats(lua_State *L) {
+	struct lua_stat stats[] = {
+		{ "rendered", sway_text_node_stats.rendered },
+		{ "deferred", sway_text_node_stats.deferred },
+	};
+	return push_stats(L, stats, sizeof(stats) / sizeof(stats[0]));
+}
+
+static int scroll_layer_shell_commit_stats(lua_State *L) {
+	struct lua_stat stats[] = {
+		{ "commits", sway_layer_commit_stats.commits },
+		{ "arranged", sway_layer_commit_stats.arranged },
+		{ "configured", sway_layer_commit_stats.configured },
+	};
+	return push_stats(L, stats, sizeof(stats) / sizeof(stats[0]));
+}
+
+static int scroll_cursor_theme_stats(lua_State *L) {
+	struct sway_xcursor_cache_stats cache;
+	xcursor_cache_get_stats(&cache);
+	struct lua_stat stats[] = {
+		{ "managers", cache.managers },
+		{ "themes", cache.themes },
+		{ "cursors", cache.cursors },
+		{ "bytes", cache.bytes },
+	};
+	return push_stats(L, stats, sizeof(stats) / sizeof(stats[0]));
+}
+
 static int scroll_animating(lua_State *L) {
-	lua_pushboolean(L, animation_animating());
+	lua_pushboolean(L, animation_animating() || layout_scroll_kinetic());
 	return 1;
 }
 
@@ -2015,6 +2108,7 @@ static luaL_Reg const scroll_lib[] = {
 	{ "output_get_name", scroll_output_get_name },
 	{ "output_get_active_workspace", scroll_output_get_active_workspace },
 	{ "output_get_workspaces", scroll_output_get_workspaces },
+	{ "output_get_frame_times", scroll_output_get_frame_times },
 	{ "root_get_outputs", scroll_root_get_outputs },
 	{ "scratchpad_get_containers", scroll_scratchpad_get_containers },
 	{ "scratchpad_show", scroll_scratchpad_show },
@@ -2023,6 +2117,12 @@ static luaL_Reg const scroll_lib[] = {
 	{ "remove_callback", scroll_remove_callback },
 	{ "animating", scroll_animating },
 	{ "pending_transactions", scroll_pending_transactions },
+	{ "transactions_committed", scroll_transactions_committed },
+	{ "transaction_stats", scroll_transaction_stats },
+	{ "animation_clock_stats", scroll_animation_clock_stats },
+	{ "text_render_stats", scroll_text_render_stats },
+	{ "layer_shell_commit_stats", scroll_layer_shell_commit_stats },
+	{ "cursor_theme_stats", scroll_cursor_theme_stats },
 	{ NULL, NULL }
 };
 /* clang-format on */
@@ -23,6 +23,7 @@
 #include "sway/swaynag.h"
 #include "sway/desktop/transaction.h"
 #include "sway/desktop/animation.h"
+#include "sway/input/keyboard.h"
 #include "sway/tree/root.h"
 #include "sway/tree/node.h"
 #include "sway/ipc-server.h"
@@ -205,6 +206,8 @@ void enable_debug_flag(const char *flag) {
 		debug.txn_wait = true;
 	} else if (strcmp(flag, "txn-timings") == 0) {
 		debug.txn_timings = true;
+	} else if (strcmp(flag, "txn-nocoalesce") == 0) {
+		debug.txn_nocoalesce = true;
 	} else if (has_prefix(flag, "txn-timeout=")) {
 		server.txn_timeout_ms = atoi(&flag[strlen("txn-timeout=")]);
 	} else {
@@ -438,6 +441,7 @@ shutdown:
 
 	free(config_path);
 	free_config(config);
+	sway_keyboard_keymap_cache_finish();
 
 	if (nag_gpu.client != NULL) {
 		wl_client_destroy(nag_gpu.client);
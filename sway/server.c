@@ -17,6 +17,7 @@
 #include <wlr/types/wlr_cursor_shape_v1.h>
 #include <wlr/types/wlr_data_control_v1.h>
 #include <wlr/types/wlr_ext_data_control_v1.h>
+#include <wlr/types/wlr_ext_background_effect_v1.h>
 #include <wlr/types/wlr_data_device.h>
 #include <wlr/types/wlr_export_dmabuf_v1.h>
 #include <wlr/types/wlr_ext_foreign_toplevel_list_v1.h>
@@ -57,6 +58,7 @@
 #include "sway/log.h"
 #include "sway/config.h"
 #include "sway/desktop/idle_inhibit_v1.h"
+#include "sway/desktop/launcher.h"
 #include "sway/input/input-manager.h"
 #include "sway/output.h"
 #include "sway/server.h"
@@ -75,7 +77,7 @@
 #include <wlr/types/wlr_drm_lease_v1.h>
 #endif
 
-#define SWAY_XDG_SHELL_VERSION 5
+#define SWAY_XDG_SHELL_VERSION 6
 #define SWAY_LAYER_SHELL_VERSION 5
 #define SWAY_FOREIGN_TOPLEVEL_LIST_VERSION 1
 #define SWAY_PRESENTATION_VERSION 2
@@ -233,19 +235,17 @@ static void handle_new_foreign_toplevel_capture_request(struct wl_listener *list
 	struct wlr_ext_foreign_toplevel_image_capture_source_manager_v1_request_event *request = data;
 	struct sway_view *view = request->toplevel_handle->data;
 
-	if (view->image_capture_source == NULL) {
-		view->image_capture_source = wlr_ext_image_capture_source_v1_create_with_scene_node(
-			&view->image_capture_scene->tree.node, server.wl_event_loop, server.allocator, server.renderer);
-		if (view->image_capture_source == NULL) {
-			return;
-		}
+	struct wlr_ext_image_capture_source_v1 *source = view_get_image_capture_source(view);
+	if (source == NULL) {
+		return;
 	}
 
-	wlr_ext_foreign_toplevel_image_capture_source_manager_v1_request_accept(request, view->image_capture_source);
+	wlr_ext_foreign_toplevel_image_capture_source_manager_v1_request_accept(request, source);
 }
 
 bool server_init(struct sway_server *server) {
 	node_map_init();
+	launcher_init();
 	sway_log(SWAY_DEBUG, "Initializing Wayland server");
 	server->wl_display = wl_display_create();
 	if (!server->wl_display) {
@@ -439,6 +439,11 @@ bool server_init(struct sway_server *server) {
 		sway_log(SWAY_ERROR, "Failed to create alpha modifier");
 		return false;
 	}
+	if (!wlr_ext_background_effect_manager_v1_create(server->wl_display, 1,
+			EXT_BACKGROUND_EFFECT_MANAGER_V1_CAPABILITY_BLUR)) {
+		sway_log(SWAY_ERROR, "Failed to create background effect manager");
+		return false;
+	}
 
 	server->output_manager_v1 =
 		wlr_output_manager_v1_create(server->wl_display);
@@ -710,6 +715,8 @@ bool server_init(struct sway_server *server) {
 		return false;
 	}
 
+	wl_list_init(&server->hidden_views);
+
 	server->input = input_manager_create(server);
 	if (!server->input) {
 		sway_log(SWAY_ERROR, "Failed to create input manager");
@@ -754,6 +761,15 @@ void server_fini(struct sway_server *server) {
 		wlr_xwayland_destroy(server->xwayland.wlr_xwayland);
 	}
 #endif
+	if (server->transaction_idle) {
+		wl_event_source_remove(server->transaction_idle);
+		server->transaction_idle = NULL;
+	}
+	if (server->hidden_frame_timer) {
+		wl_event_source_remove(server->hidden_frame_timer);
+		server->hidden_frame_timer = NULL;
+	}
+	launcher_fini();
 	wl_display_destroy_clients(server->wl_display);
 	wlr_backend_destroy(server->backend);
 	wl_display_destroy(server->wl_display);
@@ -8,8 +8,11 @@
 #include "cairo_util.h"
 #include "pango.h"
 #include "sway/config.h"
+#include "sway/server.h"
 #include "sway/sway_text_node.h"
 
+struct sway_text_node_stats sway_text_node_stats = {0};
+
 struct cairo_buffer {
 	struct wlr_buffer base;
 	cairo_surface_t *surface;
@@ -53,6 +56,12 @@ struct text_buffer {
 	double content_scale;
 	enum wl_output_subpixel subpixel;
 
+	// Changes made while the node is not on any output are only recorded,
+	// and applied once it becomes visible again
+	bool dirty; // the backing buffer is out of date
+	bool size_dirty; // the text has to be measured again
+	struct wl_event_source *idle;
+
 	struct wl_listener outputs_update;
 	struct wl_listener destroy;
 };
@@ -65,10 +74,20 @@ static int get_text_width(struct sway_text_node *props) {
 	return MAX(width, 0);
 }
 
+static void update_dest_size(struct text_buffer *buffer) {
+	wlr_scene_buffer_set_dest_size(buffer->buffer_node,
+		get_text_width(&buffer->props) * buffer->content_scale,
+		buffer->props.height * buffer->content_scale);
+}
+
 static void render_backing_buffer(struct text_buffer *buffer) {
-	if (!buffer->visible) {
+	if (!buffer->visible || buffer->size_dirty) {
+		buffer->dirty = true;
+		sway_text_node_stats.deferred++;
 		return;
 	}
+	buffer->dirty = false;
+	sway_text_node_stats.rendered++;
 
 	if (buffer->props.max_width == 0) {
 		wlr_scene_buffer_set_buffer(buffer->buffer_node, NULL);
@@ -151,10 +170,37 @@ err:
 	cairo_font_options_destroy(fo);
 }
 
+static void text_calc_size(struct text_buffer *buffer);
+
+static void handle_measure_idle(void *data) {
+	struct text_buffer *buffer = data;
+	buffer->idle = NULL;
+	if (!buffer->size_dirty) {
+		return;
+	}
+
+	int width = buffer->props.width;
+	text_calc_size(buffer);
+	buffer->dirty = true;
+	if (buffer->props.width != width && buffer->props.resized) {
+		buffer->props.resized(&buffer->props, buffer->props.resized_data);
+	}
+	if (buffer->dirty) {
+		render_backing_buffer(buffer);
+	}
+}
+
 static void handle_outputs_update(struct wl_listener *listener, void *data) {
 	struct text_buffer *buffer = wl_container_of(listener, buffer, outputs_update);
 	struct wlr_scene_outputs_update_event *event = data;
 
+	if (event->size == 0) {
+		// Hidden, likely on the same outputs once shown again: keep the
+		// scale and subpixel layout so the buffer is still up to date then
+		buffer->visible = false;
+		return;
+	}
+
 	float scale = 0;
 	enum wl_output_subpixel subpixel = WL_OUTPUT_SUBPIXEL_UNKNOWN;
 
@@ -177,11 +223,22 @@ static void handle_outputs_update(struct wl_listener *listener, void *data) {
 		}
 	}
 
-	buffer->visible = event->size > 0;
+	buffer->visible = true;
 
 	if (scale != buffer->scale || subpixel != buffer->subpixel) {
 		buffer->scale = scale;
 		buffer->subpixel = subpixel;
+		buffer->dirty = true;
+	}
+
+	if (buffer->size_dirty) {
+		// The owner may have to arrange around the new size, which is not
+		// safe while the scene is updating outputs
+		if (!buffer->idle) {
+			buffer->idle = wl_event_loop_add_idle(server.wl_event_loop,
+				handle_measure_idle, buffer);
+		}
+	} else if (buffer->dirty) {
 		render_backing_buffer(buffer);
 	}
 }
@@ -191,6 +248,9 @@ static void handle_destroy(struct wl_listener *listener, void *data) {
 
 	wl_list_remove(&buffer->outputs_update.link);
 	wl_list_remove(&buffer->destroy.link);
+	if (buffer->idle) {
+		wl_event_source_remove(buffer->idle);
+	}
 
 	free(buffer->text);
 	free(buffer);
@@ -198,6 +258,7 @@ static void handle_destroy(struct wl_listener *listener, void *data) {
 
 static void text_calc_size(struct text_buffer *buffer) {
 	struct sway_text_node *props = &buffer->props;
+	buffer->size_dirty = false;
 
 	cairo_surface_t *recorder = cairo_recording_surface_create(
 		CAIRO_CONTENT_COLOR_ALPHA, NULL);
@@ -213,8 +274,7 @@ static void text_calc_size(struct text_buffer *buffer) {
 	get_text_size(c, config->font_description, &props->width, NULL,
 		&props->baseline, 1, props->pango_markup, "%s", buffer->text);
 
-	wlr_scene_buffer_set_dest_size(buffer->buffer_node,
-		get_text_width(props), props->height);
+	update_dest_size(buffer);
 out:
 	cairo_destroy(c);
 }
@@ -283,6 +343,14 @@ void sway_text_node_set_text(struct sway_text_node *node, char *text) {
 	free(buffer->text);
 	buffer->text = new_text;
 
+	if (!buffer->visible && node->resized) {
+		// Measured once visible, the owner is told if the size changes
+		buffer->size_dirty = true;
+		buffer->dirty = true;
+		sway_text_node_stats.deferred++;
+		return;
+	}
+
 	text_calc_size(buffer);
 	render_backing_buffer(buffer);
 }
@@ -293,8 +361,7 @@ void sway_text_node_set_max_width(struct sway_text_node *node, int max_width) {
 		return;
 	}
 	buffer->props.max_width = max_width;
-	wlr_scene_buffer_set_dest_size(buffer->buffer_node,
-		get_text_width(&buffer->props), buffer->props.height);
+	update_dest_size(buffer);
 	render_backing_buffer(buffer);
 }
 
@@ -309,9 +376,11 @@ void sway_text_node_set_background(struct sway_text_node *node, float background
 
 void sway_text_node_scale(struct sway_text_node *node, double scale) {
 	struct text_buffer *buffer = wl_container_of(node, buffer, props);
+	if (scale == buffer->content_scale) {
+		return;
+	}
 	buffer->content_scale = scale;
-	wlr_scene_buffer_set_dest_size(buffer->buffer_node,
-		get_text_width(&buffer->props) * scale, buffer->props.height * scale);
+	update_dest_size(buffer);
 	render_backing_buffer(buffer);
 }
 
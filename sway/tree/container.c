@@ -405,6 +405,11 @@ void container_arrange_title_bar(struct sway_container *con) {
 	container_update(con);
 }
 
+static void handle_title_bar_text_resized(struct sway_text_node *node, void *data) {
+	struct sway_container *con = data;
+	container_arrange_title_bar(con);
+}
+
 void container_update_marks(struct sway_container *con) {
 	char *buffer = NULL;
 
@@ -444,6 +449,10 @@ void container_update_marks(struct sway_container *con) {
 
 		con->title_bar.marks_text = sway_text_node_create(con->title_bar.tree,
 			buffer, colors->text, false);
+		if (con->title_bar.marks_text) {
+			con->title_bar.marks_text->resized = handle_title_bar_text_resized;
+			con->title_bar.marks_text->resized_data = con;
+		}
 	} else {
 		sway_text_node_set_text(con->title_bar.marks_text, buffer);
 	}
@@ -466,6 +475,10 @@ void container_update_title_bar(struct sway_container *con) {
 
 	con->title_bar.title_text = sway_text_node_create(con->title_bar.tree,
 		con->formatted_title, colors->text, config->pango_markup);
+	if (con->title_bar.title_text) {
+		con->title_bar.title_text->resized = handle_title_bar_text_resized;
+		con->title_bar.title_text->resized_data = con;
+	}
 
 	// we always have to remake these text buffers completely for text font
 	// changes etc...
@@ -5,6 +5,8 @@
 #include "sway/sway_text_node.h"
 #include "sway/input/seat.h"
 #include "util.h"
+#include <math.h>
+#include <time.h>
 #include <wayland-util.h>
 #include "sway/input/keyboard.h"
 #include "sway/desktop/transaction.h"
@@ -14,6 +16,7 @@
 #include <libevdev/libevdev.h>
 #include "sway/desktop/animation.h"
 #include "sway/criteria.h"
+#include "sway/tree/overlap.h"
 
 struct sway_trails {
 	list_t *trails;
@@ -464,6 +467,7 @@ void layout_overview_workspaces_recompute_scale() {
 		struct sway_output *output = root->outputs->items[i];
 		overview_workspaces_recompute_scale(output);
 	}
+	wlr_scene_update_visibility(root->root_scene);
 }
 
 void layout_overview_workspaces(bool on) {
@@ -497,6 +501,8 @@ void layout_overview_workspaces(bool on) {
 			output_damage_whole(output);
 		}
 	}
+	// Occlusion is computed where nodes are displayed, which has just changed
+	wlr_scene_update_visibility(root->root_scene);
 }
 
 bool layout_overview_workspaces_map_coordinates(struct sway_workspace **workspace, double *lx, double *ly) {
@@ -2197,12 +2203,27 @@ static int compare_id(const void *data1, const void *data2) {
 	return con2->node.id - con1->node.id;
 }
 
-static struct sway_container *organize_maximum_overlap(struct sway_workspace *workspace,
+static int organize_tiled_overlaps(struct sway_workspace *workspace,
+		struct sway_container *container) {
+	// When computing the overlap with a tiling container, I need to use the
+	// children for the bounding box, but don't need to verify the children,
+	// because they don't overlap.
+	int over = 0;
+	for (int i = 0; i < workspace->tiling->length; ++i) {
+		struct sway_container *con = workspace->tiling->items[i];
+		if (!root->filters->container_filter(con->pending.workspace, con, root->filters->container_filter_data)) {
+			continue;
+		}
+		over += overlapping_containers(container, con);
+	}
+	return over;
+}
+
+static void organize_deoverlap(struct sway_workspace *workspace,
 		bool tiling_enabled, bool floating_enabled) {
-	struct sway_container *max_con = NULL;
-	// When computing the maximum overlap with a tiling container, I need
-	// to use the children for the bounding box, but don't need to verify
-	// the children, because they don't overlap.
+	// Repeatedly move the floating container that overlaps with the most
+	// containers until none overlaps. Tiled containers don't move, so only
+	// the overlaps of the moved container need updating after each step.
 	// To get deterministic positions in the overview, the order of testing
 	// matters in case two windows overlap with the same number of containers.
 	// And, because floating windows change their position in
@@ -2211,50 +2232,27 @@ static struct sway_container *organize_maximum_overlap(struct sway_workspace *wo
 	list_t *ordered = create_list();
 	list_cat(ordered, workspace->floating);
 	list_qsort(ordered, compare_id);
-	int max_over = 0;
+	struct overlap_set *set = overlap_set_create(ordered->length, floating_enabled);
+	if (!set) {
+		list_free(ordered);
+		return;
+	}
 	for (int i = 0; i < ordered->length; ++i) {
-		struct sway_container *con1 = ordered->items[i];
-		if (!root->filters->container_filter(con1->pending.workspace, con1, root->filters->container_filter_data)) {
-			continue;
-		}
-		int over = 0;
-		if (floating_enabled) {
-			for (int j = 0; j < workspace->floating->length; ++j) {
-				struct sway_container *con2 = workspace->floating->items[j];
-				if (!root->filters->container_filter(con2->pending.workspace, con2, root->filters->container_filter_data)) {
-					continue;
-				}
-				if (con1 != con2 && containers_overlap(con1, con2)) {
-					++over;
-				}
-			}
-		}
-		if (tiling_enabled) {
-			for (int j = 0; j < workspace->tiling->length; ++j) {
-				struct sway_container *con2 = workspace->tiling->items[j];
-				if (!root->filters->container_filter(con2->pending.workspace, con2, root->filters->container_filter_data)) {
-					continue;
-				}
-				over += overlapping_containers(con1, con2);
-			}
-		}
-		if (over > max_over) {
-			max_over = over;
-			max_con = con1;
-		}
+		struct sway_container *con = ordered->items[i];
+		bool active = root->filters->container_filter(con->pending.workspace, con,
+			root->filters->container_filter_data);
+		int tiled = active && tiling_enabled ? organize_tiled_overlaps(workspace, con) : 0;
+		overlap_set_add(set, con->pending.x, con->pending.y,
+			con->pending.width, con->pending.height, active, tiled);
 	}
-	list_free(ordered);
-	return max_con;
-}
+	overlap_set_compute(set);
 
-static void organize_deoverlap(struct sway_workspace *workspace,
-		bool tiling_enabled, bool floating_enabled) {
 	while (true) {
-		struct sway_container *container = organize_maximum_overlap(workspace,
-			tiling_enabled, floating_enabled);
-		if (!container) {
+		int index = overlap_set_maximum(set);
+		if (index < 0) {
 			break;
 		}
+		struct sway_container *container = ordered->items[index];
 		double minx, maxx, miny, maxy;
 		organize_compute_overlapping_bounds(workspace, tiling_enabled, floating_enabled,
 			container, &minx, &maxx, &miny, &maxy);
@@ -2265,7 +2263,15 @@ static void organize_deoverlap(struct sway_workspace *workspace,
 		} else {
 			container->pending.y += dy;
 		}
+		// Filters may depend on the position
+		bool active = root->filters->container_filter(container->pending.workspace,
+			container, root->filters->container_filter_data);
+		int tiled = active && tiling_enabled ? organize_tiled_overlaps(workspace, container) : 0;
+		overlap_set_move(set, index, container->pending.x, container->pending.y,
+			active, tiled);
 	}
+	overlap_set_destroy(set);
+	list_free(ordered);
 }
 
 static void translate_container_and_children(struct sway_container *container,
@@ -3134,7 +3140,6 @@ static void scroll_workspace(struct sway_workspace *workspace, double dx, double
 		}
 	}
 	node_set_dirty(&workspace->node);
-	transaction_commit_dirty();
 }
 
 static void scroll_container(struct sway_container *container, double dx, double dy) {
@@ -3154,7 +3159,86 @@ static void scroll_container(struct sway_container *container, double dx, double
 		}
 	}
 	node_set_dirty(&container->node);
-	transaction_commit_dirty();
+}
+
+// Kinetic deceleration after a swipe, velocities in px/ms and times in ms
+#define KINETIC_SMOOTHING 30.0
+#define KINETIC_TIME_CONSTANT 150.0
+#define KINETIC_MIN_VELOCITY 0.05
+#define KINETIC_MAX_VELOCITY 4.0
+#define KINETIC_MAX_REST 80
+
+// While a gesture is active, the scrolled distance only translates the scene:
+// the workspace axis moves the tiling layer and the other one the children of
+// the column under the cursor. It is folded into the layout when the gesture
+// ends, so input events don't cause any transaction.
+static bool scroll_column_valid(struct sway_workspace *workspace) {
+	struct sway_container *column = workspace->gesture.column;
+	return column && (list_find(workspace->tiling, column) >= 0 ||
+		list_find(workspace->floating, column) >= 0);
+}
+
+static void scroll_offset_add(struct sway_workspace *workspace, double dx, double dy) {
+	workspace->gesture.dx += dx;
+	workspace->gesture.dy += dy;
+	if (layout_get_type(workspace) == L_HORIZ) {
+		workspace->gesture.x += dx;
+		workspace->gesture.column_y += dy;
+	} else {
+		workspace->gesture.y += dy;
+		workspace->gesture.column_x += dx;
+	}
+}
+
+static void scroll_fold(struct sway_workspace *workspace) {
+	if (scroll_column_valid(workspace)) {
+		scroll_container(workspace->gesture.column,
+			workspace->gesture.column_x, workspace->gesture.column_y);
+	}
+	scroll_workspace(workspace, workspace->gesture.x, workspace->gesture.y);
+	workspace->gesture.x = workspace->gesture.y = 0.0;
+	workspace->gesture.column_x = workspace->gesture.column_y = 0.0;
+	// The scene keeps its translation until the folded layout is arranged
+	workspace->gesture.scene_x = workspace->gesture.scene_y = 0;
+	workspace->gesture.scene_column_x = workspace->gesture.scene_column_y = 0;
+	// Make the folded layout current where the scene already shows it, so
+	// the snap that follows animates from the release position
+	transaction_commit_dirty_disable_animations();
+}
+
+static void scroll_apply_scene(struct sway_workspace *workspace) {
+	// Positions set by the last arrange already include the scene offset,
+	// only move the nodes by what changed since then
+	int x = round(workspace->gesture.x);
+	int y = round(workspace->gesture.y);
+	struct wlr_scene_node *node = &workspace->layers.tiling->node;
+	wlr_scene_node_set_position(node, node->x + x - workspace->gesture.scene_x,
+		node->y + y - workspace->gesture.scene_y);
+	workspace->gesture.scene_x = x;
+	workspace->gesture.scene_y = y;
+
+	if (!scroll_column_valid(workspace)) {
+		return;
+	}
+	x = round(workspace->gesture.column_x);
+	y = round(workspace->gesture.column_y);
+	node = &workspace->gesture.column->content_tree->node;
+	wlr_scene_node_set_position(node, node->x + x - workspace->gesture.scene_column_x,
+		node->y + y - workspace->gesture.scene_column_y);
+	workspace->gesture.scene_column_x = x;
+	workspace->gesture.scene_column_y = y;
+}
+
+void layout_scroll_get_scene_offset(struct sway_workspace *workspace,
+		struct sway_container *con, int *x, int *y) {
+	*x = *y = 0;
+	if (!con) {
+		*x = workspace->gesture.scene_x;
+		*y = workspace->gesture.scene_y;
+	} else if (con == workspace->gesture.column) {
+		*x = workspace->gesture.scene_column_x;
+		*y = workspace->gesture.scene_column_y;
+	}
 }
 
 static void layout_scroll_float_pinned_container(struct sway_workspace *workspace) {
@@ -3271,9 +3355,14 @@ static void layout_scroll_unfloat_pinned_container(struct sway_workspace *worksp
 }
 
 // Gestures
+static void scroll_finish(struct sway_seat *seat, struct sway_workspace *workspace);
+
 bool layout_scroll_begin(struct sway_seat *seat) {
-	animation_set_type(ANIMATION_DISABLED);
 	struct sway_workspace *workspace = seat->workspace;
+	if (workspace->gesture.kinetic) {
+		scroll_finish(seat, workspace);
+	}
+	animation_set_type(ANIMATION_DISABLED);
 	// Check if we can scroll
 	double scale = layout_scale_enabled(workspace) ? layout_scale_get(workspace) : 1.0;
 	double total_width = 0.0, max_height = 0.0;
@@ -3299,6 +3388,9 @@ bool layout_scroll_begin(struct sway_seat *seat) {
 	workspace->gesture.scrolling = true;
 	workspace->gesture.dx = 0.0;
 	workspace->gesture.dy = 0.0;
+	workspace->gesture.vx = 0.0;
+	workspace->gesture.vy = 0.0;
+	clock_gettime(CLOCK_MONOTONIC, &workspace->gesture.time);
 
 	// If there is a pinned container, float it.
 	struct sway_container *pin = layout_pin_enabled(workspace) ? layout_pin_get_container(workspace) : NULL;
@@ -3311,27 +3403,39 @@ bool layout_scroll_begin(struct sway_seat *seat) {
 		layout_pin_remove(workspace, pin);
 		layout_scroll_float_pinned_container(workspace);
 	}
+	workspace->gesture.column = get_mouse_container(seat);
+	transaction_pacing_begin(workspace->output);
 	return true;
 }
 
 void layout_scroll_update(struct sway_seat *seat, double dx, double dy, float sensitivity) {
 	animation_set_type(ANIMATION_DISABLED);
 	struct sway_workspace *workspace = seat->workspace;
-	if (workspace->tiling->length == 0) {
+	if (!workspace->gesture.scrolling || workspace->gesture.kinetic ||
+			workspace->tiling->length == 0) {
 		return;
 	}
 	double scale = layout_scale_enabled(workspace) ? layout_scale_get(workspace) : 1.0;
 	dx *= sensitivity * scale;
 	dy *= sensitivity * scale;
+	scroll_offset_add(workspace, dx, dy);
 
-	workspace->gesture.dx += dx;
-	workspace->gesture.dy += dy;
-	if (layout_get_type(workspace) == L_HORIZ) {
-		scroll_container(get_mouse_container(seat), 0.0, dy);
-		scroll_workspace(workspace, dx, 0.0);
-	} else {
-		scroll_container(get_mouse_container(seat), dx, 0.0);
-		scroll_workspace(workspace, 0.0, dy);
+	// Track the velocity for the kinetic deceleration, smoothing out the
+	// uneven timing of input events
+	struct timespec now, elapsed;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	timespec_sub(&elapsed, &now, &workspace->gesture.time);
+	workspace->gesture.time = now;
+	double dt = timespec_to_nsec(&elapsed) / 1000000.0;
+	if (dt > 0.0) {
+		double weight = fmin(dt / KINETIC_SMOOTHING, 1.0);
+		workspace->gesture.vx += weight * (dx / dt - workspace->gesture.vx);
+		workspace->gesture.vy += weight * (dy / dt - workspace->gesture.vy);
+	}
+
+	// The scene is updated once per frame, see layout_scroll_frame()
+	if (workspace->output) {
+		wlr_output_schedule_frame(workspace->output->wlr_output);
 	}
 }
 
@@ -3428,12 +3532,10 @@ static bool scrolling_in_pin_direction(enum sway_container_layout layout,
 	return false;
 }
 
-bool layout_scroll_end(struct sway_seat *seat) {
+static void scroll_finish(struct sway_seat *seat, struct sway_workspace *workspace) {
 	animation_set_type(ANIMATION_DEFAULT);
-	struct sway_workspace *workspace = seat->workspace;
-	if (!workspace->gesture.scrolling) {
-		return false;
-	}
+	workspace->gesture.kinetic = false;
+	scroll_fold(workspace);
 
 	enum sway_layout_direction scrolling_direction;
 	enum sway_container_layout layout = layout_get_type(workspace);
@@ -3446,13 +3548,15 @@ bool layout_scroll_end(struct sway_seat *seat) {
 	if (workspace->gesture.pin) {
 		layout_scroll_unfloat_pinned_container(workspace);
 		if (scrolling_in_pin_direction(layout, scrolling_direction)) {
-			return true;
+			return;
 		}
 	}
 
 	workspace->gesture.scrolling = false;
-	if (workspace->tiling->length == 0) {
-		return true;
+	if (workspace->tiling->length == 0 || seat->workspace != workspace) {
+		arrange_workspace(workspace);
+		transaction_commit_dirty();
+		return;
 	}
 	if (scrolling_direction == DIR_LEFT || scrolling_direction == DIR_RIGHT) {
 		if (layout == L_HORIZ) {
@@ -3479,9 +3583,86 @@ bool layout_scroll_end(struct sway_seat *seat) {
 	}
 	arrange_workspace(workspace);
 	transaction_commit_dirty();
+}
+
+// Runs the kinetic deceleration for the elapsed time, returns false once it
+// is over
+static bool scroll_kinetic_step(struct sway_workspace *workspace) {
+	struct timespec now, elapsed;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	timespec_sub(&elapsed, &now, &workspace->gesture.time);
+	workspace->gesture.time = now;
+	double dt = timespec_to_nsec(&elapsed) / 1000000.0;
+
+	// The velocity decays exponentially, integrate it over dt
+	double decay = exp(-dt / KINETIC_TIME_CONSTANT);
+	double distance = KINETIC_TIME_CONSTANT * (1.0 - decay);
+	scroll_offset_add(workspace, workspace->gesture.vx * distance,
+		workspace->gesture.vy * distance);
+	workspace->gesture.vx *= decay;
+	workspace->gesture.vy *= decay;
+	return hypot(workspace->gesture.vx, workspace->gesture.vy) >= KINETIC_MIN_VELOCITY;
+}
+
+bool layout_scroll_end(struct sway_seat *seat, bool kinetic) {
+	transaction_pacing_end();
+	struct sway_workspace *workspace = seat->workspace;
+	if (!workspace->gesture.scrolling || workspace->gesture.kinetic) {
+		animation_set_type(ANIMATION_DEFAULT);
+		return workspace->gesture.scrolling;
+	}
+
+	// Fingers resting before being lifted stop the movement
+	struct timespec now, elapsed;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	timespec_sub(&elapsed, &now, &workspace->gesture.time);
+	double velocity = hypot(workspace->gesture.vx, workspace->gesture.vy);
+	if (kinetic && workspace->output && velocity >= KINETIC_MIN_VELOCITY &&
+			timespec_to_msec(&elapsed) < KINETIC_MAX_REST) {
+		if (velocity > KINETIC_MAX_VELOCITY) {
+			workspace->gesture.vx *= KINETIC_MAX_VELOCITY / velocity;
+			workspace->gesture.vy *= KINETIC_MAX_VELOCITY / velocity;
+		}
+		workspace->gesture.kinetic = true;
+		workspace->gesture.time = now;
+		wlr_output_schedule_frame(workspace->output->wlr_output);
+		return true;
+	}
+
+	scroll_finish(seat, workspace);
 	return true;
 }
 
+void layout_scroll_frame(struct sway_output *output) {
+	for (int i = 0; i < output->workspaces->length; ++i) {
+		struct sway_workspace *workspace = output->workspaces->items[i];
+		if (!workspace->gesture.scrolling) {
+			continue;
+		}
+		if (workspace->gesture.kinetic) {
+			if (!scroll_kinetic_step(workspace)) {
+				scroll_finish(input_manager_current_seat(), workspace);
+				continue;
+			}
+			wlr_output_schedule_frame(output->wlr_output);
+		}
+		scroll_apply_scene(workspace);
+	}
+}
+
+bool layout_scroll_kinetic(void) {
+	for (int i = 0; i < root->outputs->length; ++i) {
+		struct sway_output *output = root->outputs->items[i];
+		for (int j = 0; j < output->workspaces->length; ++j) {
+			struct sway_workspace *workspace = output->workspaces->items[j];
+			if (workspace->gesture.kinetic) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
 bool layout_pin_enabled(struct sway_workspace *workspace) {
 	if (!workspace->layout.pin.container) {
 		return false;
@@ -3860,12 +4041,25 @@ static struct sway_trail *trail_create() {
 	return trail;
 }
 
+// Drops the back-references the marked views keep to the trail
+static void trail_unmark_views(struct sway_trail *trail) {
+	for (int i = 0; i < trail->marks->length; ++i) {
+		struct sway_view *view = trail->marks->items[i];
+		int idx = list_find(view->trails, trail);
+		if (idx >= 0) {
+			list_del(view->trails, idx);
+		}
+	}
+}
+
 static void trail_destroy(struct sway_trail *trail) {
+	trail_unmark_views(trail);
 	list_free(trail->marks);
 	free(trail);
 }
 
 static void trail_clear(struct sway_trail *trail) {
+	trail_unmark_views(trail);
 	list_free(trail->marks);
 	trail->marks = create_list();
 	trail->active = 0;
@@ -3947,12 +4141,14 @@ void layout_trailmark_toggle(struct sway_view *view) {
 		layout_trail_new();
 	}
 	struct sway_trail *trail = trails->trails->items[trails->active];
-	int idx = list_find(trail->marks, view);
-	if (idx < 0) {
+	int view_idx = list_find(view->trails, trail);
+	if (view_idx < 0) {
 		list_add(trail->marks, view);
+		list_add(view->trails, trail);
 		trail->active = trail->marks->length - 1;
 	} else {
-		list_del(trail->marks, idx);
+		list_del(view->trails, view_idx);
+		list_del(trail->marks, list_find(trail->marks, view));
 		if (trail->marks->length == 0) {
 			trail->active = 0;
 		} else if (trail->active > 0) {
@@ -4000,31 +4196,26 @@ void layout_trailmark_prev() {
 }
 
 void layout_trail_remove_view(struct sway_view *view) {
-	if (trails == NULL || trails->trails->length == 0) {
+	if (view->trails->length == 0) {
 		return;
 	}
-	bool update = false;
-	for (int i = 0; i < trails->trails->length; ++i) {
-		struct sway_trail *trail = trails->trails->items[i];
-		for (int j = 0; j < trail->marks->length; ++j) {
-			struct sway_view *v = trail->marks->items[j];
-			if (v == view) {
-				list_del(trail->marks, j);
-				if (trail->active == j) {
-					if (trail->marks->length == 0) {
-						trail->active = 0;
-					} else if (trail->active > 0) {
-						trail->active--;
-					}
-				}
-				update = true;
-				break;
+	// Only the trails marking the view need to be touched
+	for (int i = 0; i < view->trails->length; ++i) {
+		struct sway_trail *trail = view->trails->items[i];
+		int j = list_find(trail->marks, view);
+		list_del(trail->marks, j);
+		if (trail->active == j) {
+			if (trail->marks->length == 0) {
+				trail->active = 0;
+			} else if (trail->active > 0) {
+				trail->active--;
 			}
 		}
 	}
-	if (update) {
-		ipc_event_trails();
+	while (view->trails->length > 0) {
+		list_del(view->trails, view->trails->length - 1);
 	}
+	ipc_event_trails();
 }
 
 // For IPC events
@@ -4054,14 +4245,11 @@ bool layout_trails_trailmarked(struct sway_view *view) {
 	if (trails == NULL || trails->trails->length == 0 || view == NULL) {
 		return false;
 	}
-	struct sway_trail *trail = trails->trails->items[trails->active];
-	for (int i = 0; i < trail->marks->length; ++i) {
-		struct sway_view *v = trail->marks->items[i];
-		if (v == view) {
-			return true;
-		}
+	if (view->trails->length == 0) {
+		return false;
 	}
-	return false;
+	struct sway_trail *trail = trails->trails->items[trails->active];
+	return list_find(view->trails, trail) >= 0;
 }
 
 static void layout_toggle_size_init(struct sway_workspace *workspace) {
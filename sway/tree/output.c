@@ -4,6 +4,7 @@
 #include <strings.h>
 #include <wlr/types/wlr_ext_workspace_v1.h>
 #include "sway/tree/workspace.h"
+#include "sway/desktop/transaction.h"
 #include "sway/ipc-server.h"
 #include "sway/layers.h"
 #include "sway/output.h"
@@ -120,6 +121,10 @@ struct sway_output *output_create(struct wlr_output *wlr_output) {
 	output->layer_shell_mask = LAYER_SHELL_ALL;
 
 	if (!failed) {
+		// The wallpaper and the bottom layer show blurred behind blur regions
+		output->layers.shell_background->node.info.blur_source = true;
+		output->layers.shell_bottom->node.info.blur_source = true;
+
 		output->fullscreen_background = wlr_scene_rect_create(
 			output->layers.fullscreen, 0, 0, (float[4]){0.f, 0.f, 0.f, 1.f});
 
@@ -298,6 +303,10 @@ void output_disable(struct sway_output *output) {
 	// output destroyed.
 	list_del(root->outputs, index);
 	output->enabled = false;
+	if (server.paced_output == output) {
+		// The frame a paced transaction waits for won't come anymore
+		transaction_pacing_end();
+	}
 
 	destroy_layers(output);
 	output_evacuate(output);
@@ -0,0 +1,156 @@
+#include <stdlib.h>
+#include "sway/tree/overlap.h"
+
+// Same test as containers_overlap() in layout.c
+static bool boxes_overlap(const struct overlap_box *box1,
+		const struct overlap_box *box2) {
+	if (box1->x >= box2->x + box2->width ||
+		box1->x + box1->width <= box2->x ||
+		box1->y >= box2->y + box2->height ||
+		box1->y + box1->height <= box2->y) {
+		return false;
+	}
+	return true;
+}
+
+struct overlap_set *overlap_set_create(int capacity, bool mutual) {
+	struct overlap_set *set = calloc(1, sizeof(struct overlap_set));
+	if (!set) {
+		return NULL;
+	}
+	set->capacity = capacity > 0 ? capacity : 8;
+	set->boxes = calloc(set->capacity, sizeof(struct overlap_box));
+	if (!set->boxes) {
+		free(set);
+		return NULL;
+	}
+	set->mutual = mutual;
+	return set;
+}
+
+void overlap_set_destroy(struct overlap_set *set) {
+	if (!set) {
+		return;
+	}
+	free(set->boxes);
+	free(set);
+}
+
+void overlap_set_add(struct overlap_set *set, double x, double y,
+		double width, double height, bool active, int extra) {
+	if (set->length == set->capacity) {
+		struct overlap_box *boxes = realloc(set->boxes,
+			2 * set->capacity * sizeof(struct overlap_box));
+		if (!boxes) {
+			return;
+		}
+		set->boxes = boxes;
+		set->capacity *= 2;
+	}
+	set->boxes[set->length++] = (struct overlap_box){
+		.x = x,
+		.y = y,
+		.width = width,
+		.height = height,
+		.active = active,
+		.extra = extra,
+	};
+}
+
+static int compare_x(const void *data1, const void *data2) {
+	const struct overlap_box *box1 = *(const struct overlap_box **)data1;
+	const struct overlap_box *box2 = *(const struct overlap_box **)data2;
+	return (box1->x > box2->x) - (box1->x < box2->x);
+}
+
+void overlap_set_compute(struct overlap_set *set) {
+	for (int i = 0; i < set->length; ++i) {
+		set->boxes[i].count = 0;
+	}
+	if (!set->mutual || set->length < 2) {
+		return;
+	}
+
+	struct overlap_box **sorted = malloc(set->length * sizeof(struct overlap_box *));
+	struct overlap_box **open = malloc(set->length * sizeof(struct overlap_box *));
+	if (!sorted || !open) {
+		free(sorted);
+		free(open);
+		return;
+	}
+	int length = 0;
+	for (int i = 0; i < set->length; ++i) {
+		if (set->boxes[i].active) {
+			sorted[length++] = &set->boxes[i];
+		}
+	}
+	qsort(sorted, length, sizeof(struct overlap_box *), compare_x);
+
+	// Sweep from left to right. A box stays open until the sweep line passes
+	// its right edge, at which point it can't overlap any of the boxes left.
+	int open_length = 0;
+	for (int i = 0; i < length; ++i) {
+		struct overlap_box *box = sorted[i];
+		for (int j = 0; j < open_length;) {
+			struct overlap_box *other = open[j];
+			if (other->x + other->width <= box->x) {
+				open[j] = open[--open_length];
+				continue;
+			}
+			if (boxes_overlap(box, other)) {
+				box->count++;
+				other->count++;
+			}
+			++j;
+		}
+		open[open_length++] = box;
+	}
+
+	free(sorted);
+	free(open);
+}
+
+int overlap_set_maximum(struct overlap_set *set) {
+	int max_index = -1;
+	int max_over = 0;
+	for (int i = 0; i < set->length; ++i) {
+		struct overlap_box *box = &set->boxes[i];
+		if (!box->active) {
+			continue;
+		}
+		int over = box->count + box->extra;
+		if (over > max_over) {
+			max_over = over;
+			max_index = i;
+		}
+	}
+	return max_index;
+}
+
+void overlap_set_move(struct overlap_set *set, int index, double x, double y,
+		bool active, int extra) {
+	struct overlap_box *box = &set->boxes[index];
+	struct overlap_box moved = *box;
+	moved.x = x;
+	moved.y = y;
+	moved.active = active;
+	moved.extra = extra;
+	moved.count = 0;
+	if (set->mutual) {
+		for (int i = 0; i < set->length; ++i) {
+			struct overlap_box *other = &set->boxes[i];
+			if (i == index || !other->active) {
+				continue;
+			}
+			bool before = box->active && boxes_overlap(box, other);
+			bool after = active && boxes_overlap(&moved, other);
+			if (before != after) {
+				other->count += after ? 1 : -1;
+			}
+			if (after) {
+				moved.count++;
+			}
+		}
+	}
+	*box = moved;
+}
@@ -127,6 +127,8 @@ static bool scene_workspace_data(struct wlr_scene_node *node, struct wlr_scene_w
 		data->width = workspace->jump.width;
 		data->height = workspace->jump.height;
 		data->scale = workspace->jump.scale;
+		data->output_x = workspace->output ? workspace->output->lx : 0;
+		data->output_y = workspace->output ? workspace->output->ly : 0;
 		return true;
 	}
 	return false;
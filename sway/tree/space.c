@@ -4,8 +4,16 @@
 #include "sway/tree/arrange.h"
 #include "sway/output.h"
 
+static void space_view_unlink(struct sway_space_view *view) {
+	int idx = list_find(view->view->space_views, view);
+	if (idx >= 0) {
+		list_del(view->view->space_views, idx);
+	}
+}
+
 static void handle_view_unmap(struct wl_listener *listener, void *data) {
 	struct sway_space_view *view = wl_container_of(listener, view, view_unmap);
+	space_view_unlink(view);
 	view->view = NULL;
 	wl_list_remove(&view->view_unmap.link);
 	wl_list_init(&view->view_unmap.link);
@@ -153,31 +161,11 @@ static void layout_space_container_restore_floating(struct sway_workspace *works
 	}
 }
 
-static bool container_find_view(struct sway_space_container *container,
-		struct sway_view *view) {
-	if (container->children) {
-		for (int i = 0; i < container->children->length; ++i) {
-			struct sway_space_container *space_con = container->children->items[i];
-			if (container_find_view(space_con, view)) {
-				return true;
-			}
-		}
-	} else if (container->view && container->view->view == view) {
-		return true;
-	}
-	return false;
-}
-
 static bool space_find_view(struct sway_space *space, struct sway_view *view) {
-	for (int i = 0; i < space->tiling->length; ++i) {
-		struct sway_space_container *con = space->tiling->items[i];
-		if (container_find_view(con, view)) {
-			return true;
-		}
-	}
-	for (int i = 0; i < space->floating->length; ++i) {
-		struct sway_space_container *con = space->floating->items[i];
-		if (container_find_view(con, view)) {
+	// A view is in few spaces at most, so look at those rather than the space
+	for (int i = 0; i < view->space_views->length; ++i) {
+		struct sway_space_view *space_view = view->space_views->items[i];
+		if (space_view->space == space) {
 			return true;
 		}
 	}
@@ -249,18 +237,22 @@ void layout_space_restore(struct sway_space *space, struct sway_workspace *works
 }
 
 static struct sway_space_view *space_view_create(struct sway_view *sway_view,
-		struct sway_space_container *container, float content_scale) {
+		struct sway_space *space, struct sway_space_container *container,
+		float content_scale) {
 	struct sway_space_view *view = malloc(sizeof(struct sway_space_view));
 	view->view = sway_view;
+	view->space = space;
 	view->container = container;
 	view->content_scale = content_scale;
 	view->view_unmap.notify = handle_view_unmap;
 	wl_signal_add(&sway_view->events.unmap, &view->view_unmap);
+	list_add(sway_view->space_views, view);
 	return view;
 }
 
 static void space_view_destroy(struct sway_space_view *view) {
 	if (view->view) {
+		space_view_unlink(view);
 		wl_list_remove(&view->view_unmap.link);
 	}
 	free(view);
@@ -287,8 +279,8 @@ static struct sway_space_container *space_container_create(struct sway_container
 		space_container->children = NULL;
 	}
 	if (container->view) {
-		space_container->view = space_view_create(container->view, space_container,
-			container->view->content_scale);
+		space_container->view = space_view_create(container->view, space,
+			space_container, container->view->content_scale);
 	} else {
 		space_container->view = NULL;
 	}
@@ -5,6 +5,7 @@
 #include <wlr/render/wlr_renderer.h>
 #include <wlr/types/wlr_buffer.h>
 #include <wlr/types/wlr_scene.h>
+#include <wlr/types/wlr_ext_image_capture_source_v1.h>
 #include <wlr/types/wlr_ext_foreign_toplevel_list_v1.h>
 #include <wlr/types/wlr_foreign_toplevel_management_v1.h>
 #include <wlr/types/wlr_fractional_scale_v1.h>
@@ -40,11 +41,37 @@
 #include "sway/desktop/animation.h"
 #include "sway/tree/focus_ring.h"
 
+static void view_set_hidden(struct sway_view *view, bool hidden) {
+	view->hidden = hidden;
+	if (hidden) {
+		// The timer is already running for the other hidden views
+		if (wl_list_empty(&server.hidden_views)) {
+			output_schedule_hidden_frame_done();
+		}
+		wl_list_insert(&server.hidden_views, &view->hidden_link);
+	} else {
+		wl_list_remove(&view->hidden_link);
+	}
+
+	if (view->impl->set_suspended) {
+		view->impl->set_suspended(view, hidden);
+	}
+}
+
 static void handle_outputs_update(
 		struct wl_listener *listener, void *data) {
 	struct sway_view *view = wl_container_of(listener, view, outputs_update);
 	struct wlr_scene_outputs_update_event *event = data;
 
+	bool hidden = event->size == 0;
+	if (hidden != view->hidden) {
+		view_set_hidden(view, hidden);
+	}
+	if (hidden) {
+		// Like its surfaces, a hidden view stays on its last outputs
+		return;
+	}
+
 	struct wlr_foreign_toplevel_handle_v1 *toplevel = view->foreign_toplevel;
 	if (toplevel) {
 		struct wlr_foreign_toplevel_handle_v1_output *toplevel_output, *tmp;
@@ -94,12 +121,6 @@ bool view_init(struct sway_view *view, enum sway_view_type type,
 		goto err;
 	}
 
-	view->image_capture_scene = wlr_scene_create();
-	if (view->image_capture_scene == NULL) {
-		goto err;
-	}
-	view->image_capture_scene->restack_xwayland_surfaces = false;
-
 	view->outputs_update.notify = handle_outputs_update;
 	wl_signal_add(&view->output_handler->events.outputs_update,
 		&view->outputs_update);
@@ -108,6 +129,8 @@ bool view_init(struct sway_view *view, enum sway_view_type type,
 	view->type = type;
 	view->impl = impl;
 	view->executed_criteria = create_list();
+	view->trails = create_list();
+	view->space_views = create_list();
 	view->allow_request_urgent = true;
 	view->shortcuts_inhibit = SHORTCUTS_INHIBIT_DEFAULT;
 	view->tearing_mode = TEARING_WINDOW_HINT;
@@ -139,9 +162,17 @@ void view_destroy(struct sway_view *view) {
 	}
 	wl_list_remove(&view->events.unmap.listener_list);
 	list_free(view->executed_criteria);
+	list_free(view->trails);
+	list_free(view->space_views);
 
 	view_assign_ctx(view, NULL);
-	wlr_scene_node_destroy(&view->image_capture_scene->tree.node);
+	if (view->image_capture_idle) {
+		wl_event_source_remove(view->image_capture_idle);
+	}
+	if (view->image_capture_scene) {
+		wl_list_remove(&view->image_capture_unused.link);
+		wlr_scene_node_destroy(&view->image_capture_scene->tree.node);
+	}
 	wlr_scene_node_destroy(&view->scene_tree->node);
 	if (view->impl->destroy) {
 		view->impl->destroy(view);
@@ -150,12 +181,78 @@ void view_destroy(struct sway_view *view) {
 	}
 }
 
+static void image_capture_destroy(struct sway_view *view) {
+	wl_list_remove(&view->image_capture_unused.link);
+	if (view->impl->set_image_capture) {
+		view->impl->set_image_capture(view, false);
+	}
+	// Destroys the source as well
+	wlr_scene_node_destroy(&view->image_capture_scene->tree.node);
+	view->image_capture_scene = NULL;
+	view->image_capture_source = NULL;
+}
+
+static void image_capture_idle(void *data) {
+	struct sway_view *view = data;
+	view->image_capture_idle = NULL;
+	struct wlr_ext_image_capture_source_v1 *source = view->image_capture_source;
+	// A client may have requested the source again in the meantime
+	if (source && wl_list_empty(&source->resources) && source->num_sessions == 0) {
+		image_capture_destroy(view);
+	}
+}
+
+static void handle_image_capture_unused(struct wl_listener *listener, void *data) {
+	struct sway_view *view = wl_container_of(listener, view, image_capture_unused);
+	// The source is still being used by the caller emitting the signal
+	if (!view->image_capture_idle) {
+		view->image_capture_idle = wl_event_loop_add_idle(server.wl_event_loop,
+			image_capture_idle, view);
+	}
+}
+
+struct wlr_ext_image_capture_source_v1 *view_get_image_capture_source(
+		struct sway_view *view) {
+	if (view->image_capture_source) {
+		return view->image_capture_source;
+	}
+
+	view->image_capture_scene = wlr_scene_create();
+	if (view->image_capture_scene == NULL) {
+		return NULL;
+	}
+	view->image_capture_scene->restack_xwayland_surfaces = false;
+	if (view->impl->set_image_capture) {
+		view->impl->set_image_capture(view, true);
+	}
+
+	view->image_capture_source = wlr_ext_image_capture_source_v1_create_with_scene_node(
+		&view->image_capture_scene->tree.node, server.wl_event_loop,
+		server.allocator, server.renderer);
+	if (view->image_capture_source == NULL) {
+		if (view->impl->set_image_capture) {
+			view->impl->set_image_capture(view, false);
+		}
+		wlr_scene_node_destroy(&view->image_capture_scene->tree.node);
+		view->image_capture_scene = NULL;
+		return NULL;
+	}
+	view->image_capture_unused.notify = handle_image_capture_unused;
+	wl_signal_add(&view->image_capture_source->events.unused,
+		&view->image_capture_unused);
+	return view->image_capture_source;
+}
+
 void view_begin_destroy(struct sway_view *view) {
 	if (!sway_assert(view->surface == NULL, "Tried to destroy a mapped view")) {
 		return;
 	}
 	view->destroying = true;
 	wl_list_remove(&view->outputs_update.link);
+	if (view->hidden) {
+		wl_list_remove(&view->hidden_link);
+		view->hidden = false;
+	}
 
 	if (!view->container) {
 		view_destroy(view);
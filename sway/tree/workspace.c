@@ -1,5 +1,6 @@
 #include <ctype.h>
 #include <limits.h>
+#include <math.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -784,17 +785,17 @@ struct sway_workspace *workspace_auto_back_and_forth(
 	return workspace;
 }
 
-struct workspace_switch_container_data {
-	struct sway_container *container;
-	double y;
-};
-
+// The switch moves the scene trees of both workspaces as a whole, leaving
+// the geometry of their containers untouched. The default animation step
+// only runs once for the switching output, to place the containers.
 struct workspace_switch_data {
 	struct sway_output *output;
 	struct sway_workspace *from;
 	struct sway_workspace *to;
-	list_t *from_containers;
-	list_t *to_containers;
+	double delta;
+	bool placed;
+	sway_animation_callback_func_t step;
+	void *step_data;
 	struct sway_root_filters *root_filters;
 	struct wl_listener from_destroy;
 	struct wl_listener to_destroy;
@@ -826,27 +827,74 @@ static void workspace_switch_callback_end(void *callback_data) {
 		wl_list_remove(&data->to_destroy.link);
 	}
 
-	for (int i = 0; i < data->from_containers->length; ++i) {
-		struct workspace_switch_container_data *cdata = data->from_containers->items[i];
-		cdata->container->pending.y = cdata->y;
-		node_set_dirty(&cdata->container->node);
+	// Arranging puts the layers back in place
+	if (data->from) {
+		data->from->animation.switch_y = 0;
+		if (data->from->output) {
+			node_set_dirty(&data->from->node);
+		}
 	}
-	for (int i = 0; i < data->to_containers->length; ++i) {
-		struct workspace_switch_container_data *cdata = data->to_containers->items[i];
-		cdata->container->current.y = cdata->y;
-		node_set_dirty(&cdata->container->node);
+	if (data->to) {
+		data->to->animation.switch_y = 0;
+		if (data->to->output) {
+			node_set_dirty(&data->to->node);
+		}
 	}
 
-	if (data->from && data->from->output) {
-		node_set_dirty(&data->from->node);
+	free(data);
+}
+
+// Everything the workspace shows was placed by arranging or by the default
+// step with the current offset, move it by the difference
+static void workspace_switch_translate(struct sway_workspace *workspace,
+		int offset) {
+	int dy = offset - workspace->animation.switch_y;
+	workspace->animation.switch_y = offset;
+	if (dy == 0) {
+		return;
 	}
-	if (data->to && data->to->output) {
-		node_set_dirty(&data->to->node);
+	struct wlr_scene_node *node = &workspace->layers.tiling->node;
+	wlr_scene_node_set_position(node, node->x, node->y + dy);
+	node = &workspace->layers.fullscreen->node;
+	wlr_scene_node_set_position(node, node->x, node->y + dy);
+
+	// Floating containers live in a layer shared by all the workspaces
+	for (int i = 0; i < workspace->current.floating->length; ++i) {
+		struct sway_container *floater = workspace->current.floating->items[i];
+		if (container_is_sticky_or_child(floater)) {
+			continue;
+		}
+		node = &floater->scene_tree->node;
+		wlr_scene_node_set_position(node, node->x, node->y + dy);
 	}
+	if (workspace->current.fullscreen && workspace->output) {
+		node = &workspace->output->fullscreen_background->node;
+		wlr_scene_node_set_position(node, node->x, node->y + dy);
+	}
+}
 
-	list_free_items_and_destroy(data->from_containers);
-	list_free_items_and_destroy(data->to_containers);
-	free(data);
+static void workspace_switch_callback_step(void *callback_data) {
+	struct workspace_switch_data *data = callback_data;
+	struct wlr_output *output = animation_get_current_output();
+	bool switching = !output || output == data->output->wlr_output;
+	bool place = !switching || !data->placed || !output;
+	if (place) {
+		data->step(data->step_data);
+	}
+	if (!switching) {
+		return;
+	}
+	data->placed = true;
+
+	double t, x, y;
+	animation_get_values(&t, &x, &y);
+	if (data->to) {
+		workspace_switch_translate(data->to, round(data->delta * (1.0 - x)));
+	}
+	if (data->from) {
+		workspace_switch_translate(data->from, round(-data->delta * x));
+	}
+	animation_set_animation_enabled(true);
 }
 
 static bool workspace_switch_output_fullscreen_filter(struct sway_output *output,
@@ -873,10 +921,6 @@ static bool switching_output(struct sway_workspace *workspace,
 	return false;
 }
 
-static bool workspace_switch_animation_filter(struct sway_workspace *workspace, void *filter_data) {
-	return switching_output(workspace, filter_data);
-}
-
 static bool workspace_switch_workspace_filter(struct sway_workspace *workspace, void *filter_data) {
 	if (switching_output(workspace, filter_data)) {
 		struct workspace_switch_data *data = filter_data;
@@ -896,49 +940,6 @@ static bool workspace_switch_workspace_filter(struct sway_workspace *workspace,
 	return true;
 }
 
-static bool workspace_switch_container_filter_child(struct sway_workspace *workspace,
-		struct sway_container *container, void *filter_data) {
-	struct workspace_switch_data *data = filter_data;
-	for (int i = 0; i < data->from_containers->length; ++i) {
-		struct workspace_switch_container_data *container_data = data->from_containers->items[i];
-		if (container == container_data->container) {
-			return true;
-		}
-	}
-	for (int i = 0; i < data->to_containers->length; ++i) {
-		struct workspace_switch_container_data *container_data = data->to_containers->items[i];
-		if (container == container_data->container) {
-			return true;
-		}
-	}
-	return false;
-}
-
-static bool filter_container_and_children(sway_root_container_filter_func_t container_filter,
-		struct sway_workspace *workspace, struct sway_container *container, void *data) {
-	if (container->pending.children) {
-		for (int i = 0; i < container->pending.children->length; ++i) {
-			struct sway_container *con = container->pending.children->items[i];
-			if (filter_container_and_children(container_filter, workspace, con, data)) {
-				return true;
-			}
-		}
-	} else if (container->view) {
-		return container_filter(workspace, container, data);
-	}
-	return false;
-}
-
-static bool workspace_switch_container_filter(struct sway_workspace *workspace,
-		struct sway_container *container, void *filter_data) {
-	if (!switching_output(workspace, filter_data)) {
-		return true;
-	}
-	return filter_container_and_children(workspace_switch_container_filter_child,
-		workspace, container, filter_data);
-}
-
-
 static bool container_visible(struct sway_workspace *workspace,
 		struct sway_container *container) {
 	float scale = layout_scale_enabled(workspace) ? layout_scale_get(workspace) : 1.0f;
@@ -952,65 +953,33 @@ static bool container_visible(struct sway_workspace *workspace,
 	return true;
 }
 
-typedef void (*add_delta_to_container_func_t)(struct sway_container *con, double delta);
-
-static void add_delta_to_current(struct sway_container *con, double delta) {
-	if (!container_is_sticky_or_child(con)) {
-		con->current.y += delta;
-		node_set_dirty(&con->node);
-	}
-}
-
-static void add_delta_to_pending(struct sway_container *con, double delta) {
-	if (!container_is_sticky_or_child(con)) {
-		con->pending.y += delta;
-		node_set_dirty(&con->node);
-	}
-}
-
-static void select_visible_containers(list_t *containers,
-		struct sway_workspace *workspace, list_t *children,
-		double *min_y, double *max_y) {
-	if (!workspace->output || children->length == 0) {
+// Vertical extents of the visible containers, so the switch slides them
+// completely out of (or into) the output
+static void visible_containers_extents(struct sway_workspace *workspace,
+		list_t *children, double *min_y, double *max_y) {
+	if (!workspace->output) {
 		return;
 	}
+	float scale = layout_scale_enabled(workspace) ? layout_scale_get(workspace) : 1.0f;
+	int gap = workspace->gaps_inner;
 	for (int i = 0; i < children->length; ++i) {
 		struct sway_container *con = children->items[i];
-		if (!root->filters->container_filter(workspace, con, root->filters->container_filter_data)) {
+		if (!root->filters->container_filter(workspace, con, root->filters->container_filter_data) ||
+				container_is_sticky_or_child(con) || !container_visible(workspace, con)) {
 			continue;
 		}
-		if (container_visible(workspace, con)) {
-			struct workspace_switch_container_data *container_data =
-				malloc(sizeof(struct workspace_switch_container_data));
-			container_data->container = con;
-			container_data->y = con->pending.y;
-			list_add(containers, container_data);
-			if (con->pending.children) {
-				select_visible_containers(containers, workspace,
-					con->pending.children, min_y, max_y);
-			}
-			node_set_dirty(&con->node);
-			if (con->pending.parent) {
-				float scale = layout_scale_enabled(workspace) ? layout_scale_get(workspace) : 1.0f;
-				int gap = workspace->gaps_inner;
-				const double miny = con->pending.y - gap;
-				const double maxy = con->pending.y + scale * (con->pending.height + gap);
-				if (miny < *min_y) {
-					*min_y = miny;
-				}
-				if (maxy > *max_y) {
-					*max_y = maxy;
-				}
-			}
-		}
+		*min_y = fmin(*min_y, con->pending.y - gap);
+		*max_y = fmax(*max_y, con->pending.y + scale * (con->pending.height + gap));
 	}
 }
 
-static void add_delta_to_containers(list_t *containers,
-		add_delta_to_container_func_t add_delta, double delta) {
-	for (int i = 0; i < containers->length; ++i) {
-		struct workspace_switch_container_data *data = containers->items[i];
-		add_delta(data->container, delta);
+static void workspace_extents(struct sway_workspace *workspace,
+		double *min_y, double *max_y) {
+	if (root->filters->workspace_tiling_filter(workspace, root->filters->workspace_tiling_filter_data)) {
+		visible_containers_extents(workspace, workspace->tiling, min_y, max_y);
+	}
+	if (root->filters->workspace_floating_filter(workspace, root->filters->workspace_floating_filter_data)) {
+		visible_containers_extents(workspace, workspace->floating, min_y, max_y);
 	}
 }
 
@@ -1055,14 +1024,12 @@ static void animate_workspace_switch(struct sway_output *output,
 	// calls transaction_commit_dirty(), which will destroy workspaces marked
 	// for deletion, and empty workspaces that are not active are marked for
 	// deletion.
-	struct workspace_switch_data *data = malloc(sizeof(struct workspace_switch_data));
+	struct workspace_switch_data *data = calloc(1, sizeof(struct workspace_switch_data));
 	const double from_y = from->y;
 	const int from_height = from->height;
 	data->output = output;
 	data->from = from->node.destroying ? NULL: from;
 	data->to = to;
-	data->from_containers = create_list();
-	data->to_containers = create_list();
 
 	data->from_destroy.notify = handle_from_workspace_destroy;
 	if (data->from) {
@@ -1082,45 +1049,38 @@ static void animate_workspace_switch(struct sway_output *output,
 	animation_set_type(ANIMATION_WORKSPACE_SWITCH);
 
 	double min_y_to = to->y, max_y_to = to->y + to->height;
-	if (root->filters->workspace_tiling_filter(to, root->filters->workspace_tiling_filter_data)) {
-		select_visible_containers(data->to_containers, to, to->tiling, &min_y_to, &max_y_to);
-	}
-	if (root->filters->workspace_floating_filter(to, root->filters->workspace_floating_filter_data)) {
-		select_visible_containers(data->to_containers, to, to->floating, &min_y_to, &max_y_to);
-	}
+	workspace_extents(to, &min_y_to, &max_y_to);
 	double min_y_from = from_y, max_y_from = from_y + from_height;
 	if (data->from) {
-		if (root->filters->workspace_tiling_filter(from, root->filters->workspace_tiling_filter_data)) {
-			select_visible_containers(data->from_containers, from, from->tiling, &min_y_from, &max_y_from);
-		}
-		if (root->filters->workspace_floating_filter(from, root->filters->workspace_floating_filter_data)) {
-			select_visible_containers(data->from_containers, from, from->floating, &min_y_from, &max_y_from);
-		}
+		workspace_extents(data->from, &min_y_from, &max_y_from);
 	}
 
 	data->root_filters = root_filters_create(root);
 	data->root_filters->output_fullscreen_filter = workspace_switch_output_fullscreen_filter;
 	data->root_filters->output_fullscreen_filter_data = data;
-	data->root_filters->free_animation_activation_filter = workspace_switch_animation_filter;
-	data->root_filters->free_animation_activation_filter_data = data;
 	data->root_filters->workspace_filter = workspace_switch_workspace_filter;
 	data->root_filters->workspace_filter_data = data;
-	data->root_filters->container_filter = workspace_switch_container_filter;
-	data->root_filters->container_filter_data = data;
 
-	double delta;
 	if (down) {
-		delta = output->height + max_y_from - (from_y + from_height)
+		data->delta = output->height + max_y_from - (from_y + from_height)
 			+ (from_y - min_y_to);
 	} else {
-		delta = output->height + max_y_to - (from_y + from_height)
+		data->delta = output->height + max_y_to - (from_y + from_height)
 			+ (from_y - min_y_from);
-		delta = -delta;
+		data->delta = -data->delta;
+	}
+	// Nothing but the workspaces is arranged differently, make sure they
+	// are part of the transaction
+	node_set_dirty(&to->node);
+	if (data->from) {
+		node_set_dirty(&data->from->node);
 	}
-	add_delta_to_containers(data->to_containers, add_delta_to_current, delta);
-	add_delta_to_containers(data->from_containers, add_delta_to_pending, -delta);
 
 	struct sway_animation_callbacks *callbacks = animation_get_callbacks();
+	data->step = callbacks->callback_step;
+	data->step_data = callbacks->callback_step_data;
+	callbacks->callback_step = workspace_switch_callback_step;
+	callbacks->callback_step_data = data;
 	callbacks->callback_end = workspace_switch_callback_end;
 	callbacks->callback_end_data = data;
 	animation_set_callbacks(callbacks);
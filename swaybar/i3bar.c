@@ -5,6 +5,7 @@
 #include <string.h>
 #include <unistd.h>
 #include "log.h"
+#include "stringop.h"
 #include "swaybar/bar.h"
 #include "swaybar/config.h"
 #include "swaybar/i3bar.h"
@@ -40,82 +41,139 @@ static bool i3bar_parse_json_color(json_object *json, uint32_t *color) {
 	return color_set;
 }
 
-static void i3bar_parse_json(struct status_line *status,
-		struct json_object *json_array) {
-	struct i3bar_block *block, *tmp;
-	wl_list_for_each_safe(block, tmp, &status->blocks, link) {
-		wl_list_remove(&block->link);
-		i3bar_block_unref(block);
+static struct i3bar_block *i3bar_parse_json_block(json_object *json) {
+	json_object *full_text, *short_text, *color, *min_width, *align, *urgent;
+	json_object *name, *instance, *separator, *separator_block_width;
+	json_object *background, *border, *border_top, *border_bottom;
+	json_object *border_left, *border_right, *markup;
+	json_object_object_get_ex(json, "full_text", &full_text);
+	json_object_object_get_ex(json, "short_text", &short_text);
+	json_object_object_get_ex(json, "color", &color);
+	json_object_object_get_ex(json, "min_width", &min_width);
+	json_object_object_get_ex(json, "align", &align);
+	json_object_object_get_ex(json, "urgent", &urgent);
+	json_object_object_get_ex(json, "name", &name);
+	json_object_object_get_ex(json, "instance", &instance);
+	json_object_object_get_ex(json, "markup", &markup);
+	json_object_object_get_ex(json, "separator", &separator);
+	json_object_object_get_ex(json, "separator_block_width", &separator_block_width);
+	json_object_object_get_ex(json, "background", &background);
+	json_object_object_get_ex(json, "border", &border);
+	json_object_object_get_ex(json, "border_top", &border_top);
+	json_object_object_get_ex(json, "border_bottom", &border_bottom);
+	json_object_object_get_ex(json, "border_left", &border_left);
+	json_object_object_get_ex(json, "border_right", &border_right);
+
+	struct i3bar_block *block = calloc(1, sizeof(struct i3bar_block));
+	block->ref_count = 1;
+	block->full_text = full_text ?
+		strdup(json_object_get_string(full_text)) : NULL;
+	block->short_text = short_text ?
+		strdup(json_object_get_string(short_text)) : NULL;
+	block->color_set = i3bar_parse_json_color(color, &block->color);
+	if (min_width) {
+		json_type type = json_object_get_type(min_width);
+		if (type == json_type_int) {
+			block->min_width = json_object_get_int(min_width);
+		} else if (type == json_type_string) {
+			/* the width will be calculated when rendering */
+			block->min_width_str = strdup(json_object_get_string(min_width));
+		}
+	}
+	block->align = strdup(align ? json_object_get_string(align) : "left");
+	block->urgent = urgent ? json_object_get_int(urgent) : false;
+	block->name = name ? strdup(json_object_get_string(name)) : NULL;
+	block->instance = instance ?
+		strdup(json_object_get_string(instance)) : NULL;
+	if (markup) {
+		block->markup = false;
+		const char *markup_str = json_object_get_string(markup);
+		if (strcmp(markup_str, "pango") == 0) {
+			block->markup = true;
+		}
 	}
+	block->separator = separator ? json_object_get_int(separator) : true;
+	block->separator_block_width = separator_block_width ?
+		json_object_get_int(separator_block_width) : 9;
+	// Airblader features
+	i3bar_parse_json_color(background, &block->background);
+	block->border_set = i3bar_parse_json_color(border, &block->border);
+	block->border_top = border_top ? json_object_get_int(border_top) : 1;
+	block->border_bottom = border_bottom ?
+		json_object_get_int(border_bottom) : 1;
+	block->border_left = border_left ? json_object_get_int(border_left) : 1;
+	block->border_right = border_right ?
+		json_object_get_int(border_right) : 1;
+	return block;
+}
+
+static bool i3bar_block_equal(struct i3bar_block *a, struct i3bar_block *b) {
+	return lenient_strcmp(a->full_text, b->full_text) == 0 &&
+		lenient_strcmp(a->short_text, b->short_text) == 0 &&
+		lenient_strcmp(a->align, b->align) == 0 &&
+		lenient_strcmp(a->min_width_str, b->min_width_str) == 0 &&
+		lenient_strcmp(a->name, b->name) == 0 &&
+		lenient_strcmp(a->instance, b->instance) == 0 &&
+		a->urgent == b->urgent &&
+		a->color_set == b->color_set &&
+		(!a->color_set || a->color == b->color) &&
+		a->min_width == b->min_width &&
+		a->separator == b->separator &&
+		a->separator_block_width == b->separator_block_width &&
+		a->markup == b->markup &&
+		a->background == b->background &&
+		a->border_set == b->border_set &&
+		(!a->border_set || a->border == b->border) &&
+		a->border_top == b->border_top &&
+		a->border_bottom == b->border_bottom &&
+		a->border_left == b->border_left &&
+		a->border_right == b->border_right;
+}
+
+/**
+ * Updates status->blocks from the json array, keeping the existing block at
+ * each position if it did not change. Returns true if any block was added,
+ * removed or modified.
+ */
+static bool i3bar_parse_json(struct status_line *status,
+		struct json_object *json_array) {
+	// status->blocks is stored in reverse order, so the block for the first
+	// array element is at the tail of the list
+	struct wl_list old_blocks;
+	wl_list_init(&old_blocks);
+	wl_list_insert_list(&old_blocks, &status->blocks);
+	wl_list_init(&status->blocks);
+
+	bool changed = false;
 	for (size_t i = 0; i < json_object_array_length(json_array); ++i) {
-		json_object *full_text, *short_text, *color, *min_width, *align, *urgent;
-		json_object *name, *instance, *separator, *separator_block_width;
-		json_object *background, *border, *border_top, *border_bottom;
-		json_object *border_left, *border_right, *markup;
 		json_object *json = json_object_array_get_idx(json_array, i);
 		if (!json) {
 			continue;
 		}
-		json_object_object_get_ex(json, "full_text", &full_text);
-		json_object_object_get_ex(json, "short_text", &short_text);
-		json_object_object_get_ex(json, "color", &color);
-		json_object_object_get_ex(json, "min_width", &min_width);
-		json_object_object_get_ex(json, "align", &align);
-		json_object_object_get_ex(json, "urgent", &urgent);
-		json_object_object_get_ex(json, "name", &name);
-		json_object_object_get_ex(json, "instance", &instance);
-		json_object_object_get_ex(json, "markup", &markup);
-		json_object_object_get_ex(json, "separator", &separator);
-		json_object_object_get_ex(json, "separator_block_width", &separator_block_width);
-		json_object_object_get_ex(json, "background", &background);
-		json_object_object_get_ex(json, "border", &border);
-		json_object_object_get_ex(json, "border_top", &border_top);
-		json_object_object_get_ex(json, "border_bottom", &border_bottom);
-		json_object_object_get_ex(json, "border_left", &border_left);
-		json_object_object_get_ex(json, "border_right", &border_right);
-
-		struct i3bar_block *block = calloc(1, sizeof(struct i3bar_block));
-		block->ref_count = 1;
-		block->full_text = full_text ?
-			strdup(json_object_get_string(full_text)) : NULL;
-		block->short_text = short_text ?
-			strdup(json_object_get_string(short_text)) : NULL;
-		block->color_set = i3bar_parse_json_color(color, &block->color);
-		if (min_width) {
-			json_type type = json_object_get_type(min_width);
-			if (type == json_type_int) {
-				block->min_width = json_object_get_int(min_width);
-			} else if (type == json_type_string) {
-				/* the width will be calculated when rendering */
-				block->min_width_str = strdup(json_object_get_string(min_width));
-			}
+		struct i3bar_block *block = i3bar_parse_json_block(json);
+		struct i3bar_block *old = NULL;
+		if (!wl_list_empty(&old_blocks)) {
+			old = wl_container_of(old_blocks.prev, old, link);
+			wl_list_remove(&old->link);
 		}
-		block->align = strdup(align ? json_object_get_string(align) : "left");
-		block->urgent = urgent ? json_object_get_int(urgent) : false;
-		block->name = name ? strdup(json_object_get_string(name)) : NULL;
-		block->instance = instance ?
-			strdup(json_object_get_string(instance)) : NULL;
-		if (markup) {
-			block->markup = false;
-			const char *markup_str = json_object_get_string(markup);
-			if (strcmp(markup_str, "pango") == 0) {
-				block->markup = true;
-			}
+		if (old && i3bar_block_equal(old, block)) {
+			i3bar_block_unref(block);
+			block = old;
+		} else {
+			i3bar_block_unref(old);
+			block->dirty = true;
+			changed = true;
 		}
-		block->separator = separator ? json_object_get_int(separator) : true;
-		block->separator_block_width = separator_block_width ?
-			json_object_get_int(separator_block_width) : 9;
-		// Airblader features
-		i3bar_parse_json_color(background, &block->background);
-		block->border_set = i3bar_parse_json_color(border, &block->border);
-		block->border_top = border_top ? json_object_get_int(border_top) : 1;
-		block->border_bottom = border_bottom ?
-			json_object_get_int(border_bottom) : 1;
-		block->border_left = border_left ? json_object_get_int(border_left) : 1;
-		block->border_right = border_right ?
-			json_object_get_int(border_right) : 1;
 		wl_list_insert(&status->blocks, &block->link);
 	}
+
+	struct i3bar_block *block, *tmp;
+	wl_list_for_each_safe(block, tmp, &old_blocks, link) {
+		wl_list_remove(&block->link);
+		i3bar_block_unref(block);
+		changed = true;
+	}
+	return changed;
 }
 
 bool i3bar_handle_readable(struct status_line *status) {
@@ -152,6 +210,7 @@ bool i3bar_handle_readable(struct status_line *status) {
 	struct json_object *last_object = NULL;
 	struct json_object *test_object;
 	size_t buffer_pos = 0;
+	size_t last_object_len = 0;
 	while (true) {
 		// since the incoming stream is an infinite array
 		// parsing is split into two parts
@@ -187,6 +246,20 @@ bool i3bar_handle_readable(struct status_line *status) {
 						json_object_put(last_object);
 					}
 					last_object = test_object;
+					// keep the raw bytes, the buffer is reused by the next read
+					last_object_len = status->tokener->char_offset;
+					if (last_object_len > status->pending_json_size) {
+						char *pending = realloc(status->pending_json, last_object_len);
+						if (!pending) {
+							json_object_put(last_object);
+							status_error(status, "[failed to allocate buffer]");
+							return true;
+						}
+						status->pending_json = pending;
+						status->pending_json_size = last_object_len;
+					}
+					memcpy(status->pending_json, &status->buffer[buffer_pos],
+							last_object_len);
 				} else {
 					json_object_put(test_object);
 				}
@@ -256,14 +329,31 @@ bool i3bar_handle_readable(struct status_line *status) {
 		}
 	}
 
-	if (last_object) {
-		sway_log(SWAY_DEBUG, "Rendering last received json");
-		i3bar_parse_json(status, last_object);
+	if (!last_object) {
+		return false;
+	}
+
+	// most status generators resend the same array until something changes,
+	// in which case there is nothing to parse or render
+	if (last_object_len == status->last_json_len && memcmp(status->pending_json,
+				status->last_json, last_object_len) == 0) {
 		json_object_put(last_object);
-		return true;
-	} else {
 		return false;
 	}
+	char *tmp_json = status->last_json;
+	size_t tmp_size = status->last_json_size;
+	status->last_json = status->pending_json;
+	status->last_json_size = status->pending_json_size;
+	status->last_json_len = last_object_len;
+	status->pending_json = tmp_json;
+	status->pending_json_size = tmp_size;
+
+	bool changed = i3bar_parse_json(status, last_object);
+	json_object_put(last_object);
+	if (changed) {
+		sway_log(SWAY_DEBUG, "Rendering last received json");
+	}
+	return changed;
 }
 
 enum hotspot_event_handling i3bar_block_send_click(struct status_line *status,
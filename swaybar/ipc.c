@@ -5,6 +5,7 @@
 #include <strings.h>
 #include <json.h>
 #include "swaybar/config.h"
+#include "swaybar/i3bar.h"
 #include "swaybar/ipc.h"
 #include "swaybar/status_line.h"
 #if HAVE_TRAY
@@ -615,6 +616,14 @@ static bool handle_barconfig_update(struct swaybar *bar, const char *payload,
 		}
 	}
 
+	if (bar->status && !pango_font_description_equal(oldcfg->font_description,
+				newcfg->font_description)) {
+		struct i3bar_block *block;
+		wl_list_for_each(block, &bar->status->blocks, link) {
+			block->dirty = true;
+		}
+	}
+
 	if (bar->status && (!newcfg->status_command ||
 				strcmp(newcfg->status_command, oldcfg->status_command) != 0)) {
 		status_line_free(bar->status);
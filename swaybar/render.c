@@ -174,36 +174,62 @@ static void i3bar_block_unref_callback(void *data) {
 	i3bar_block_unref(data);
 }
 
+/**
+ * Measures the text of a block, unless it was already measured for this scale
+ * and didn't change since.
+ */
+static void measure_status_block(cairo_t *cairo,
+		struct swaybar_output *output, struct i3bar_block *block) {
+	if (!block->dirty && block->measured_scale == output->scale) {
+		return;
+	}
+	struct swaybar_config *config = output->bar->config;
+	get_text_size(cairo, config->font_description, &block->full_width,
+			&block->full_height, NULL, 1, block->markup, "%s", block->full_text);
+	if (block->short_text && *block->short_text) {
+		get_text_size(cairo, config->font_description, &block->short_width,
+				&block->short_height, NULL, 1, block->markup, "%s",
+				block->short_text);
+	}
+	if (block->min_width_str) {
+		get_text_size(cairo, config->font_description, &block->min_text_width,
+				NULL, NULL, 1, block->markup, "%s", block->min_width_str);
+	}
+	block->measured_scale = output->scale;
+	block->dirty = false;
+}
+
+// Only valid once the block is measured
+static int status_block_min_width(struct i3bar_block *block) {
+	return block->min_width_str ? block->min_text_width : block->min_width;
+}
+
 static uint32_t render_status_block(struct render_context *ctx,
 		struct i3bar_block *block, double *x, bool edge, bool use_short_text) {
 	if (!block->full_text || !*block->full_text) {
 		return 0;
 	}
 
+	cairo_t *cairo = ctx->cairo;
+	struct swaybar_output *output = ctx->output;
+	struct swaybar_config *config = output->bar->config;
+	measure_status_block(cairo, output, block);
+
 	char* text = block->full_text;
+	int text_width = block->full_width;
+	int text_height = block->full_height;
 	if (use_short_text && block->short_text && *block->short_text) {
 		text = block->short_text;
+		text_width = block->short_width;
+		text_height = block->short_height;
 	}
 
-	cairo_t *cairo = ctx->cairo;
-	struct swaybar_output *output = ctx->output;
-	struct swaybar_config *config = output->bar->config;
-	int text_width, text_height;
-	get_text_size(cairo, config->font_description, &text_width, &text_height, NULL, 1,
-			block->markup, "%s", text);
-
 	int margin = 3;
 	double ws_vertical_padding = config->status_padding;
 
 	int width = text_width;
-	if (block->min_width_str) {
-		int w;
-		get_text_size(cairo, config->font_description, &w, NULL, NULL, 1, block->markup,
-				"%s", block->min_width_str);
-		block->min_width = w;
-	}
-	if (width < block->min_width) {
-		width = block->min_width;
+	if (width < status_block_min_width(block)) {
+		width = status_block_min_width(block);
 	}
 
 	double block_width = width;
@@ -352,24 +378,15 @@ static void predict_status_block_pos(cairo_t *cairo,
 	}
 
 	struct swaybar_config *config = output->bar->config;
-
-	int text_width, text_height;
-	get_text_size(cairo, config->font_description, &text_width, &text_height, NULL, 1,
-			block->markup, "%s", block->full_text);
+	measure_status_block(cairo, output, block);
+	int text_height = block->full_height;
 
 	int margin = 3;
 	double ws_vertical_padding = config->status_padding;
 
-	int width = text_width;
-
-	if (block->min_width_str) {
-		int w;
-		get_text_size(cairo, config->font_description, &w, NULL, NULL,
-				1, block->markup, "%s", block->min_width_str);
-		block->min_width = w;
-	}
-	if (width < block->min_width) {
-		width = block->min_width;
+	int width = block->full_width;
+	if (width < status_block_min_width(block)) {
+		width = status_block_min_width(block);
 	}
 
 	uint32_t ideal_height = text_height + ws_vertical_padding * 2;
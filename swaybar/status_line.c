@@ -199,6 +199,8 @@ void status_line_free(struct status_line *status) {
 			i3bar_block_unref(block);
 		}
 		json_tokener_free(status->tokener);
+		free(status->last_json);
+		free(status->pending_json);
 	}
 	free(status->buffer);
 	free(status);
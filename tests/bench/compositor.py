@@ -0,0 +1,306 @@
+#!/usr/bin/env python3
+"""
+End-to-end benchmark for scroll.
+
+Boots scroll on the headless backend with the pixman renderer, opens
+synthetic Wayland clients and runs scripted scenarios over IPC. For each
+scenario it reports frame time percentiles (time spent building and
+committing a frame), committed transactions per second, CPU time and peak
+RSS as JSON.
+
+Usage: compositor.py --scroll PATH --client PATH [--windows N] [--output FILE]
+"""
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+from pathlib import Path
+from typing import Callable
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent))
+from test_utils import ScrollInstance, run_compositor  # noqa: E402
+
+CONFIG = "workspace 1\nanimations enabled no\n"
+OUTPUT = "HEADLESS-1"
+
+
+def percentile(samples: list[int], p: int) -> float:
+    if not samples:
+        return 0.0
+    ordered = sorted(samples)
+    return ordered[(len(ordered) - 1) * p // 100] / 1e6
+
+
+def rss_kb(pid: int) -> dict[str, int]:
+    result = {}
+    with open(f"/proc/{pid}/status") as status:
+        for line in status:
+            key, _, value = line.partition(":")
+            if key in ("VmRSS", "VmHWM"):
+                result[key] = int(value.split()[0])
+    return result
+
+
+def cpu_s(pid: int) -> float:
+    with open(f"/proc/{pid}/stat") as stat:
+        # Fields after the command name, which may contain spaces
+        fields = stat.read().rpartition(")")[2].split()
+    # utime and stime are fields 14 and 15
+    return (int(fields[11]) + int(fields[12])) / os.sysconf("SC_CLK_TCK")
+
+
+def get_output(inst: ScrollInstance) -> dict:
+    for output in inst.get_outputs():
+        if output["name"] == OUTPUT:
+            return output
+    raise RuntimeError(f"Output {OUTPUT} not found")
+
+
+def frames_built(inst: ScrollInstance) -> int:
+    return get_output(inst)["scanout"]["frames"]
+
+
+def wait_for_frame(inst: ScrollInstance, frames: int) -> dict:
+    for _ in range(100):
+        output = get_output(inst)
+        if output["scanout"]["frames"] > frames:
+            return output
+        time.sleep(0.02)
+    raise TimeoutError("No frame was rendered")
+
+
+def render_frame(inst: ScrollInstance) -> dict:
+    # Moving the cursor damages the output, forcing a frame that reflects
+    # the current state once the compositor is idle
+    inst.wait_for_idle()
+    frames = frames_built(inst)
+    assert inst.cmd("seat - cursor move 1 1")[0]["success"]
+    return wait_for_frame(inst, frames)
+
+
+def frame_times(inst: ScrollInstance) -> list[int]:
+    return inst.execute_lua(f"""
+        for _, output in ipairs(scroll.root_get_outputs()) do
+            if scroll.output_get_name(output) == "{OUTPUT}" then
+                return scroll.output_get_frame_times(output)
+            end
+        end
+        return {{}}
+    """) or []
+
+
+def transactions(inst: ScrollInstance) -> int:
+    return inst.execute_lua("return scroll.transactions_committed()")
+
+
+def count_views(node: dict) -> int:
+    count = 1 if node.get("pid") else 0
+    for child in node.get("nodes", []) + node.get("floating_nodes", []):
+        count += count_views(child)
+    return count
+
+
+def command(inst: ScrollInstance, cmd: str) -> None:
+    res = inst.cmd(cmd)
+    if not all(r.get("success") for r in res):
+        raise RuntimeError(f"Command '{cmd}' failed: {res}")
+
+
+def measure(inst: ScrollInstance, name: str, run: Callable[[], int]) -> dict:
+    inst.wait_for_idle(timeout=30)
+    frames = frames_built(inst)
+    txns = transactions(inst)
+    cpu = cpu_s(inst.proc.pid)
+    start = time.monotonic()
+
+    steps = run()
+    inst.wait_for_idle(timeout=30)
+
+    elapsed = time.monotonic() - start
+    cpu = cpu_s(inst.proc.pid) - cpu
+    frames = frames_built(inst) - frames
+    txns = transactions(inst) - txns
+    # The ring only keeps the last frames, which is enough for percentiles
+    samples = frame_times(inst)[-frames:] if frames > 0 else []
+    memory = rss_kb(inst.proc.pid)
+    return {
+        "name": name,
+        "steps": steps,
+        "duration_s": round(elapsed, 3),
+        "frames": frames,
+        "frame_time_ms": {
+            "p50": percentile(samples, 50),
+            "p90": percentile(samples, 90),
+            "p99": percentile(samples, 99),
+            "max": max(samples) / 1e6 if samples else 0.0,
+        },
+        "transactions": txns,
+        "transactions_per_s": round(txns / elapsed, 1) if elapsed > 0 else 0.0,
+        "cpu_s": round(cpu, 3),
+        "cpu_us_per_step": round(cpu * 1e6 / steps, 1) if steps > 0 else 0.0,
+        "rss_kb": memory.get("VmRSS", 0),
+        "peak_rss_kb": memory.get("VmHWM", 0),
+    }
+
+
+def run(args: argparse.Namespace, inst: ScrollInstance) -> list[dict]:
+    env = os.environ.copy()
+    env["WAYLAND_DISPLAY"] = inst.getenv("WAYLAND_DISPLAY")
+    clients: list[subprocess.Popen] = []
+    results = []
+
+    def open_windows() -> int:
+        for i in range(args.windows):
+            clients.append(
+                subprocess.Popen([args.client, f"bench {i}", "bench"], env=env)
+            )
+        deadline = time.monotonic() + 60
+        while count_views(inst.get_tree()) < args.windows:
+            if time.monotonic() > deadline:
+                raise RuntimeError("Clients did not map")
+            time.sleep(0.05)
+        return args.windows
+
+    def scroll_columns() -> int:
+        for _ in range(args.windows):
+            command(inst, "focus left")
+        for _ in range(args.windows):
+            command(inst, "focus right")
+        return 2 * args.windows
+
+    def overview() -> int:
+        for _ in range(args.repeat):
+            command(inst, "scale_workspace overview")
+            inst.wait_for_idle(timeout=30)
+            command(inst, "scale_workspace overview")
+            inst.wait_for_idle(timeout=30)
+        return 2 * args.repeat
+
+    def jump() -> int:
+        for _ in range(args.repeat):
+            command(inst, "jump")
+            inst.wait_for_idle(timeout=30)
+            # Any click ends jump mode without picking a window
+            command(inst, "seat - cursor press button1")
+            command(inst, "seat - cursor release button1")
+            inst.wait_for_idle(timeout=30)
+        return args.repeat
+
+    def workspace_switch() -> int:
+        inst.execute_lua("scroll.animations_set_enabled(true)")
+        try:
+            for _ in range(args.repeat):
+                command(inst, "workspace 2")
+                inst.wait_for_idle(timeout=30)
+                command(inst, "workspace 1")
+                inst.wait_for_idle(timeout=30)
+        finally:
+            inst.execute_lua("scroll.animations_set_enabled(false)")
+        return 2 * args.repeat
+
+    def resize_storm() -> int:
+        for i in range(args.repeat * 10):
+            command(inst, f"resize {'grow' if i % 2 else 'shrink'} width 20 px")
+        return args.repeat * 10
+
+    frame_count = [0]
+    frame_lock = threading.Lock()
+
+    def read_frames(proc: subprocess.Popen) -> None:
+        for _ in proc.stdout:
+            with frame_lock:
+                frame_count[0] += 1
+
+    def open_committing_windows() -> int:
+        # As many more clients on another workspace, each committing again
+        # on every frame callback
+        command(inst, "workspace 3")
+        for i in range(args.windows):
+            proc = subprocess.Popen(
+                [args.client, f"commits {i}", "bench", "frames"],
+                env=env, stdout=subprocess.PIPE, text=True,
+            )
+            clients.append(proc)
+            threading.Thread(target=read_frames, args=(proc,), daemon=True).start()
+        deadline = time.monotonic() + 60
+        while count_views(inst.get_tree()) < 2 * args.windows:
+            if time.monotonic() > deadline:
+                raise RuntimeError("Clients did not map")
+            time.sleep(0.05)
+        return args.windows
+
+    def surface_commits() -> int:
+        # The steps are surface commits, so cpu_us_per_step is what one
+        # commit costs the compositor with all those windows mapped
+        with frame_lock:
+            start = frame_count[0]
+        time.sleep(args.commit_time)
+        with frame_lock:
+            return frame_count[0] - start
+
+    scenarios = [
+        ("open_windows", open_windows),
+        ("scroll_columns", scroll_columns),
+        ("overview", overview),
+        ("jump", jump),
+        ("workspace_switch", workspace_switch),
+        ("resize_storm", resize_storm),
+        ("open_committing_windows", open_committing_windows),
+        ("surface_commits", surface_commits),
+    ]
+    try:
+        for name, scenario in scenarios:
+            if args.scenario and name not in args.scenario:
+                continue
+            results.append(measure(inst, name, scenario))
+    finally:
+        for client in clients:
+            client.terminate()
+        for client in clients:
+            try:
+                client.wait(timeout=2)
+            except subprocess.TimeoutExpired:
+                client.kill()
+    return results
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--scroll", required=True, help="the scroll binary")
+    parser.add_argument("--client", required=True, help="wayland-test-client")
+    parser.add_argument("--windows", type=int, default=100)
+    parser.add_argument("--repeat", type=int, default=10)
+    parser.add_argument("--commit-time", type=float, default=5.0,
+                        help="seconds the surface_commits scenario runs for")
+    parser.add_argument("--scenario", action="append",
+                        help="only run this scenario, may be repeated")
+    parser.add_argument("--output", help="write the JSON report to this file")
+    args = parser.parse_args()
+
+    # Inherited by the compositor through run_compositor()
+    os.environ["WLR_RENDERER"] = "pixman"
+
+    with tempfile.TemporaryDirectory(prefix="scroll-bench-") as temp_dir:
+        with run_compositor(
+            os.path.abspath(args.scroll), Path(temp_dir), CONFIG, debug=False
+        ) as inst:
+            results = run(args, inst)
+
+    report = json.dumps({
+        "renderer": "pixman",
+        "windows": args.windows,
+        "repeat": args.repeat,
+        "scenarios": results,
+    }, indent=2)
+    if args.output:
+        Path(args.output).write_text(report + "\n")
+    print(report)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
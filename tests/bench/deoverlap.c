@@ -0,0 +1,166 @@
+/*
+ * Benchmark for the floating window de-overlap used by jump and overview.
+ *
+ * Generates random floating layouts and runs the de-overlap loop twice: with
+ * the original all-pairs recount on every step, and with the incremental
+ * overlap set. Both must end with the same positions.
+ *
+ * Usage: deoverlap-bench [max windows]
+ */
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sway/tree/overlap.h"
+
+#define MAX_STEPS 1000000
+
+struct window {
+	double x, y, width, height;
+};
+
+static uint64_t rng_state;
+
+static double rng_range(double min, double max) {
+	// xorshift64, so layouts are the same with every libc
+	rng_state ^= rng_state << 13;
+	rng_state ^= rng_state >> 7;
+	rng_state ^= rng_state << 17;
+	return min + (double)(rng_state % 1000000) / 1000000.0 * (max - min);
+}
+
+static void generate(struct window *windows, int length, uint64_t seed) {
+	rng_state = seed * 2654435761u + 1;
+	for (int i = 0; i < length; ++i) {
+		windows[i].width = round(rng_range(200, 800));
+		windows[i].height = round(rng_range(150, 600));
+		windows[i].x = round(rng_range(0, 1920 - windows[i].width));
+		windows[i].y = round(rng_range(0, 1080 - windows[i].height));
+	}
+}
+
+static bool windows_overlap(const struct window *w1, const struct window *w2) {
+	if (w1->x >= w2->x + w2->width ||
+		w1->x + w1->width <= w2->x ||
+		w1->y >= w2->y + w2->height ||
+		w1->y + w1->height <= w2->y) {
+		return false;
+	}
+	return true;
+}
+
+static void move_out(struct window *windows, int length, int index) {
+	struct window *window = &windows[index];
+	double maxx = -DBL_MAX, maxy = -DBL_MAX;
+	for (int i = 0; i < length; ++i) {
+		if (i != index && windows_overlap(&windows[i], window)) {
+			maxx = fmax(maxx, windows[i].x + windows[i].width);
+			maxy = fmax(maxy, windows[i].y + windows[i].height);
+		}
+	}
+	const double dx = maxx - window->x;
+	const double dy = maxy - window->y;
+	if (fabs(dx) < fabs(dy)) {
+		window->x += dx;
+	} else {
+		window->y += dy;
+	}
+}
+
+static int naive_maximum(struct window *windows, int length) {
+	int max_index = -1;
+	int max_over = 0;
+	for (int i = 0; i < length; ++i) {
+		int over = 0;
+		for (int j = 0; j < length; ++j) {
+			if (i != j && windows_overlap(&windows[i], &windows[j])) {
+				++over;
+			}
+		}
+		if (over > max_over) {
+			max_over = over;
+			max_index = i;
+		}
+	}
+	return max_index;
+}
+
+static int deoverlap_naive(struct window *windows, int length) {
+	int steps = 0;
+	int index;
+	while ((index = naive_maximum(windows, length)) >= 0 && steps < MAX_STEPS) {
+		move_out(windows, length, index);
+		++steps;
+	}
+	return steps;
+}
+
+static int deoverlap_incremental(struct window *windows, int length) {
+	struct overlap_set *set = overlap_set_create(length, true);
+	for (int i = 0; i < length; ++i) {
+		overlap_set_add(set, windows[i].x, windows[i].y,
+			windows[i].width, windows[i].height, true, 0);
+	}
+	overlap_set_compute(set);
+	int steps = 0;
+	int index;
+	while ((index = overlap_set_maximum(set)) >= 0 && steps < MAX_STEPS) {
+		move_out(windows, length, index);
+		overlap_set_move(set, index, windows[index].x, windows[index].y, true, 0);
+		++steps;
+	}
+	overlap_set_destroy(set);
+	return steps;
+}
+
+static double elapsed_ms(const struct timespec *start) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) * 1000.0 +
+		(now.tv_nsec - start->tv_nsec) / 1000000.0;
+}
+
+int main(int argc, char **argv) {
+	int max_windows = argc > 1 ? atoi(argv[1]) : 500;
+	const int sizes[] = { 10, 25, 50, 100, 200, 300, 500 };
+	int failed = 0;
+
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+		int length = sizes[s];
+		if (length > max_windows) {
+			break;
+		}
+		struct window *naive = calloc(length, sizeof(struct window));
+		struct window *incremental = calloc(length, sizeof(struct window));
+		if (!naive || !incremental) {
+			fprintf(stderr, "Out of memory\n");
+			return 1;
+		}
+		generate(naive, length, length);
+		memcpy(incremental, naive, length * sizeof(struct window));
+
+		struct timespec start;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		int naive_steps = deoverlap_naive(naive, length);
+		double naive_ms = elapsed_ms(&start);
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		int incremental_steps = deoverlap_incremental(incremental, length);
+		double incremental_ms = elapsed_ms(&start);
+
+		bool same = naive_steps == incremental_steps &&
+			memcmp(naive, incremental, length * sizeof(struct window)) == 0;
+		printf("%4d windows: %6d moves, all pairs %10.2f ms, incremental %10.2f ms%s\n",
+			length, incremental_steps, naive_ms, incremental_ms,
+			same ? "" : "  MISMATCH");
+		if (!same) {
+			failed = 1;
+		}
+		free(naive);
+		free(incremental);
+	}
+	return failed;
+}
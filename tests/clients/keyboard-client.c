@@ -0,0 +1,59 @@
+#include <stdio.h>
+#include <string.h>
+#include <wayland-client.h>
+#include "virtual-keyboard-unstable-v1-client-protocol.h"
+
+// A virtual keyboard on the default seat, giving the compositor a keyboard
+// input device to configure. It never sends any key.
+//
+// Usage: wayland-keyboard-client
+
+struct client_state {
+	struct wl_seat *seat;
+	struct zwp_virtual_keyboard_manager_v1 *manager;
+};
+
+static void registry_global(void *data, struct wl_registry *registry, uint32_t name, const char *interface, uint32_t version) {
+	struct client_state *state = data;
+	if (strcmp(interface, wl_seat_interface.name) == 0 && !state->seat) {
+		state->seat = wl_registry_bind(registry, name, &wl_seat_interface, 1);
+	} else if (strcmp(interface, zwp_virtual_keyboard_manager_v1_interface.name) == 0) {
+		state->manager = wl_registry_bind(registry, name, &zwp_virtual_keyboard_manager_v1_interface, 1);
+	}
+}
+static void registry_global_remove(void *data, struct wl_registry *registry, uint32_t name) {}
+static const struct wl_registry_listener registry_listener = { registry_global, registry_global_remove };
+
+int main(void) {
+	struct client_state state = {0};
+
+	struct wl_display *display = wl_display_connect(NULL);
+	if (!display) {
+		fprintf(stderr, "Failed to connect to Wayland display\n");
+		return 1;
+	}
+
+	struct wl_registry *registry = wl_display_get_registry(display);
+	wl_registry_add_listener(registry, &registry_listener, &state);
+	wl_display_roundtrip(display);
+
+	if (!state.seat || !state.manager) {
+		fprintf(stderr, "Missing globals\n");
+		return 1;
+	}
+
+	struct zwp_virtual_keyboard_v1 *keyboard =
+		zwp_virtual_keyboard_manager_v1_create_virtual_keyboard(state.manager, state.seat);
+	wl_display_roundtrip(display);
+
+	while (wl_display_dispatch(display) != -1) {
+		// Loop
+	}
+
+	zwp_virtual_keyboard_v1_destroy(keyboard);
+	zwp_virtual_keyboard_manager_v1_destroy(state.manager);
+	wl_seat_destroy(state.seat);
+	wl_registry_destroy(registry);
+	wl_display_disconnect(display);
+	return 0;
+}
@@ -0,0 +1,196 @@
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <wayland-client.h>
+#include "wlr-layer-shell-unstable-v1-client-protocol.h"
+
+// A panel anchored to the top of the output. It redraws itself for a number
+// of frames, sending its unchanged layer state again with each commit like
+// toolkits do, and then optionally grows taller once.
+//
+// Usage: wayland-layer-client <namespace> <frames> <exclusive-zone> [grow]
+
+#define HEIGHT 30
+#define GROWN_HEIGHT 40
+
+struct client_state {
+	struct wl_display *display;
+	struct wl_registry *registry;
+	struct wl_compositor *compositor;
+	struct wl_shm *shm;
+	struct zwlr_layer_shell_v1 *layer_shell;
+	struct wl_surface *surface;
+	struct zwlr_layer_surface_v1 *layer_surface;
+	struct wl_buffer *buffer;
+	uint32_t *pixels;
+	int width, height;
+	int buffer_width, buffer_height;
+	int frames;
+	int exclusive_zone;
+	bool grow;
+	bool drawing;
+};
+
+static void shm_format(void *data, struct wl_shm *wl_shm, uint32_t format) {}
+static const struct wl_shm_listener shm_listener = { shm_format };
+
+static void registry_global(void *data, struct wl_registry *registry, uint32_t name, const char *interface, uint32_t version) {
+	struct client_state *state = data;
+	if (strcmp(interface, wl_compositor_interface.name) == 0) {
+		state->compositor = wl_registry_bind(registry, name, &wl_compositor_interface, 4);
+	} else if (strcmp(interface, wl_shm_interface.name) == 0) {
+		state->shm = wl_registry_bind(registry, name, &wl_shm_interface, 1);
+		wl_shm_add_listener(state->shm, &shm_listener, state);
+	} else if (strcmp(interface, zwlr_layer_shell_v1_interface.name) == 0) {
+		state->layer_shell = wl_registry_bind(registry, name, &zwlr_layer_shell_v1_interface, 1);
+	}
+}
+static void registry_global_remove(void *data, struct wl_registry *registry, uint32_t name) {}
+static const struct wl_registry_listener registry_listener = { registry_global, registry_global_remove };
+
+static void create_buffer(struct client_state *state) {
+	if (state->buffer) {
+		wl_buffer_destroy(state->buffer);
+		munmap(state->pixels, state->buffer_width * 4 * state->buffer_height);
+	}
+	state->buffer_width = state->width;
+	state->buffer_height = state->height;
+	int stride = state->width * 4;
+	int size = stride * state->height;
+
+	int fd = memfd_create("scroll-test-shm", MFD_CLOEXEC);
+	if (fd < 0) {
+		perror("memfd_create");
+		exit(1);
+	}
+	if (ftruncate(fd, size) < 0) {
+		perror("ftruncate");
+		exit(1);
+	}
+	state->pixels = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (state->pixels == MAP_FAILED) {
+		perror("mmap");
+		exit(1);
+	}
+	struct wl_shm_pool *pool = wl_shm_create_pool(state->shm, fd, size);
+	state->buffer = wl_shm_pool_create_buffer(pool, 0, state->width, state->height, stride, WL_SHM_FORMAT_XRGB8888);
+	wl_shm_pool_destroy(pool);
+	close(fd);
+}
+
+static void send_layer_state(struct client_state *state, int height) {
+	zwlr_layer_surface_v1_set_anchor(state->layer_surface,
+		ZWLR_LAYER_SURFACE_V1_ANCHOR_TOP |
+		ZWLR_LAYER_SURFACE_V1_ANCHOR_LEFT |
+		ZWLR_LAYER_SURFACE_V1_ANCHOR_RIGHT);
+	zwlr_layer_surface_v1_set_size(state->layer_surface, 0, height);
+	zwlr_layer_surface_v1_set_exclusive_zone(state->layer_surface, state->exclusive_zone);
+	zwlr_layer_surface_v1_set_margin(state->layer_surface, 0, 0, 0, 0);
+}
+
+static void draw(struct client_state *state);
+
+static void frame_done(void *data, struct wl_callback *callback, uint32_t time) {
+	struct client_state *state = data;
+	wl_callback_destroy(callback);
+	state->drawing = false;
+	if (state->frames > 0) {
+		state->frames--;
+		send_layer_state(state, HEIGHT);
+		draw(state);
+	} else if (state->grow) {
+		state->grow = false;
+		send_layer_state(state, GROWN_HEIGHT);
+		wl_surface_commit(state->surface);
+	}
+}
+static const struct wl_callback_listener frame_listener = { frame_done };
+
+static void draw(struct client_state *state) {
+	for (int i = 0; i < state->buffer_width * state->buffer_height; ++i) {
+		state->pixels[i] = 0xFF000000 | (state->frames * 4);
+	}
+	wl_surface_attach(state->surface, state->buffer, 0, 0);
+	wl_surface_damage_buffer(state->surface, 0, 0, state->buffer_width, state->buffer_height);
+	struct wl_callback *callback = wl_surface_frame(state->surface);
+	wl_callback_add_listener(callback, &frame_listener, state);
+	state->drawing = true;
+	wl_surface_commit(state->surface);
+}
+
+static void layer_surface_configure(void *data, struct zwlr_layer_surface_v1 *layer_surface,
+		uint32_t serial, uint32_t width, uint32_t height) {
+	struct client_state *state = data;
+	zwlr_layer_surface_v1_ack_configure(layer_surface, serial);
+	state->width = width;
+	state->height = height;
+	if (!state->buffer || state->width != state->buffer_width ||
+			state->height != state->buffer_height) {
+		create_buffer(state);
+	}
+	if (!state->drawing) {
+		draw(state);
+	}
+}
+
+static void layer_surface_closed(void *data, struct zwlr_layer_surface_v1 *layer_surface) {
+	exit(0);
+}
+static const struct zwlr_layer_surface_v1_listener layer_surface_listener = {
+	layer_surface_configure,
+	layer_surface_closed,
+};
+
+int main(int argc, char **argv) {
+	if (argc < 4) {
+		fprintf(stderr, "Usage: %s <namespace> <frames> <exclusive-zone> [grow]\n", argv[0]);
+		return 1;
+	}
+	struct client_state state = {0};
+	state.frames = atoi(argv[2]);
+	state.exclusive_zone = atoi(argv[3]);
+	state.grow = argc > 4 && strcmp(argv[4], "grow") == 0;
+
+	state.display = wl_display_connect(NULL);
+	if (!state.display) {
+		fprintf(stderr, "Failed to connect to Wayland display\n");
+		return 1;
+	}
+
+	state.registry = wl_display_get_registry(state.display);
+	wl_registry_add_listener(state.registry, &registry_listener, &state);
+	wl_display_roundtrip(state.display);
+
+	if (!state.compositor || !state.shm || !state.layer_shell) {
+		fprintf(stderr, "Missing globals\n");
+		return 1;
+	}
+
+	state.surface = wl_compositor_create_surface(state.compositor);
+	state.layer_surface = zwlr_layer_shell_v1_get_layer_surface(state.layer_shell,
+		state.surface, NULL, ZWLR_LAYER_SHELL_V1_LAYER_TOP, argv[1]);
+	zwlr_layer_surface_v1_add_listener(state.layer_surface, &layer_surface_listener, &state);
+	send_layer_state(&state, HEIGHT);
+	wl_surface_commit(state.surface);
+
+	while (wl_display_dispatch(state.display) != -1) {
+		// Loop
+	}
+
+	if (state.buffer) wl_buffer_destroy(state.buffer);
+	if (state.pixels) munmap(state.pixels, state.buffer_width * 4 * state.buffer_height);
+	zwlr_layer_surface_v1_destroy(state.layer_surface);
+	wl_surface_destroy(state.surface);
+	zwlr_layer_shell_v1_destroy(state.layer_shell);
+	wl_shm_destroy(state.shm);
+	wl_compositor_destroy(state.compositor);
+	wl_registry_destroy(state.registry);
+	wl_display_disconnect(state.display);
+
+	return 0;
+}
@@ -1,4 +1,5 @@
 #define _GNU_SOURCE
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -20,6 +21,8 @@ struct client_state {
 	struct wl_buffer *buffer;
 	int width, height;
 	void *shm_data;
+	bool print_frames;
+	bool frame_pending;
 };
 
 static void noop() {}
@@ -47,6 +50,25 @@ static void registry_global(void *data, struct wl_registry *registry, uint32_t n
 static void registry_global_remove(void *data, struct wl_registry *registry, uint32_t name) {}
 static const struct wl_registry_listener registry_listener = { registry_global, registry_global_remove };
 
+static void request_frame(struct client_state *state);
+
+// Prints a line per frame callback and asks for the next one right away
+static void frame_done(void *data, struct wl_callback *callback, uint32_t time) {
+	struct client_state *state = data;
+	wl_callback_destroy(callback);
+	printf("frame\n");
+	fflush(stdout);
+	request_frame(state);
+	wl_surface_commit(state->surface);
+}
+static const struct wl_callback_listener frame_listener = { frame_done };
+
+static void request_frame(struct client_state *state) {
+	struct wl_callback *callback = wl_surface_frame(state->surface);
+	wl_callback_add_listener(callback, &frame_listener, state);
+	state->frame_pending = true;
+}
+
 static void xdg_surface_configure(void *data, struct xdg_surface *xdg_surface, uint32_t serial) {
 	struct client_state *state = data;
 	xdg_surface_ack_configure(xdg_surface, serial);
@@ -82,6 +104,9 @@ static void xdg_surface_configure(void *data, struct xdg_surface *xdg_surface, u
 
 	wl_surface_attach(state->surface, state->buffer, 0, 0);
 	wl_surface_damage_buffer(state->surface, 0, 0, state->width, state->height);
+	if (state->print_frames && !state->frame_pending) {
+		request_frame(state);
+	}
 	wl_surface_commit(state->surface);
 }
 static const struct xdg_surface_listener xdg_surface_listener = { xdg_surface_configure };
@@ -101,6 +126,7 @@ int main(int argc, char **argv) {
 	const char *app_id = "test_app_id";
 	if (argc > 1) title = argv[1];
 	if (argc > 2) app_id = argv[2];
+	state.print_frames = argc > 3 && strcmp(argv[3], "frames") == 0;
 
 	state.display = wl_display_connect(NULL);
 	if (!state.display) {
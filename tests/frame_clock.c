@@ -0,0 +1,93 @@
+/*
+ * Unit test for the presentation time prediction used to sample animations,
+ * with a synthetic clock, and for the automatic max_render_time computed from
+ * injected render times.
+ */
+#include <assert.h>
+#include <stdint.h>
+#include "sway/desktop/frame_clock.h"
+
+#define MSEC INT64_C(1000000)
+#define REFRESH_60HZ 16666667
+
+static int64_t predict(int64_t now, int64_t last, uint32_t refresh, int max_render_time,
+		bool expect_feedback) {
+	int64_t predicted;
+	assert(frame_clock_predict(now, last, refresh, max_render_time, &predicted) ==
+		expect_feedback);
+	return predicted;
+}
+
+static void test_next_refresh(void) {
+	int64_t last = 1000 * MSEC;
+	// Rendering right after a refresh, or just before the next one
+	assert(predict(last + 1 * MSEC, last, REFRESH_60HZ, 0, true) == last + REFRESH_60HZ);
+	assert(predict(last + 15 * MSEC, last, REFRESH_60HZ, 10, true) == last + REFRESH_60HZ);
+	// A refresh happening right now is already too late
+	assert(predict(last + REFRESH_60HZ, last, REFRESH_60HZ, 0, true) ==
+		last + 2 * REFRESH_60HZ);
+	// Frames were skipped since the last presentation
+	assert(predict(last + 50 * MSEC, last, REFRESH_60HZ, 0, true) ==
+		last + 3 * REFRESH_60HZ);
+	assert(predict(last + 10000 * MSEC, last, REFRESH_60HZ, 0, true) ==
+		last + 600 * (int64_t)REFRESH_60HZ);
+}
+
+static void test_steady(void) {
+	// Frames rendered at a varying time in the refresh cycle are sampled
+	// exactly one refresh apart
+	int64_t last = 5000 * MSEC;
+	int jitter[] = { 1, 9, 3, 14, 0, 7 };
+	for (int i = 0; i < 6; i++) {
+		int64_t now = last + jitter[i] * MSEC;
+		int64_t predicted = predict(now, last, REFRESH_60HZ, 0, true);
+		assert(predicted == last + REFRESH_60HZ);
+		last = predicted;
+	}
+}
+
+static void test_fallback(void) {
+	int64_t now = 2000 * MSEC;
+	// Backends without presentation feedback
+	assert(predict(now, 0, REFRESH_60HZ, 0, false) == now);
+	assert(predict(now, now - MSEC, 0, 0, false) == now);
+	assert(predict(now, 0, 0, 5, false) == now + 5 * MSEC);
+	// Presentation timestamps from the future
+	assert(predict(now, now + 100 * MSEC, REFRESH_60HZ, 0, false) == now);
+}
+
+static void test_max_render_time(void) {
+	int64_t samples[64];
+	// Steady 3.2 msec frames: rounded up plus 1 msec of slack
+	for (int i = 0; i < 64; i++) {
+		samples[i] = 3200000;
+	}
+	assert(frame_clock_max_render_time(samples, 64, 90, 0, REFRESH_60HZ) == 5);
+	assert(frame_clock_max_render_time(samples, 64, 90, 2, REFRESH_60HZ) == 7);
+
+	// The percentile ignores the occasional slow frame, unless asked not to
+	for (int i = 0; i < 64; i++) {
+		samples[i] = i % 16 == 0 ? 12 * MSEC : 2 * MSEC;
+	}
+	assert(frame_clock_max_render_time(samples, 64, 90, 0, REFRESH_60HZ) == 3);
+	assert(frame_clock_max_render_time(samples, 64, 99, 0, REFRESH_60HZ) == 13);
+
+	// Slower frames raise it until there is no time left to wait
+	for (int i = 0; i < 64; i++) {
+		samples[i] = 8 * MSEC + i * 100000;
+	}
+	assert(frame_clock_max_render_time(samples, 64, 50, 0, REFRESH_60HZ) == 13);
+	assert(frame_clock_max_render_time(samples, 64, 99, 4, REFRESH_60HZ) == 0);
+
+	// Without a refresh rate, rendering can't be delayed
+	assert(frame_clock_max_render_time(samples, 64, 50, 0, 0) == 0);
+	assert(frame_clock_max_render_time(samples, 0, 50, 0, REFRESH_60HZ) == 0);
+}
+
+int main(void) {
+	test_next_refresh();
+	test_steady();
+	test_fallback();
+	test_max_render_time();
+	return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Unit test for the process ancestry cache used to match new windows with
+ * their launcher context. Runs against a fake procfs tree.
+ */
+#include <assert.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "sway/desktop/pid_cache.h"
+
+static char proc_root[] = "/tmp/scroll-test-proc-XXXXXX";
+
+static void write_proc_file(pid_t pid, const char *name, const char *content) {
+	char path[PATH_MAX];
+	snprintf(path, sizeof(path), "%s/%d", proc_root, pid);
+	mkdir(path, 0700);
+	snprintf(path, sizeof(path), "%s/%d/%s", proc_root, pid, name);
+	FILE *f = fopen(path, "w");
+	assert(f);
+	fputs(content, f);
+	fclose(f);
+}
+
+static void write_stat(pid_t pid, const char *name, pid_t parent) {
+	char content[256];
+	snprintf(content, sizeof(content), "%d (%s) S %d %d 0 0 -1 4194304\n",
+		pid, name, parent, pid);
+	write_proc_file(pid, "stat", content);
+}
+
+static void remove_proc_files(pid_t pid) {
+	char path[PATH_MAX];
+	snprintf(path, sizeof(path), "%s/%d/stat", proc_root, pid);
+	unlink(path);
+	snprintf(path, sizeof(path), "%s/%d/cgroup", proc_root, pid);
+	unlink(path);
+	snprintf(path, sizeof(path), "%s/%d", proc_root, pid);
+	rmdir(path);
+}
+
+static void test_parse(struct pid_cache *cache) {
+	// terminal -> shell -> tmux -> app, with awkward executable names
+	write_stat(100, "term", 1);
+	write_stat(101, "my shell", 100);
+	write_stat(102, "tmux: server)", 101);
+	write_stat(103, ") (app", 102);
+	assert(pid_cache_get_parent(cache, 103) == 102);
+	assert(pid_cache_get_parent(cache, 102) == 101);
+	assert(pid_cache_get_parent(cache, 101) == 100);
+	assert(pid_cache_get_parent(cache, 100) == 1);
+
+	// Missing, orphaned, looping and broken processes have no parent
+	assert(pid_cache_get_parent(cache, 104) == -1);
+	assert(pid_cache_get_parent(cache, 0) == -1);
+	write_stat(105, "orphan", 0);
+	assert(pid_cache_get_parent(cache, 105) == -1);
+	write_stat(106, "loop", 106);
+	assert(pid_cache_get_parent(cache, 106) == -1);
+	write_proc_file(107, "stat", "107 (broken");
+	assert(pid_cache_get_parent(cache, 107) == -1);
+
+	// These pids don't exist outside of the fake tree, so they can't be
+	// watched and are never cached
+	struct pid_cache_stats stats;
+	pid_cache_get_stats(cache, &stats);
+	assert(stats.entries == 0);
+	assert(stats.hits == 0);
+
+	for (pid_t pid = 100; pid <= 107; pid++) {
+		remove_proc_files(pid);
+	}
+}
+
+static void test_memoize(struct pid_cache *cache) {
+	pid_t child = fork();
+	assert(child >= 0);
+	if (child == 0) {
+		pause();
+		_exit(0);
+	}
+
+	struct pid_cache_stats before, after;
+	pid_cache_get_stats(cache, &before);
+	write_stat(child, "child", 300);
+	assert(pid_cache_get_parent(cache, child) == 300);
+
+	// A live process keeps its parent without reading it again
+	write_stat(child, "child", 301);
+	assert(pid_cache_get_parent(cache, child) == 300);
+	pid_cache_get_stats(cache, &after);
+	if (after.entries == 0) {
+		// No pidfd support, nothing can be cached
+		assert(after.reads == before.reads + 2);
+		kill(child, SIGKILL);
+		waitpid(child, NULL, 0);
+		remove_proc_files(child);
+		return;
+	}
+	assert(after.entries == before.entries + 1);
+	assert(after.hits == before.hits + 1);
+	assert(after.reads == before.reads + 1);
+
+	// Once it exits the pid may be reused, so it's read again
+	kill(child, SIGKILL);
+	waitpid(child, NULL, 0);
+	assert(pid_cache_get_parent(cache, child) == 301);
+	pid_cache_get_stats(cache, &after);
+	assert(after.entries == before.entries);
+	assert(after.reads == before.reads + 2);
+
+	remove_proc_files(child);
+}
+
+static void test_cgroup(struct pid_cache *cache) {
+	char cgroup[256];
+	write_proc_file(200, "cgroup",
+		"12:cpu:/legacy\n0::/user.slice/app-flatpak-org.example.App-42.scope\n");
+	assert(pid_cache_get_cgroup(cache, 200, cgroup, sizeof(cgroup)));
+	assert(strcmp(cgroup, "/user.slice/app-flatpak-org.example.App-42.scope") == 0);
+	assert(!pid_cache_get_cgroup(cache, 200, cgroup, 8));
+
+	write_proc_file(201, "cgroup", "1:name=systemd:/\n");
+	assert(!pid_cache_get_cgroup(cache, 201, cgroup, sizeof(cgroup)));
+	assert(!pid_cache_get_cgroup(cache, 202, cgroup, sizeof(cgroup)));
+
+	remove_proc_files(200);
+	remove_proc_files(201);
+}
+
+int main(void) {
+	assert(mkdtemp(proc_root));
+	struct pid_cache *cache = pid_cache_create(proc_root);
+	assert(cache);
+
+	test_parse(cache);
+	test_memoize(cache);
+	test_cgroup(cache);
+
+	pid_cache_destroy(cache);
+	rmdir(proc_root);
+	return 0;
+}
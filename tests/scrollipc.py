@@ -10,7 +10,10 @@ HEADER_SIZE: int = struct.calcsize(HEADER_FORMAT)
 IPC_COMMAND: int = 0
 IPC_GET_WORKSPACES: int = 1
 IPC_SUBSCRIBE: int = 2
+IPC_GET_OUTPUTS: int = 3
 IPC_GET_VERSION: int = 7
+IPC_GET_CONFIG: int = 9
+IPC_GET_INPUTS: int = 100
 
 
 class ScrollIPC:
@@ -68,3 +71,30 @@ class ScrollIPC:
         if reply_type != 4:
             raise ValueError(f"Unexpected reply type: {reply_type}")
         return json.loads(reply_payload)
+
+    def get_outputs(self) -> list:
+        self._send(IPC_GET_OUTPUTS, "")
+        reply_type, reply_payload = self._recv()
+        if reply_type != IPC_GET_OUTPUTS:
+            raise ValueError(f"Unexpected reply type: {reply_type}")
+        result = json.loads(reply_payload)
+        assert isinstance(result, list)
+        return result
+
+    def get_config(self) -> dict:
+        self._send(IPC_GET_CONFIG, "")
+        reply_type, reply_payload = self._recv()
+        if reply_type != IPC_GET_CONFIG:
+            raise ValueError(f"Unexpected reply type: {reply_type}")
+        result = json.loads(reply_payload)
+        assert isinstance(result, dict)
+        return result
+
+    def get_inputs(self) -> list:
+        self._send(IPC_GET_INPUTS, "")
+        reply_type, reply_payload = self._recv()
+        if reply_type != IPC_GET_INPUTS:
+            raise ValueError(f"Unexpected reply type: {reply_type}")
+        result = json.loads(reply_payload)
+        assert isinstance(result, list)
+        return result
@@ -0,0 +1,38 @@
+import time
+from test_utils import ScrollCompositorFactory, wayland_client, wait_for_client_map
+
+
+def animation_clock_stats(inst) -> dict:
+    return inst.execute_lua("return scroll.animation_clock_stats()")
+
+
+def test_animation_frames_are_sampled(
+    scroll_compositor_factory: ScrollCompositorFactory,
+) -> None:
+    config = "workspace 1\nanimations enabled yes\nanimations workspace_switch yes 300\n"
+    with scroll_compositor_factory(config) as inst:
+        with wayland_client(inst, "Clock"):
+            view_id = wait_for_client_map(inst, "Clock")
+            con_id = inst.execute_lua(f"return scroll.view_get_container({view_id})")
+            inst.wait_for_idle()
+            scene = inst.execute_lua(
+                f"return scroll.container_get_animated_geometry({con_id})"
+            )
+
+            before = animation_clock_stats(inst)
+            inst.cmd("workspace 2")
+            time.sleep(0.1)
+            inst.cmd("workspace 1")
+            inst.wait_for_idle()
+            after = animation_clock_stats(inst)
+
+            # Every frame is sampled once, predicted or not
+            frames = (after["predicted"] - before["predicted"]) + (
+                after["fallback"] - before["fallback"]
+            )
+            assert frames > 0
+            # Sampling ahead of time still lands the animation where it ends
+            assert not inst.execute_lua("return scroll.animating()")
+            assert inst.execute_lua(
+                f"return scroll.container_get_animated_geometry({con_id})"
+            ) == scene
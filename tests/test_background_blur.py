@@ -0,0 +1,27 @@
+from conftest import ScrollInstance
+
+
+def get_blur(inst: ScrollInstance) -> dict:
+    for output in inst.get_outputs():
+        if output["name"] == "HEADLESS-1":
+            return output["blur"]
+    raise AssertionError("Output HEADLESS-1 not found")
+
+
+def test_background_blur_command(scroll_compositor: ScrollInstance) -> None:
+    inst = scroll_compositor
+    assert inst.cmd("background_blur 2")[0]["success"]
+    assert inst.cmd("background_blur disable")[0]["success"]
+    assert not inst.cmd("background_blur 0")[0]["success"]
+    assert not inst.cmd("background_blur 6")[0]["success"]
+    assert not inst.cmd("background_blur fast")[0]["success"]
+    assert inst.cmd("background_blur 1")[0]["success"]
+
+
+def test_background_blur_stats(scroll_compositor: ScrollInstance) -> None:
+    inst = scroll_compositor
+    inst.wait_for_idle()
+    # Nothing asks for blur, so the cache is never rendered
+    blur = get_blur(inst)
+    assert blur["refreshes"] == 0
+    assert blur["area"] == 0
@@ -0,0 +1,27 @@
+from conftest import ScrollInstance
+
+
+def cursor_stats(inst: ScrollInstance) -> dict:
+    return inst.execute_lua("return scroll.cursor_theme_stats()")
+
+
+def test_cursor_theme_shared(scroll_compositor: ScrollInstance) -> None:
+    inst = scroll_compositor
+    inst.wait_for_idle()
+    stats = cursor_stats(inst)
+    # The seat and Xwayland use the same theme and size
+    assert stats["managers"] == 1
+    assert stats["themes"] >= 1
+    assert stats["cursors"] >= 1
+    assert stats["bytes"] > 0
+
+
+def test_cursor_theme_change_releases(scroll_compositor: ScrollInstance) -> None:
+    inst = scroll_compositor
+    assert inst.cmd("seat * xcursor_theme default 32")[0]["success"]
+    inst.wait_for_idle()
+    assert cursor_stats(inst)["managers"] == 1
+
+    assert inst.cmd("seat * xcursor_theme default 24")[0]["success"]
+    inst.wait_for_idle()
+    assert cursor_stats(inst)["managers"] == 1
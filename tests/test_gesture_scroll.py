@@ -0,0 +1,110 @@
+import time
+from contextlib import ExitStack
+
+from conftest import ScrollInstance
+from test_utils import (
+    ScrollCompositorFactory,
+    wayland_client,
+    wait_for_client_map,
+)
+
+# A three finger swipe to the right recorded on a touchpad, as
+# (delay since the previous event in ms, dx, dy)
+SWIPE = [
+    (0, 1.2, 0.0), (7, 2.9, 0.1), (7, 5.1, 0.0), (8, 7.4, -0.2),
+    (7, 9.8, 0.0), (7, 12.3, 0.1), (7, 14.1, 0.0), (8, 15.6, 0.2),
+    (7, 16.9, 0.0), (7, 17.4, -0.1), (7, 18.0, 0.0), (8, 18.2, 0.0),
+    (7, 18.1, 0.1), (7, 17.8, 0.0), (7, 17.5, 0.0), (8, 17.0, -0.1),
+    (7, 16.6, 0.0), (7, 16.0, 0.0), (7, 15.7, 0.1), (8, 15.1, 0.0),
+    (7, 14.8, 0.0), (7, 14.0, 0.0), (7, 13.6, -0.1), (8, 13.1, 0.0),
+    (7, 12.4, 0.0), (7, 11.9, 0.1), (7, 11.2, 0.0), (8, 10.8, 0.0),
+    (7, 10.1, 0.0), (7, 9.5, 0.0), (7, 9.0, -0.1), (8, 8.6, 0.0),
+]
+
+
+def focused_title(inst: ScrollInstance) -> str:
+    return inst.execute_lua("return scroll.view_get_title(scroll.focused_view())")
+
+
+def replay_swipe(inst: ScrollInstance, fingers: int = 3) -> None:
+    assert inst.cmd(f"seat - cursor swipe begin {fingers}")[0]["success"]
+    for delay, dx, dy in SWIPE:
+        time.sleep(delay / 1000)
+        assert inst.cmd(f"seat - cursor swipe update {fingers} {dx} {dy}")[0]["success"]
+    assert inst.cmd("seat - cursor swipe end")[0]["success"]
+
+
+def test_swipe_does_not_commit_per_event(scroll_compositor: ScrollInstance) -> None:
+    inst = scroll_compositor
+    with ExitStack() as stack:
+        for i in range(4):
+            stack.enter_context(wayland_client(inst, f"Swipe {i}"))
+            wait_for_client_map(inst, f"Swipe {i}")
+        inst.wait_for_idle()
+        assert focused_title(inst) == "Swipe 3"
+
+        before = inst.execute_lua("return scroll.transactions_committed()")
+        replay_swipe(inst)
+        inst.wait_for_idle()
+        committed = inst.execute_lua("return scroll.transactions_committed()") - before
+
+        # The layout is only updated once the gesture (and its kinetic
+        # deceleration) is over
+        assert committed <= 3
+        assert focused_title(inst) != "Swipe 3"
+
+
+def test_swipe_without_kinetic(
+    scroll_compositor_factory: ScrollCompositorFactory,
+) -> None:
+    config = "workspace 1\nanimations enabled no\ngesture_scroll_kinetic disable\n"
+    with scroll_compositor_factory(config) as inst, ExitStack() as stack:
+        for i in range(3):
+            stack.enter_context(wayland_client(inst, f"Swipe {i}"))
+            wait_for_client_map(inst, f"Swipe {i}")
+        inst.wait_for_idle()
+
+        replay_swipe(inst)
+        assert not inst.execute_lua("return scroll.animating()")
+        inst.wait_for_idle()
+        assert focused_title(inst) != "Swipe 2"
+
+
+def test_swipe_release_animates_from_release_position(
+    scroll_compositor_factory: ScrollCompositorFactory,
+) -> None:
+    config = "workspace 1\nanimations enabled yes\ngesture_scroll_kinetic disable\n"
+    with scroll_compositor_factory(config) as inst, ExitStack() as stack:
+        for i in range(4):
+            stack.enter_context(wayland_client(inst, f"Swipe {i}"))
+            view_id = wait_for_client_map(inst, f"Swipe {i}")
+        con_id = inst.execute_lua(f"return scroll.view_get_container({view_id})")
+        inst.wait_for_idle()
+
+        def scene_x() -> float:
+            return inst.execute_lua(
+                f"return scroll.container_get_animated_geometry({con_id})"
+            )["x"]
+
+        start = scene_x()
+        assert inst.cmd("seat - cursor swipe begin 3")[0]["success"]
+        for delay, dx, dy in SWIPE:
+            time.sleep(delay / 1000)
+            assert inst.cmd(f"seat - cursor swipe update 3 {dx} {dy}")[0]["success"]
+        # Let a frame translate the scene to the last update
+        time.sleep(0.1)
+        release = scene_x()
+        assert release > start
+
+        assert inst.cmd("seat - cursor swipe end")[0]["success"]
+        samples = []
+        while inst.execute_lua("return scroll.animating()"):
+            samples.append(scene_x())
+            time.sleep(0.005)
+        inst.wait_for_idle()
+        end = scene_x()
+
+        # The snap starts where the fingers left the window, it must not go
+        # back to where the gesture began
+        low, high = min(release, end) - 1, max(release, end) + 1
+        assert all(low <= x <= high for x in samples), (start, release, end, samples)
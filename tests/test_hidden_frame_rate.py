@@ -0,0 +1,89 @@
+import threading
+import time
+
+from conftest import ScrollInstance
+from test_utils import (
+    DEFAULT_CONFIG,
+    find_node_by_title_contains,
+    wayland_client,
+    wait_for_client_map,
+)
+
+
+def is_suspended(inst: ScrollInstance, title: str) -> bool:
+    node = find_node_by_title_contains(inst.get_tree(), title)
+    assert node is not None
+    return node["suspended"]
+
+
+class FrameCounter:
+    """Counts the frame callbacks printed by a client started with
+    print_frames"""
+
+    def __init__(self, proc) -> None:
+        self.count = 0
+        self.thread = threading.Thread(target=self.read, args=(proc,), daemon=True)
+        self.thread.start()
+
+    def read(self, proc) -> None:
+        for line in proc.stdout:
+            if line.strip() == "frame":
+                self.count += 1
+
+    def frames_during(self, seconds: float) -> int:
+        start = self.count
+        time.sleep(seconds)
+        return self.count - start
+
+
+def test_hidden_view_suspended(scroll_compositor: ScrollInstance) -> None:
+    inst = scroll_compositor
+    with wayland_client(inst, "Hidden View"):
+        wait_for_client_map(inst, "Hidden View")
+        inst.wait_for_idle()
+        assert not is_suspended(inst, "Hidden View")
+
+        assert inst.cmd("workspace 2")[0]["success"]
+        inst.wait_for_idle()
+        assert is_suspended(inst, "Hidden View")
+
+        assert inst.cmd("workspace 1")[0]["success"]
+        inst.wait_for_idle()
+        assert not is_suspended(inst, "Hidden View")
+
+
+def test_hidden_frame_rate_command(scroll_compositor: ScrollInstance) -> None:
+    inst = scroll_compositor
+    assert inst.cmd("hidden_frame_rate pause")[0]["success"]
+    assert inst.cmd("hidden_frame_rate 5")[0]["success"]
+    assert not inst.cmd("hidden_frame_rate 0")[0]["success"]
+    assert not inst.cmd("hidden_frame_rate fast")[0]["success"]
+    assert inst.cmd("hidden_frame_rate 1")[0]["success"]
+
+
+def test_hidden_frame_callbacks(scroll_compositor: ScrollInstance) -> None:
+    inst = scroll_compositor
+    with wayland_client(inst, "Frame View", print_frames=True) as proc:
+        wait_for_client_map(inst, "Frame View")
+        frames = FrameCounter(proc)
+
+        # Visible, the client draws at the output refresh rate
+        assert frames.frames_during(0.5) > 5
+
+        # Hidden, at hidden_frame_rate
+        assert inst.cmd("workspace 2")[0]["success"]
+        inst.wait_for_idle()
+        time.sleep(0.2)
+        assert frames.frames_during(2.5) in range(1, 5)
+
+        assert inst.cmd("hidden_frame_rate pause")[0]["success"]
+        time.sleep(0.2)
+        assert frames.frames_during(1.5) == 0
+
+        # A reload restores the default rate and has to re-arm the timer
+        inst.reload_config(DEFAULT_CONFIG)
+        assert frames.frames_during(2.5) > 0
+
+        assert inst.cmd("workspace 1")[0]["success"]
+        inst.wait_for_idle()
+        assert frames.frames_during(0.5) > 5
@@ -0,0 +1,46 @@
+import time
+from conftest import ScrollInstance
+from test_utils import layer_client
+
+FRAMES = 60
+
+
+def commit_stats(inst: ScrollInstance) -> dict:
+    return inst.execute_lua("return scroll.layer_shell_commit_stats()")
+
+
+def wait_for_commits(inst: ScrollInstance, start: dict, count: int) -> dict:
+    deadline = time.monotonic() + 10
+    while time.monotonic() < deadline:
+        stats = commit_stats(inst)
+        if stats["commits"] - start["commits"] >= count:
+            return stats
+        time.sleep(0.05)
+    raise TimeoutError("Layer client did not commit")
+
+
+def test_content_commits_skip_arrange(scroll_compositor: ScrollInstance) -> None:
+    inst = scroll_compositor
+    start = commit_stats(inst)
+    with layer_client(inst, "panel", FRAMES, 30):
+        stats = wait_for_commits(inst, start, FRAMES)
+        # Only the initial commit and mapping arrange the layers, the
+        # redraws resend the same state
+        assert stats["arranged"] - start["arranged"] <= 3
+        assert stats["configured"] == start["configured"]
+
+
+def test_non_exclusive_resize_configures_surface(
+    scroll_compositor: ScrollInstance,
+) -> None:
+    inst = scroll_compositor
+    start = commit_stats(inst)
+    with layer_client(inst, "overlay", 10, 0, grow=True):
+        wait_for_commits(inst, start, 10)
+        deadline = time.monotonic() + 5
+        stats = commit_stats(inst)
+        while stats["configured"] == start["configured"]:
+            assert time.monotonic() < deadline, "Resize was not handled"
+            time.sleep(0.05)
+            stats = commit_stats(inst)
+        assert stats["arranged"] - start["arranged"] <= 3
@@ -1,4 +1,5 @@
 from conftest import ScrollInstance
+from test_utils import wayland_client, wait_for_client_map
 
 
 def test_lua_comprehensive_api(scroll_compositor: ScrollInstance) -> None:
@@ -91,3 +92,76 @@ def test_lua_comprehensive_api(scroll_compositor: ScrollInstance) -> None:
     assert len(invalid_output_ws) == 0
 
     assert scroll_compositor.proc.poll() is None
+
+
+def test_lua_benchmark_counters(scroll_compositor: ScrollInstance) -> None:
+    output: int = scroll_compositor.execute_lua("return scroll.root_get_outputs()[1]")
+
+    before: int = scroll_compositor.execute_lua("return scroll.transactions_committed()")
+    assert isinstance(before, int)
+    res = scroll_compositor.cmd("workspace 2")
+    assert res[0]["success"], res
+    scroll_compositor.wait_for_idle()
+    after: int = scroll_compositor.execute_lua("return scroll.transactions_committed()")
+    assert after > before
+
+    frame_times: list = scroll_compositor.execute_lua(
+        f"return scroll.output_get_frame_times({output})"
+    )
+    assert isinstance(frame_times, list)
+    assert len(frame_times) > 0
+    assert all(isinstance(t, int) and t >= 0 for t in frame_times)
+    assert len(frame_times) <= 1024
+
+    invalid: list = scroll_compositor.execute_lua(
+        "return scroll.output_get_frame_times(999998)"
+    )
+    assert invalid == []
+
+
+def test_lua_text_render_deferred(scroll_compositor: ScrollInstance) -> None:
+    inst = scroll_compositor
+    with wayland_client(inst, "Deferred Title"):
+        wait_for_client_map(inst, "Deferred Title")
+        assert inst.cmd("border normal")[0]["success"]
+        inst.wait_for_idle()
+
+        assert inst.cmd("workspace 2")[0]["success"]
+        inst.wait_for_idle()
+        before: dict = inst.execute_lua("return scroll.text_render_stats()")
+
+        # Title changes on a hidden workspace are not rasterized
+        for i in range(5):
+            res = inst.cmd(f'[title="Deferred Title"] title_format "{i} %title"')
+            assert res[0]["success"], res
+        inst.wait_for_idle()
+        hidden: dict = inst.execute_lua("return scroll.text_render_stats()")
+        assert hidden["rendered"] == before["rendered"]
+        assert hidden["deferred"] > before["deferred"]
+
+        # but they are once it is visible again
+        assert inst.cmd("workspace 1")[0]["success"]
+        inst.wait_for_idle()
+        shown: dict = inst.execute_lua("return scroll.text_render_stats()")
+        assert shown["rendered"] > hidden["rendered"]
+
+
+def test_lua_text_workspace_switch_keeps_raster(
+    scroll_compositor: ScrollInstance,
+) -> None:
+    inst = scroll_compositor
+    with wayland_client(inst, "Unchanged Title"):
+        wait_for_client_map(inst, "Unchanged Title")
+        assert inst.cmd("border normal")[0]["success"]
+        inst.wait_for_idle()
+        before: dict = inst.execute_lua("return scroll.text_render_stats()")
+
+        # Hiding and showing the title on the same output leaves its buffer
+        # valid, so it must not be rasterized again
+        for _ in range(3):
+            assert inst.cmd("workspace 2")[0]["success"]
+            inst.wait_for_idle()
+            assert inst.cmd("workspace 1")[0]["success"]
+            inst.wait_for_idle()
+        after: dict = inst.execute_lua("return scroll.text_render_stats()")
+        assert after["rendered"] == before["rendered"]
@@ -0,0 +1,39 @@
+from conftest import ScrollInstance
+
+
+def find_output(inst: ScrollInstance, name: str) -> dict:
+    for output in inst.get_outputs():
+        if output["name"] == name:
+            return output
+    raise AssertionError(f"Output {name} not found")
+
+
+def test_max_render_time_auto(scroll_compositor: ScrollInstance) -> None:
+    inst = scroll_compositor
+    res = inst.cmd("output HEADLESS-1 max_render_time auto 90")
+    assert res[0]["success"], res
+
+    output = find_output(inst, "HEADLESS-1")
+    assert output["max_render_time_auto"] is True
+    assert output["render_time"]["percentile"] == 90
+    # The headless backend doesn't report a refresh rate, so there is no
+    # refresh to render ahead of and no frame can be late. The computation
+    # from measured render times is covered by the frame-clock unit test.
+    assert output["max_render_time"] == 0
+    assert output["render_time"]["frames"] == 0
+    assert output["render_time"]["missed"] == 0
+
+    res = inst.cmd("output HEADLESS-1 max_render_time 5")
+    assert res[0]["success"], res
+    output = find_output(inst, "HEADLESS-1")
+    assert output["max_render_time_auto"] is False
+    assert "render_time" not in output
+    assert output["max_render_time"] == 5
+
+    res = inst.cmd("output HEADLESS-1 max_render_time off")
+    assert res[0]["success"], res
+
+
+def test_max_render_time_auto_invalid(scroll_compositor: ScrollInstance) -> None:
+    res = scroll_compositor.cmd("output HEADLESS-1 max_render_time auto 10")
+    assert not res[0]["success"]
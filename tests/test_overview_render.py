@@ -0,0 +1,62 @@
+from bench.compositor import get_output, render_frame, wait_for_frame
+from test_utils import wayland_client, wait_for_client_map, ScrollInstance
+
+
+def render_entries(inst: ScrollInstance) -> int:
+    return render_frame(inst)["last_frame"]["entries"]
+
+
+def test_overview_culls_covered_windows(scroll_compositor: ScrollInstance) -> None:
+    inst = scroll_compositor
+
+    with wayland_client(inst, "Overview Below"):
+        wait_for_client_map(inst, "Overview Below")
+        # Half-size content, well inside the window opened on top of it
+        assert inst.cmd("floating enable")[0]["success"]
+        assert inst.cmd("scale_content exact 0.5")[0]["success"]
+        assert inst.cmd("move position 120 120")[0]["success"]
+
+        with wayland_client(inst, "Overview Above"):
+            wait_for_client_map(inst, "Overview Above")
+            assert inst.cmd("floating enable")[0]["success"]
+            assert inst.cmd("move position 100 100")[0]["success"]
+
+            res = inst.cmd("scale_workspaces enable")
+            assert res[0]["success"], res
+            covered = render_entries(inst)
+
+            res = inst.cmd('[title="Overview Above"] move position 600 400')
+            assert res[0]["success"], res
+            separate = render_entries(inst)
+
+            # The buffer of the covered window is dropped from the render list
+            assert covered < separate
+
+            res = inst.cmd("scale_workspaces disable")
+            assert res[0]["success"], res
+
+
+def test_overview_partial_damage(scroll_compositor: ScrollInstance) -> None:
+    inst = scroll_compositor
+
+    with wayland_client(inst, "Overview Damage"):
+        wait_for_client_map(inst, "Overview Damage")
+        assert inst.cmd("floating enable")[0]["success"]
+        assert inst.cmd("move position 100 100")[0]["success"]
+
+        res = inst.cmd("scale_workspaces enable")
+        assert res[0]["success"], res
+        inst.wait_for_idle()
+        output = get_output(inst)
+        frames = output["scanout"]["frames"]
+        full_area = output["rect"]["width"] * output["rect"]["height"]
+
+        # Moving a small window only damages where it was and where it is
+        res = inst.cmd("move position 300 300")
+        assert res[0]["success"], res
+        inst.wait_for_idle()
+        output = wait_for_frame(inst, frames)
+        assert 0 < output["last_frame"]["damage_area"] < full_area / 4
+
+        res = inst.cmd("scale_workspaces disable")
+        assert res[0]["success"], res
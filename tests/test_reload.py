@@ -0,0 +1,88 @@
+import os
+from pathlib import Path
+
+from test_utils import DEFAULT_CONFIG, ScrollCompositorFactory, virtual_keyboard
+
+KEYMAP = """xkb_keymap {{
+    xkb_keycodes {{ include "evdev+aliases(qwerty)" }};
+    xkb_types {{ include "complete" }};
+    xkb_compat {{ include "complete" }};
+    xkb_symbols {{ include "pc+{layout}+inet(evdev)" }};
+}};
+"""
+
+
+def write_keymap(path: Path, layout: str, mtime: int) -> None:
+    path.write_text(KEYMAP.format(layout=layout))
+    os.utime(path, (mtime, mtime))
+
+
+def test_reload_reports_phases(
+    scroll_compositor_factory: ScrollCompositorFactory,
+) -> None:
+    with scroll_compositor_factory() as scroll_compositor:
+        count = scroll_compositor.get_config().get("reload", {}).get("count", 0)
+
+        scroll_compositor.reload_config(DEFAULT_CONFIG)
+        stats = scroll_compositor.get_config()["reload"]
+        assert stats["count"] == count + 1
+        for phase in ("validate", "parse", "inputs", "seats", "outputs", "bars"):
+            assert stats[phase] >= 0
+        assert stats["total"] >= stats["validate"] + stats["parse"]
+
+
+def test_reload_unchanged_config(
+    scroll_compositor_factory: ScrollCompositorFactory,
+) -> None:
+    with scroll_compositor_factory() as scroll_compositor:
+        with virtual_keyboard(scroll_compositor):
+            config = DEFAULT_CONFIG + "input type:keyboard repeat_rate 30\n"
+            scroll_compositor.reload_config(config)
+            stats = scroll_compositor.get_config()["reload"]
+            assert stats["inputs_reset"] == 1
+
+            scroll_compositor.reload_config(config)
+            stats = scroll_compositor.get_config()["reload"]
+            assert stats["inputs_reset"] == 0
+            assert stats["seats_applied"] == 0
+            assert not stats["modeset"]
+
+
+def test_reload_edited_xkb_file(
+    scroll_compositor_factory: ScrollCompositorFactory,
+) -> None:
+    with scroll_compositor_factory() as scroll_compositor:
+        keymap = scroll_compositor.temp_dir / "keymap.xkb"
+        write_keymap(keymap, "us", 1000000000)
+        config = DEFAULT_CONFIG + f"input type:keyboard xkb_file {keymap}\n"
+
+        with virtual_keyboard(scroll_compositor):
+            scroll_compositor.reload_config(config)
+            scroll_compositor.reload_config(config)
+            stats = scroll_compositor.get_config()["reload"]
+            assert stats["inputs_reset"] == 0
+
+            # Same path, new content: the keyboard has to be reconfigured
+            write_keymap(keymap, "de", 1000000060)
+            scroll_compositor.reload_config(config)
+            stats = scroll_compositor.get_config()["reload"]
+            assert stats["inputs_reset"] == 1
+
+
+def test_reload_changed_sections(
+    scroll_compositor_factory: ScrollCompositorFactory,
+) -> None:
+    with scroll_compositor_factory() as scroll_compositor:
+        scroll_compositor.reload_config(
+            DEFAULT_CONFIG + "seat * hide_cursor 1000\n"
+        )
+        stats = scroll_compositor.get_config()["reload"]
+        assert stats["seats_applied"] > 0
+        assert not stats["modeset"]
+
+        scroll_compositor.reload_config(
+            DEFAULT_CONFIG + "seat * hide_cursor 1000\noutput * scale 2\n"
+        )
+        stats = scroll_compositor.get_config()["reload"]
+        assert stats["seats_applied"] == 0
+        assert stats["modeset"]
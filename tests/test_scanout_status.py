@@ -0,0 +1,46 @@
+from bench.compositor import render_frame
+from test_utils import wayland_client, wait_for_client_map, ScrollInstance
+
+
+def test_scanout_status(scroll_compositor: ScrollInstance) -> None:
+    inst = scroll_compositor
+    output = render_frame(inst)
+    assert output["scanout"]["status"] == "empty"
+    assert output["last_frame"]["entries"] == 0
+
+    with wayland_client(inst, "Scanout Window"):
+        wait_for_client_map(inst, "Scanout Window")
+
+        # A tiled window with borders can never be scanned out directly
+        output = render_frame(inst)
+        assert output["scanout"]["status"] == "decoration"
+        assert output["scanout"]["scanout_frames"] < output["scanout"]["frames"]
+
+
+def test_fullscreen_fast_path(scroll_compositor: ScrollInstance) -> None:
+    inst = scroll_compositor
+
+    with wayland_client(inst, "Fullscreen Window"):
+        wait_for_client_map(inst, "Fullscreen Window")
+        res = inst.cmd("opacity 0.5")
+        assert res[0]["success"], res
+        res = inst.cmd("fullscreen enable layout")
+        assert res[0]["success"], res
+
+        # Without decorations the client buffer is all that is drawn, but it
+        # has to be blended
+        output = render_frame(inst)
+        assert output["last_frame"]["entries"] == 1
+        assert output["scanout"]["status"] == "translucent"
+
+        res = inst.cmd("fullscreen_fast_path enable")
+        assert res[0]["success"], res
+        output = render_frame(inst)
+        assert output["last_frame"]["entries"] == 1
+        assert output["scanout"]["status"] not in (
+            "translucent", "multiple_entries", "decoration", "empty")
+
+        res = inst.cmd("fullscreen_fast_path disable")
+        assert res[0]["success"], res
+        output = render_frame(inst)
+        assert output["scanout"]["status"] == "translucent"
@@ -0,0 +1,74 @@
+from typing import Any, Dict, Optional
+
+from conftest import ScrollInstance
+from test_utils import find_node_by_title_contains, wayland_client, wait_for_client_map
+
+
+def is_trailmarked(inst: ScrollInstance, title: str) -> bool:
+    node = find_node_by_title_contains(inst.get_tree(), title)
+    assert node is not None
+    return node["trailmark"]
+
+
+def workspace_of(node: Dict[str, Any], title: str, ws: Optional[str] = None) -> Optional[str]:
+    if node.get("type") == "workspace":
+        ws = node["name"]
+    name = node.get("name")
+    if node.get("type") == "con" and name and title in name:
+        return ws
+    for child in node.get("nodes", []) + node.get("floating_nodes", []):
+        res = workspace_of(child, title, ws)
+        if res:
+            return res
+    return None
+
+
+def test_trailmark_membership(scroll_compositor: ScrollInstance) -> None:
+    inst = scroll_compositor
+    with wayland_client(inst, "Trail Window"):
+        wait_for_client_map(inst, "Trail Window")
+        assert inst.cmd("trailmark toggle")[0]["success"]
+        assert is_trailmarked(inst, "Trail Window")
+
+        # Membership follows the active trail
+        assert inst.cmd("trail new")[0]["success"]
+        assert not is_trailmarked(inst, "Trail Window")
+        assert inst.cmd("trailmark toggle")[0]["success"]
+        assert inst.cmd("trail prev")[0]["success"]
+        assert is_trailmarked(inst, "Trail Window")
+
+        assert inst.cmd("trail clear")[0]["success"]
+        assert not is_trailmarked(inst, "Trail Window")
+        assert inst.cmd("trail next")[0]["success"]
+        assert is_trailmarked(inst, "Trail Window")
+        assert inst.cmd("trail delete")[0]["success"]
+        assert not is_trailmarked(inst, "Trail Window")
+
+        assert inst.cmd("trailmark toggle")[0]["success"]
+        assert is_trailmarked(inst, "Trail Window")
+        assert inst.cmd("trailmark toggle")[0]["success"]
+        assert not is_trailmarked(inst, "Trail Window")
+        assert inst.cmd("trailmark toggle")[0]["success"]
+
+    # Unmapping drops the marks, and trailmark next has nothing to focus
+    inst.wait_for_idle()
+    assert inst.cmd("trailmark next")[0]["success"]
+    with wayland_client(inst, "Next Window"):
+        wait_for_client_map(inst, "Next Window")
+        assert not is_trailmarked(inst, "Next Window")
+
+
+def test_space_restore_hide_membership(scroll_compositor: ScrollInstance) -> None:
+    inst = scroll_compositor
+    assert inst.cmd("workspace 7")[0]["success"]
+    with wayland_client(inst, "Space Kept"):
+        wait_for_client_map(inst, "Space Kept")
+        assert inst.cmd("space save membership")[0]["success"]
+        with wayland_client(inst, "Space Hidden"):
+            wait_for_client_map(inst, "Space Hidden")
+            assert inst.cmd("space restore_hide membership")[0]["success"]
+            inst.wait_for_idle()
+            tree = inst.get_tree()
+            assert workspace_of(tree, "Space Kept") == "7"
+            assert workspace_of(tree, "Space Hidden") == "__i3_scratch"
+    assert inst.cmd("space delete membership")[0]["success"]
@@ -0,0 +1,50 @@
+from contextlib import ExitStack
+from pathlib import Path
+
+from conftest import ScrollInstance
+from test_utils import run_compositor, wayland_client, wait_for_client_map
+
+# Layout changes made by one script, handled as a single event
+SCRIPT = """
+    scroll.command(nil, "focus left")
+    scroll.command(nil, "focus left")
+    scroll.command(nil, "set_size h 0.5")
+    scroll.command(nil, "set_size h 0.75")
+"""
+
+
+def transaction_stats(inst: ScrollInstance) -> dict:
+    return inst.execute_lua("return scroll.transaction_stats()")
+
+
+def run_script(inst: ScrollInstance) -> dict:
+    with ExitStack() as stack:
+        for i in range(3):
+            stack.enter_context(wayland_client(inst, f"Coalesce {i}"))
+            wait_for_client_map(inst, f"Coalesce {i}")
+        inst.wait_for_idle()
+
+        before = transaction_stats(inst)
+        inst.execute_lua(SCRIPT)
+        inst.wait_for_idle()
+        after = transaction_stats(inst)
+    return {key: after[key] - before[key] for key in after}
+
+
+def test_lua_commands_coalesce(
+    scroll_compositor: ScrollInstance, scroll_compositor_binary: str, tmp_path: Path
+) -> None:
+    coalesced = run_script(scroll_compositor)
+    with run_compositor(
+        scroll_compositor_binary, tmp_path, debug_flags=["txn-nocoalesce"]
+    ) as inst:
+        separate = run_script(inst)
+
+    # The resizes animate differently from the focus changes, so each pair
+    # is coalesced on its own
+    assert coalesced["coalesced"] >= 2
+    assert separate["coalesced"] == 0
+    # The layout changes of the script go in one transaction, and the
+    # window resized twice is only configured for its final size
+    assert coalesced["committed"] < separate["committed"]
+    assert coalesced["configures"] < separate["configures"]
@@ -107,6 +107,15 @@ class ScrollInstance:
     def get_tree(self) -> dict:
         return self.ipc.get_tree()
 
+    def get_outputs(self) -> list:
+        return self.ipc.get_outputs()
+
+    def get_config(self) -> dict:
+        return self.ipc.get_config()
+
+    def get_inputs(self) -> list:
+        return self.ipc.get_inputs()
+
     def read_log(self) -> str:
         return self.log_path.read_text()
 
@@ -317,7 +326,11 @@ class ScrollCompositorContextManager:
 
 @contextmanager
 def run_compositor(
-    binary_path: str, temp_dir: Path, config_content: str | None = None
+    binary_path: str,
+    temp_dir: Path,
+    config_content: str | None = None,
+    debug: bool = True,
+    debug_flags: list[str] | None = None,
 ) -> Generator[ScrollInstance, None, None]:
     log_path: Path = temp_dir / "scroll.log"
     log_file = open(log_path, "w")
@@ -344,8 +357,13 @@ def run_compositor(
     if "WAYLAND_DISPLAY" in env:
         del env["WAYLAND_DISPLAY"]
 
+    args = [binary_path, "-c", str(config_path)]
+    if debug:
+        args.append("-d")
+    for flag in debug_flags or []:
+        args.extend(["-D", flag])
     proc = subprocess.Popen(
-        [binary_path, "-c", str(config_path), "-d"],
+        args,
         env=env,
         stdout=log_file,
         stderr=subprocess.STDOUT,
@@ -391,6 +409,7 @@ def run_compositor(
 def wayland_client(
     compositor: ScrollInstance,
     title: str,
+    print_frames: bool = False,
 ) -> Generator[subprocess.Popen, None, None]:
     wayland_display: str | None = compositor.getenv("WAYLAND_DISPLAY")
     assert wayland_display is not None
@@ -398,8 +417,12 @@ def wayland_client(
     assert client_path.exists(), f"Client not found at {client_path}"
     env: dict = os.environ.copy()
     env["WAYLAND_DISPLAY"] = wayland_display
+    args: list = [str(client_path), title, "test_app"]
+    if print_frames:
+        # The client prints a line on stdout for each frame callback
+        args.append("frames")
     proc: subprocess.Popen = subprocess.Popen(
-        [str(client_path), title, "test_app"], env=env
+        args, env=env, stdout=subprocess.PIPE if print_frames else None, text=True
     )
     try:
         yield proc
@@ -412,6 +435,64 @@ def wayland_client(
                 proc.kill()
 
 
+@contextmanager
+def layer_client(
+    compositor: ScrollInstance,
+    namespace: str,
+    frames: int,
+    exclusive_zone: int,
+    grow: bool = False,
+) -> Generator[subprocess.Popen, None, None]:
+    wayland_display: str | None = compositor.getenv("WAYLAND_DISPLAY")
+    assert wayland_display is not None
+    client_path: Path = Path("./build/tests/wayland-layer-client").resolve()
+    assert client_path.exists(), f"Client not found at {client_path}"
+    env: dict = os.environ.copy()
+    env["WAYLAND_DISPLAY"] = wayland_display
+    args = [str(client_path), namespace, str(frames), str(exclusive_zone)]
+    if grow:
+        args.append("grow")
+    proc: subprocess.Popen = subprocess.Popen(args, env=env)
+    try:
+        yield proc
+    finally:
+        if proc.poll() is None:
+            proc.terminate()
+            try:
+                proc.wait(timeout=2)
+            except subprocess.TimeoutExpired:
+                proc.kill()
+
+
+@contextmanager
+def virtual_keyboard(
+    compositor: ScrollInstance,
+) -> Generator[subprocess.Popen, None, None]:
+    wayland_display: str | None = compositor.getenv("WAYLAND_DISPLAY")
+    assert wayland_display is not None
+    client_path: Path = Path("./build/tests/wayland-keyboard-client").resolve()
+    assert client_path.exists(), f"Client not found at {client_path}"
+    env: dict = os.environ.copy()
+    env["WAYLAND_DISPLAY"] = wayland_display
+    proc: subprocess.Popen = subprocess.Popen([str(client_path)], env=env)
+    try:
+        for _ in range(50):
+            inputs = compositor.get_inputs()
+            if any(i.get("type") == "keyboard" for i in inputs):
+                break
+            time.sleep(0.05)
+        else:
+            raise RuntimeError("Virtual keyboard was not added")
+        yield proc
+    finally:
+        if proc.poll() is None:
+            proc.terminate()
+            try:
+                proc.wait(timeout=2)
+            except subprocess.TimeoutExpired:
+                proc.kill()
+
+
 def wait_for_client_map(compositor: ScrollInstance, title: str) -> int:
     tries: int = 0
     while tries < 50:
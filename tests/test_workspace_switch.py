@@ -0,0 +1,42 @@
+import time
+from test_utils import ScrollCompositorFactory, wayland_client, wait_for_client_map
+
+
+def test_workspace_switch_moves_scene_only(
+    scroll_compositor_factory: ScrollCompositorFactory,
+) -> None:
+    config = (
+        "workspace 1\nanimations enabled yes\nanimations workspace_switch yes 1000\n"
+    )
+    with scroll_compositor_factory(config) as inst:
+        with wayland_client(inst, "Switch"):
+            view_id = wait_for_client_map(inst, "Switch")
+            con_id = inst.execute_lua(f"return scroll.view_get_container({view_id})")
+            inst.wait_for_idle()
+            geom = inst.execute_lua(f"return scroll.container_get_geometry({con_id})")
+            scene = inst.execute_lua(
+                f"return scroll.container_get_animated_geometry({con_id})"
+            )
+
+            inst.cmd("workspace 2")
+            time.sleep(0.3)
+            assert inst.execute_lua("return scroll.animating()")
+            # The workspace slides out as a whole, the layout stays as it was
+            moving = inst.execute_lua(
+                f"return scroll.container_get_animated_geometry({con_id})"
+            )
+            assert moving["y"] < scene["y"]
+            assert moving["x"] == scene["x"]
+            assert inst.execute_lua(
+                f"return scroll.container_get_geometry({con_id})"
+            ) == geom
+            inst.wait_for_idle()
+
+            inst.cmd("workspace 1")
+            inst.wait_for_idle()
+            assert inst.execute_lua(
+                f"return scroll.container_get_geometry({con_id})"
+            ) == geom
+            assert inst.execute_lua(
+                f"return scroll.container_get_animated_geometry({con_id})"
+            ) == scene